@@ -2,9 +2,16 @@
 #define AVLTREE_CPP
 
 #include <cassert>
+#include <future>
 #include <algorithm>
 #include "AVLTree.h"
 
+template <class T, class Node>
+constexpr size_t AVLTree<T, Node>::batch_grain;
+
+template <class T, class Node>
+constexpr size_t AVLTree<T, Node>::batch_leaf;
+
 template <class T, class Node>
 size_t AVLTree<T, Node>::getHeight() const noexcept {
     // Zero if tree is empty
@@ -96,6 +103,8 @@ void AVLTree<T, Node>::leftRotation(Node *&node) {
     // Assert node is not null, and right is not null
     assert(node != nullptr);
 
+    // node already belongs to this tree, the nodes rotated with it must too
+    own(node->right);
     auto * const temp = node->right;
 
     assert(temp != nullptr);
@@ -174,6 +183,8 @@ void AVLTree<T, Node>::leftRotation(Node *&node) {
             node->_height = node->right->getHeight() + 1;*/
     } else {
         // Case 2
+        own(temp->left);
+
         // node->right needs to become node->right->left->left
         // node->right safe in temp
         node->right = temp->left->left;
@@ -210,6 +221,8 @@ void AVLTree<T, Node>::rightRotation(Node *&node) {
     // Assert node is not null, and left is not null
     assert(node != nullptr);
 
+    own(node->left);
+
     // The temp pointer is constant, but the
     // value of the pointer may be modified.
     auto * const temp = node->left;
@@ -277,6 +290,8 @@ void AVLTree<T, Node>::rightRotation(Node *&node) {
         node = temp;
     } else {
         // Case 2
+        own(temp->right);
+
         // node->left needs to become node->left->right->right
         // node->left safe in temp
         node->left = temp->right->right;
@@ -361,6 +376,9 @@ bool AVLTree<T, Node>::insertInternal(Node *&node, const T &value) {
         return false;
     }
 
+    // Copy-on-write, node changes from here on
+    own(node);
+
     // else
     uint8_t child_height;
     if (cmp < 0) {
@@ -400,6 +418,8 @@ bool AVLTree<T, Node>::insertInternal(Node *&node, const T &value) {
 
 template <class T, class Node>
 Node* AVLTree<T, Node>::popMostLeftInternal(Node *&node) {
+    own(node);
+
     Node *temp;
     if (node->left != nullptr) {
         temp = popMostLeftInternal(node->left);
@@ -416,6 +436,8 @@ Node* AVLTree<T, Node>::popMostLeftInternal(Node *&node) {
 
 template <class T, class Node>
 Node* AVLTree<T, Node>::popMostRightInternal(Node *&node) {
+    own(node);
+
     Node *temp;
     if (node->right != nullptr) {
         temp = popMostRightInternal(node->right);
@@ -435,6 +457,8 @@ bool AVLTree<T, Node>::removeInternal(Node *&node, const T &value) {
     // If the stack has a nullptr on top, then failed to find node.
     if (node == nullptr) return false;
 
+    own(node);
+
     // Choose which way to keep searching.
     auto cmp = compare(value, node->value);
 
@@ -461,7 +485,7 @@ bool AVLTree<T, Node>::removeInternal(Node *&node, const T &value) {
             temp->height = node->height;
 
             // Remove the value node
-            delete node;
+            this->destroyNode(node);
             node = temp;
             updateHeight(node);
             rebalance(node);
@@ -473,13 +497,14 @@ bool AVLTree<T, Node>::removeInternal(Node *&node, const T &value) {
             assert(node->height == 2);
             assert(temp->height == 1);
 
-            delete node;
+            this->destroyNode(node);
             node = temp;
+            own(node);
             updateHeight(node);
             rebalance(node);
         } else {
             // Neither left nor right, just delete the node with value.
-            delete node;
+            this->destroyNode(node);
             node = nullptr;
         }
         return true;
@@ -498,4 +523,220 @@ bool AVLTree<T, Node>::removeInternal(Node *&node, const T &value) {
     rebalance(node);
     return true;
 }
+
+template <class T, class Node>
+uint8_t AVLTree<T, Node>::getHeight(const Node *node) noexcept {
+    return node == nullptr ? 0 : node->height;
+}
+
+template <class T, class Node>
+Node* AVLTree<T, Node>::join(Node *left, Node *middle, Node *right) {
+    const int left_height = getHeight(left), right_height = getHeight(right);
+
+    // Walk down the spine of the taller tree to a subtree about as tall as the other, join there, and rebalance on
+    // the way back up. The join grows that subtree by at most one, so one rotation a level is enough.
+    if (left_height > right_height + 1) {
+        own(left);
+        left->right = join(left->right, middle, right);
+        updateHeight(left);
+        rebalance(left);
+        return left;
+    }
+    if (right_height > left_height + 1) {
+        own(right);
+        right->left = join(left, middle, right->left);
+        updateHeight(right);
+        rebalance(right);
+        return right;
+    }
+
+    // Close enough in height to hang from middle
+    middle->left = left;
+    middle->right = right;
+    updateHeight(middle);
+    return middle;
+}
+
+template <class T, class Node>
+Node* AVLTree<T, Node>::join(Node *left, Node *right) {
+    if (left == nullptr) return right;
+
+    Node *middle = popMostRightInternal(left);
+    return join(left, middle, right);
+}
+
+template <class T, class Node>
+void AVLTree<T, Node>::split(Node *node, const T &value, Node *&left, Node *&middle, Node *&right) {
+    if (node == nullptr) {
+        left = middle = right = nullptr;
+        return;
+    }
+
+    // Copy-on-write, node is taken apart
+    own(node);
+
+    auto cmp = compare(value, node->value);
+    if (cmp == 0) {
+        left = node->left;
+        right = node->right;
+        node->left = node->right = nullptr;
+        node->height = 1;
+        middle = node;
+    } else if (cmp < 0) {
+        // node and its right subtree are all greater
+        split(node->left, value, left, middle, right);
+        right = join(right, node, node->right);
+    } else {
+        // node and its left subtree are all less
+        split(node->right, value, left, middle, right);
+        left = join(node->left, node, left);
+    }
+}
+
+template <class T, class Node>
+std::vector<bool> AVLTree<T, Node>::applyBatch(const BatchOperation *operations, size_t length, unsigned threads) {
+    if (threads == 0) threads = 1;
+
+    Batch batch;
+    batch.operations = operations;
+    batch.order.resize(length);
+    for (size_t i = 0; i < length; i++) batch.order[i] = i;
+    sortBatch(batch, 0, length, threads);
+
+    // Gather the operations on each value into runs, and count the runs that write
+    batch.writes.push_back(0);
+    for (size_t i = 0; i < length; i++) {
+        const BatchOperation &operation = operations[batch.order[i]];
+        if (i == 0 || compare(operations[batch.order[i - 1]].value, operation.value) != 0) {
+            batch.runs.push_back(i);
+            batch.writes.push_back(batch.writes.back());
+        }
+        if (operation.operation != contains_operation && batch.writes.back() == batch.writes[batch.writes.size() - 2])
+            batch.writes.back()++;
+    }
+    batch.runs.push_back(length);
+    batch.results.resize(length);
+
+    ptrdiff_t change = 0;
+    root = applyBatchInternal(root, batch, 0, batch.runs.size() - 1, threads, change);
+    this->count += change;
+
+    return std::vector<bool>(batch.results.begin(), batch.results.end());
+}
+
+template <class T, class Node>
+void AVLTree<T, Node>::sortBatch(Batch &batch, size_t begin, size_t end, unsigned threads) {
+    const BatchOperation *operations = batch.operations;
+    auto less = [this, operations](size_t a, size_t b) {
+        return compare(operations[a].value, operations[b].value) < 0;
+    };
+
+    // A stable merge sort, so operations on the same value stay in order, with halves sorted in parallel
+    if (threads <= 1 || end - begin < 2 * batch_grain) {
+        std::stable_sort(batch.order.begin() + begin, batch.order.begin() + end, less);
+        return;
+    }
+
+    const size_t middle = begin + (end - begin) / 2;
+    auto lower = std::async(std::launch::async, [&]() { sortBatch(batch, begin, middle, threads / 2); });
+    sortBatch(batch, middle, end, threads - threads / 2);
+    lower.get();
+    std::inplace_merge(batch.order.begin() + begin, batch.order.begin() + middle, batch.order.begin() + end, less);
+}
+
+template <class T, class Node>
+bool AVLTree<T, Node>::applyRun(Batch &batch, size_t run, bool present, const T *&inserted) {
+    inserted = nullptr;
+    for (size_t i = batch.runs[run]; i < batch.runs[run + 1]; i++) {
+        const BatchOperation &operation = batch.operations[batch.order[i]];
+        switch (operation.operation) {
+            case contains_operation:
+                batch.results[batch.order[i]] = present;
+                break;
+            case insert_operation:
+                batch.results[batch.order[i]] = !present;
+                if (!present) inserted = &operation.value;
+                present = true;
+                break;
+            case remove_operation:
+                batch.results[batch.order[i]] = present;
+                present = false;
+                break;
+        }
+    }
+    return present;
+}
+
+template <class T, class Node>
+Node* AVLTree<T, Node>::applyBatchInternal(Node *node, Batch &batch, size_t begin, size_t end, unsigned threads,
+                                           ptrdiff_t &change) {
+    if (begin == end) return node;
+
+    const bool parallel = threads > 1 && batch.runs[end] - batch.runs[begin] >= batch_grain;
+    const size_t middle = begin + (end - begin) / 2;
+    const T *inserted;
+
+    if (batch.writes[end] == batch.writes[begin]) {
+        // Nothing to write, so no need to take the tree apart, and both halves can read it at once
+        if (parallel) {
+            auto lower = std::async(std::launch::async, [&]() {
+                ptrdiff_t unchanged = 0;
+                applyBatchInternal(node, batch, begin, middle, threads / 2, unchanged);
+            });
+            applyBatchInternal(node, batch, middle, end, threads - threads / 2, change);
+            lower.get();
+        } else {
+            for (size_t run = begin; run < end; run++)
+                applyRun(batch, run, node != nullptr && containsInternal(node, batch.value(run)) != nullptr, inserted);
+        }
+        return node;
+    }
+
+    if (end - begin <= batch_leaf) {
+        // A split and join costs more than a few walks down the tree
+        for (size_t run = begin; run < end; run++) {
+            const T &value = batch.value(run);
+            const bool present = node != nullptr && containsInternal(node, value) != nullptr;
+            const bool after = applyRun(batch, run, present, inserted);
+            if (after && !present) {
+                insertInternal(node, *inserted);
+                change++;
+            } else if (!after && present) {
+                removeInternal(node, value);
+                change--;
+            }
+        }
+        return node;
+    }
+
+    Node *left, *found, *right;
+    split(node, batch.value(middle), left, found, right);
+
+    if (applyRun(batch, middle, found != nullptr, inserted)) {
+        if (found == nullptr) {
+            found = new Node(*inserted);
+            change++;
+        }
+    } else if (found != nullptr) {
+        this->destroyNode(found);
+        found = nullptr;
+        change--;
+    }
+
+    // left and right share no nodes, so each half of the batch has its own
+    if (parallel) {
+        ptrdiff_t lower_change = 0;
+        auto lower = std::async(std::launch::async, [&]() {
+            return applyBatchInternal(left, batch, begin, middle, threads / 2, lower_change);
+        });
+        right = applyBatchInternal(right, batch, middle + 1, end, threads - threads / 2, change);
+        left = lower.get();
+        change += lower_change;
+    } else {
+        left = applyBatchInternal(left, batch, begin, middle, 1, change);
+        right = applyBatchInternal(right, batch, middle + 1, end, 1, change);
+    }
+
+    return found != nullptr ? join(left, found, right) : join(left, right);
+}
 #endif
@@ -1,10 +1,20 @@
 /*
  * Implementation of the AVLTree that is with ignores duplicate entries
+ *
+ * applyBatch() applies many operations at once. The batch is sorted by value, the tree is split at the middle value
+ * of the batch, and each half of the batch is applied to its half of the tree, in parallel while the halves are big
+ * enough. The halves are joined back together around the middle value. Split and join are O(log n), for
+ * O(m log(n / m + 1)) work over a batch of m operations, and the nodes are only ever touched by one thread.
+ *
+ * Based on "Just Join for Parallel Ordered Sets" by Blelloch, Ferizovic and Sun.
  */
 #ifndef AVLTREE_H
 #define AVLTREE_H
 
+#include <thread>
+#include <vector>
 #include <cstdint>
+#include <cstddef>
 #include "../binaryTree.h"
 
 #ifdef BINARYTREE_SANITY_CHECK
@@ -31,6 +41,25 @@ struct AVLTreeNode {
     T value;
 };
 
+// Node for a copy-on-write AVLTree, AVLTree<T, SharedAVLTreeNode<T>>, whose copies share nodes.
+// See util/shared_node.h
+template <class T>
+struct SharedAVLTreeNode: public SharedNode {
+    // Public reference to T for reference
+    using value_type = T;
+
+    explicit SharedAVLTreeNode(const T &value): left(nullptr), right(nullptr), height(1), value(value) {}
+
+    // Copy constructor
+    SharedAVLTreeNode(const SharedAVLTreeNode &tree) = default;
+
+    SharedAVLTreeNode *left;
+    SharedAVLTreeNode *right;
+    uint8_t height;
+
+    T value;
+};
+
 template <class T, class Node = AVLTreeNode<T>>
 class AVLTree: virtual public BinaryTree<T, Node> {
   public:
@@ -39,6 +68,7 @@ class AVLTree: virtual public BinaryTree<T, Node> {
   protected:
     using BinaryTree<T, Node>::root;
     using BinaryTree<T, Node>::compare;
+    using BinaryTree<T, Node>::own;
 
     const Node* containsInternal(const Node* const &node, const T &value) const;
 
@@ -53,6 +83,62 @@ class AVLTree: virtual public BinaryTree<T, Node> {
     Node* popMostLeftInternal(Node *&node);
     Node* popMostRightInternal(Node *&node);
 
+    static uint8_t getHeight(const Node *node) noexcept;
+
+    /*
+     * Join two trees, every value of left less than middle and every value of right greater, into one.
+     * Without middle, the greatest value of left is taken out to join around instead.
+     */
+    Node* join(Node *left, Node *middle, Node *right);
+    Node* join(Node *left, Node *right);
+
+    // Split node into the values less than value, the node holding value (or nullptr), and the values greater
+    void split(Node *node, const T &value, Node *&left, Node *&middle, Node *&right);
+
+  public:
+    // What an operation of applyBatch() does with its value
+    enum Operation {contains_operation, insert_operation, remove_operation};
+
+    struct BatchOperation {
+        Operation operation;
+        T value;
+    };
+
+  protected:
+    // Sub-batches smaller than this are not worth a thread
+    static constexpr size_t batch_grain = 2048;
+
+    // As few values as this are applied one at a time
+    static constexpr size_t batch_leaf = 4;
+
+    struct Batch {
+        const BatchOperation *operations;
+
+        // Operations sorted by value, keeping the order of operations on the same value
+        std::vector<size_t> order;
+
+        // Where each run of operations on one value starts in order, and the end of the last
+        std::vector<size_t> runs;
+
+        // How many runs before each run hold an insert or a remove
+        std::vector<size_t> writes;
+
+        // Not std::vector<bool>, threads write results side by side
+        std::vector<unsigned char> results;
+
+        const T& value(size_t run) const { return operations[order[runs[run]]].value; }
+    };
+
+    void sortBatch(Batch &batch, size_t begin, size_t end, unsigned threads);
+
+    // Answer the operations of a run in order, given whether its value was present, and return whether it is after.
+    // inserted is the value of the insert that last made it present.
+    static bool applyRun(Batch &batch, size_t run, bool present, const T *&inserted);
+
+    // Apply runs [begin, end) to node, returning the new tree and adding how many values were gained to change
+    Node* applyBatchInternal(Node *node, Batch &batch, size_t begin, size_t end, unsigned threads,
+                             ptrdiff_t &change);
+
   public:
     using BinaryTree<T, Node>::empty;
 
@@ -63,6 +149,17 @@ class AVLTree: virtual public BinaryTree<T, Node> {
 
     bool contains(const T &value) noexcept override;
 
+    /**
+     * Apply length operations, returning the result of each in the order given, the same as applying them one at a
+     * time would. Runs on up to threads threads, the calling one included.
+     */
+    virtual std::vector<bool> applyBatch(const BatchOperation *operations, size_t length,
+                                         unsigned threads = std::thread::hardware_concurrency());
+    std::vector<bool> applyBatch(const std::vector<BatchOperation> &operations,
+                                 unsigned threads = std::thread::hardware_concurrency()) {
+        return applyBatch(operations.data(), operations.size(), threads);
+    }
+
     // Specialized getHeight(). Implement O(1) algorithm specific to AVL trees
     size_t getHeight() const noexcept override;
 
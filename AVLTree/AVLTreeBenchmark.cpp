@@ -8,14 +8,21 @@
 
 // Google benchmark, https://github.com/google/benchmark
 #include <benchmark/benchmark.h>
+#include <vector>
 
 //#define BINARYTREE_SANITY_CHECK
 
 // Default test parameters
 #define TESTS Ranges({{1 << 10, 8 << 10}, {128, 512}})->Complexity()->Threads(1)->ThreadPerCpu()
+// Forks mostly go unwritten
+#define FORK_TESTS Ranges({{1 << 10, 64 << 10}, {0, 16}})->Complexity()
+// Tree size, batch length, and for batches the threads
+#define BATCH_TESTS Ranges({{1 << 16, 1 << 20}, {1 << 10, 1 << 17}})
+#define PARALLEL_BATCH_TESTS Ranges({{1 << 16, 1 << 20}, {1 << 10, 1 << 17}, {1, 8}})->UseRealTime()
 
 #include "AVLTree.h"
 #include "AVLTreeCountable.h"
+#include "../BitmapTrie/BitmapTrie.h"
 
 inline int RandomNumber() {
     return rand();
@@ -123,4 +130,128 @@ static void BM_AVLTreeCountableContains(benchmark::State &state) {
 }
 BENCHMARK(BM_AVLTreeCountableContains)->TESTS;
 
+// Copy a base tree, write a few values to the copy, and throw it away
+template <class Tree>
+static void BM_AVLTreeFork(benchmark::State &state) {
+    Tree base;
+    ConstructRandomTree(base, state.range(0));
+    for (auto _ : state) {
+        Tree fork = base;
+        for (int j = 0; j < state.range(1); j++)
+            fork.insert(RandomNumber());
+        benchmark::DoNotOptimize(fork);
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_AVLTreeFork, AVLTree<int>)->FORK_TESTS;
+BENCHMARK_TEMPLATE(BM_AVLTreeFork, AVLTree<int, SharedAVLTreeNode<int>>)->FORK_TESTS;
+
+// A mix of contains, insert and remove over twice the values the tree starts with, so its size holds steady
+inline std::vector<AVLTree<int>::BatchOperation> RandomBatch(size_t size, size_t length) {
+    std::vector<AVLTree<int>::BatchOperation> batch(length);
+    for (auto &operation : batch) {
+        operation.operation = static_cast<AVLTree<int>::Operation>(RandomNumber() % 3);
+        operation.value = RandomNumber() % (2 * size);
+    }
+    return batch;
+}
+
+static void BM_AVLTreeUnbatched(benchmark::State &state) {
+    AVLTree<int> tree;
+    for (int i = 0; i < state.range(0); i++)
+        tree.insert(RandomNumber() % (2 * state.range(0)));
+    const auto batch = RandomBatch(state.range(0), state.range(1));
+    for (auto _ : state) {
+        for (const auto &operation : batch) {
+            switch (operation.operation) {
+                case AVLTree<int>::contains_operation:
+                    benchmark::DoNotOptimize(tree.contains(operation.value));
+                    break;
+                case AVLTree<int>::insert_operation:
+                    benchmark::DoNotOptimize(tree.insert(operation.value));
+                    break;
+                case AVLTree<int>::remove_operation:
+                    benchmark::DoNotOptimize(tree.remove(operation.value));
+                    break;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_AVLTreeUnbatched)->BATCH_TESTS;
+
+static void BM_AVLTreeBatch(benchmark::State &state) {
+    AVLTree<int> tree;
+    for (int i = 0; i < state.range(0); i++)
+        tree.insert(RandomNumber() % (2 * state.range(0)));
+    const auto batch = RandomBatch(state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.applyBatch(batch, state.range(2)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_AVLTreeBatch)->PARALLEL_BATCH_TESTS;
+
+// The same int workloads on BitmapTrie, for choosing between them
+static void BM_BitmapTrieInsert(benchmark::State &state) {
+    BitmapTrie<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.insert(RandomNumber());
+        benchmark::DoNotOptimize(tree);
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BitmapTrieInsert)->TESTS;
+
+static void BM_BitmapTrieRemove(benchmark::State &state) {
+    BitmapTrie<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.remove(RandomNumber());
+        benchmark::DoNotOptimize(tree);
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BitmapTrieRemove)->TESTS;
+
+static void BM_BitmapTrieContains(benchmark::State &state) {
+    BitmapTrie<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.contains(RandomNumber());
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BitmapTrieContains)->TESTS;
+
+static void BM_BitmapTrieSuccessor(benchmark::State &state) {
+    BitmapTrie<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        state.ResumeTiming();
+        int next;
+        for (int j = 0; j < state.range(1); j++)
+            benchmark::DoNotOptimize(tree.successor(RandomNumber(), next));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BitmapTrieSuccessor)->TESTS;
+
 BENCHMARK_MAIN();
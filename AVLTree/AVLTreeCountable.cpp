@@ -0,0 +1,61 @@
+/**
+ * An AVL tree implementation of a binary tree.
+ */
+#ifndef AVLTREECOUNTABLE_CPP
+#define AVLTREECOUNTABLE_CPP
+#include "AVLTreeCountable.h"
+
+template <class T, class Node>
+AVLTreeCountable<T, Node>::AVLTreeCountable(int (*compare)(const T& a, const T& b)): BinaryTree<T, Node>(compare), BinaryTreeCountable<T, Node>(compare), AVLTree<T, Node>(compare) {}
+
+// Copy constructor
+template <class T, class Node>
+AVLTreeCountable<T, Node>::AVLTreeCountable(const AVLTreeCountable<T, Node>& tree): BinaryTree<T, Node>(tree), BinaryTreeCountable<T, Node>(tree), AVLTree<T, Node>(tree) {}
+
+// Assignment constructor
+template <class T, class Node>
+AVLTreeCountable<T, Node>& AVLTreeCountable<T, Node>::operator=(const AVLTreeCountable<T, Node> &tree) {
+    AVLTree<T, Node>::operator=(tree);
+    _count = tree._count;
+    return *this;
+}
+
+template <class T, class Node>
+bool AVLTreeCountable<T, Node>::insert(const T &value) noexcept {
+    bool result = AVLTree<T, Node>::insert(value);
+    _count += result;
+    return result;
+}
+
+template <class T, class Node>
+bool AVLTreeCountable<T, Node>::remove(const T &value) noexcept {
+    bool result = AVLTree<T, Node>::remove(value);
+    _count -= result;
+    return result;
+}
+
+template <class T, class Node>
+T AVLTreeCountable<T, Node>::popMostLeft() {
+    const T &result = AVLTree<T, Node>::popMostLeft();
+    _count--;
+    return result;
+}
+
+template <class T, class Node>
+T AVLTreeCountable<T, Node>::popMostRight() {
+    const T &result = AVLTree<T, Node>::popMostRight();
+    _count--;
+    return result;
+}
+template <class T, class Node>
+std::vector<bool> AVLTreeCountable<T, Node>::applyBatch(const typename AVLTree<T, Node>::BatchOperation *operations,
+                                                        size_t length, unsigned threads) {
+    std::vector<bool> results = AVLTree<T, Node>::applyBatch(operations, length, threads);
+    for (size_t i = 0; i < length; i++) {
+        if (!results[i]) continue;
+        if (operations[i].operation == AVLTree<T, Node>::insert_operation) _count++;
+        if (operations[i].operation == AVLTree<T, Node>::remove_operation) _count--;
+    }
+    return results;
+}
+#endif //AVLTREECOUNTABLE_CPP
@@ -2,8 +2,10 @@
  * Test cases for testing the sanity of the AVLTree
  */
 
+#include <set>
 #include <cstdio>
 #include <vector>
+#include <cstdlib>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
@@ -14,6 +16,9 @@
 // Because the test must also pass all sanity checks
 #define BINARYTREE_SANITY_CHECK
 #include "AVLTree.h"
+#include "../AVLTreeFlat/AVLTreeFlat.h"
+#include "../util/epoch_reclaimer.h"
+#include "../util/tree_test.h"
 
 using namespace std;
 
@@ -430,11 +435,6 @@ bool check_forward_reverse_iterators(
                       reverse_first, reverse_last);
 }
 
-template <class T, class It>
-inline bool iteratorEquals(It first, It last, std::initializer_list<T> init_values) {
-    return std::equal(first, last, init_values.begin(), init_values.end());
-}
-
 // Test the given tree
 template <class Tree>
 void test() {
@@ -1185,7 +1185,197 @@ void test() {
 #endif
 }
 
+// An AVLTreeNode counting how many are still allocated, derived from Base to pick how the tree frees it
+template <class Base>
+struct CountedNode: public Base {
+    using value_type = int;
+
+    explicit CountedNode(const int &value): left(nullptr), right(nullptr), height(1), value(value) {alive++;}
+    CountedNode(const CountedNode &node):
+        Base(), left(node.left), right(node.right), height(node.height), value(node.value) {alive++;}
+    CountedNode& operator=(const CountedNode &node) = default;
+    ~CountedNode() {alive--;}
+
+    CountedNode *left;
+    CountedNode *right;
+    uint8_t height;
+    int value;
+
+    static int alive;
+};
+template <class Base>
+int CountedNode<Base>::alive = 0;
+
+struct PlainNode {};
+using CountedAVLTreeNode = CountedNode<PlainNode>;
+
+void test_pop_frees_nodes() {
+    // Popped nodes must be freed along with the rest
+    bool passed = true;
+    {
+        AVLTree<int, CountedAVLTreeNode> tree;
+        for (int i = 0; i < 100; i++) tree.insert(i);
+        for (int i = 0; i < 10; i++) {
+            passed &= tree.popMostLeft() == i;
+            passed &= tree.popMostRight() == 99 - i;
+        }
+        passed &= CountedAVLTreeNode::alive == 80 && tree.size() == 80;
+        tree.sanityCheck();
+    }
+    passed &= CountedAVLTreeNode::alive == 0;
+
+    cout << "Pop Frees Nodes Check      : " << (passed ? "passed" : "failed") << endl;
+}
+
+void test_copy_on_write() {
+    // Copies share nodes until written, and neither sees the other's writes
+    using Tree = AVLTree<int, SharedAVLTreeNode<int>>;
+    bool passed = true;
+
+    Tree base;
+    for (int i = 0; i < 1000; i++) base.insert(i);
+
+    Tree copy = base;
+    passed &= copy == base;
+    passed &= copy.insert(1000) && !copy.insert(500) && copy.remove(0) && !copy.remove(-1);
+    passed &= copy.popMostLeft() == 1 && copy.popMostRight() == 1000;
+    copy.sanityCheck();
+
+    passed &= base.size() == 1000 && base.contains(0) && !base.contains(1000);
+    passed &= base.getMostLeft() == 0 && base.getMostRight() == 999;
+    base.sanityCheck();
+
+    // Writes through every copy, then drop them in turn
+    Tree forest[4];
+    for (int t = 0; t < 4; t++) {
+        forest[t] = base;
+        for (int i = t; i < 1000; i += 4) passed &= forest[t].remove(i);
+    }
+    for (int t = 0; t < 4; t++) {
+        passed &= forest[t].size() == 750 && !forest[t].contains(t) && forest[t].contains((t + 1) % 4);
+        forest[t].sanityCheck();
+        forest[t].clear();
+    }
+    passed &= base.size() == 1000 && base.contains(0) && base.contains(999);
+    base.sanityCheck();
+
+    cout << "Copy On Write Check        : " << (passed ? "passed" : "failed") << endl;
+}
+
+template <class Tree>
+void test_apply_batch() {
+    // Batches must give the same results as applying their operations one at a time
+    using Operation = typename Tree::BatchOperation;
+    bool passed = true;
+
+    Tree tree;
+    set<int> reference;
+    passed &= tree.applyBatch(vector<Operation>()).empty();
+
+    srand(0);
+    for (unsigned threads : {1u, 4u}) {
+        for (size_t length : {1, 10, 1000, 20000}) {
+            // Keep a copy to check the batch leaves it alone
+            const Tree before = tree;
+            const size_t before_size = reference.size();
+
+            // Values are repeated often within a batch
+            vector<Operation> batch(length);
+            for (Operation &operation : batch) {
+                operation.operation = static_cast<typename Tree::Operation>(rand() % 3);
+                operation.value = rand() % 20000;
+            }
+
+            const vector<bool> results = tree.applyBatch(batch, threads);
+            passed &= results.size() == length;
+            for (size_t i = 0; i < length && i < results.size(); i++) {
+                const int value = batch[i].value;
+                switch (batch[i].operation) {
+                    case Tree::contains_operation:
+                        passed &= results[i] == (reference.count(value) != 0);
+                        break;
+                    case Tree::insert_operation:
+                        passed &= results[i] == reference.insert(value).second;
+                        break;
+                    case Tree::remove_operation:
+                        passed &= results[i] == (reference.erase(value) != 0);
+                        break;
+                }
+            }
+
+            passed &= tree.size() == reference.size();
+            passed &= equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end());
+            tree.sanityCheck();
+            passed &= before.size() == before_size;
+            before.sanityCheck();
+        }
+    }
+
+    // A batch of contains leaves the tree as it was
+    vector<Operation> reads;
+    for (int value = -10; value < 20010; value++) reads.push_back({Tree::contains_operation, value});
+    const Tree before = tree;
+    const vector<bool> results = tree.applyBatch(reads, 4);
+    for (size_t i = 0; i < reads.size(); i++) passed &= results[i] == (reference.count(reads[i].value) != 0);
+    passed &= check_identical(tree, before);
+
+    // Removing everything
+    vector<Operation> removes;
+    for (int value : reference) removes.push_back({Tree::remove_operation, value});
+    const vector<bool> removed = tree.applyBatch(removes, 4);
+    passed &= tree.empty() && count(removed.begin(), removed.end(), true) == ptrdiff_t(reference.size());
+    tree.sanityCheck();
+
+    cout << "Apply Batch Check          : " << (passed ? "passed" : "failed") << endl;
+}
+
+// Freed through EpochReclaimer
+using ReclaimedAVLTreeNode = CountedNode<ReclaimedNode>;
+
+void test_reclaimed_nodes() {
+    // Nodes unlinked while a guard is held must outlive it, and all be freed once no guard is held
+    bool passed = true;
+    {
+        AVLTree<int, ReclaimedAVLTreeNode> tree;
+        for (int i = 0; i < 1000; i++) tree.insert(i);
+        passed &= ReclaimedAVLTreeNode::alive == 1000;
+
+        {
+            EpochReclaimer::Guard guard;
+            for (int i = 0; i < 500; i++) tree.remove(i * 2);
+            passed &= tree.popMostLeft() == 1 && tree.popMostRight() == 999;
+            EpochReclaimer::collect();
+            passed &= ReclaimedAVLTreeNode::alive == 1000;
+        }
+        EpochReclaimer::synchronize();
+        passed &= ReclaimedAVLTreeNode::alive == 498 && tree.size() == 498;
+        tree.sanityCheck();
+
+        const AVLTree<int, ReclaimedAVLTreeNode> copy = tree;
+        tree.clear();
+        EpochReclaimer::synchronize();
+        passed &= ReclaimedAVLTreeNode::alive == 498 && copy.size() == 498;
+    }
+    EpochReclaimer::synchronize();
+    passed &= ReclaimedAVLTreeNode::alive == 0;
+
+    cout << "Reclaimed Node Check       : " << (passed ? "passed" : "failed") << endl;
+}
+
 int main() {
     cout << "AVLTree Tests" << endl;
     test<AVLTree<int>>();
+    test_pop_frees_nodes();
+    test_apply_batch<AVLTree<int>>();
+
+    cout << "Copy On Write AVLTree Tests" << endl;
+    test<AVLTree<int, SharedAVLTreeNode<int>>>();
+    test_copy_on_write();
+    test_apply_batch<AVLTree<int, SharedAVLTreeNode<int>>>();
+
+    cout << "Reclaimed Node AVLTree Tests" << endl;
+    test_reclaimed_nodes();
+
+    cout << "AVLTreeFlat Tests" << endl;
+    test<AVLTreeFlat<int>>();
 }
@@ -2,82 +2,78 @@
 #define AVLTREEFLAT_CPP
 
 #include <cassert>
+#include <sstream>
+#include <utility>
 #include <algorithm>
 #include "AVLTreeFlat.h"
 
-template <class T, class Node, class Container>
-inline size_t AVLTreeFlat<T, Node, Container>::getLeft(const size_t index) const noexcept {
+template <class T, class Storage>
+inline size_t AVLTreeFlat<T, Storage>::getLeft(const size_t index) noexcept {
     return index * 2 + 1;
 }
 
-template <class T, class Node, class Container>
-inline size_t AVLTreeFlat<T, Node, Container>::getRight(const size_t index) const noexcept {
+template <class T, class Storage>
+inline size_t AVLTreeFlat<T, Storage>::getRight(const size_t index) noexcept {
     return index * 2 + 2;
 }
 
-template <class T, class Node, class Container>
-inline size_t AVLTreeFlat<T, Node, Container>::getParent(const size_t index) const noexcept {
+template <class T, class Storage>
+inline size_t AVLTreeFlat<T, Storage>::getParent(const size_t index) noexcept {
     return (index - 1) / 2;
 }
 
-template <class T, class Node, class Container>
-inline uint8_t AVLTreeFlat<T, Node, Container>::getNodeHeight(const size_t index) const noexcept {
-    // Figures out the height of the node from index
+template <class T, class Storage>
+inline size_t AVLTreeFlat<T, Storage>::getLevel(const size_t index) noexcept {
+    // Figures out the level of the node from index
     // Algorithm is: floor(log2(index + 1))
 
     // By directly calling assembly, we save time since we don't care about the case where the index == MAX_SIZE_T
     // Inspired by https://stackoverflow.com/a/994709
     size_t value = index + 1;
-    uint64_t height;
+    uint64_t level;
     asm ("\tbsr %1, %0\n"
-      : "=r"(height)
+      : "=r"(level)
       : "g" (value)
     );
-    return height;
+    return level;
 }
 
-template <class T, class Node, class Container>
-inline Node& AVLTreeFlat<T, Node, Container>::getNode(const size_t index) const noexcept {
-    return tree[index];
+template <class T, class Storage>
+inline bool AVLTreeFlat<T, Storage>::exists(const size_t index) const noexcept {
+    return index < tree.size() && tree.occupied(index);
 }
 
-template <class T, class Node, class Container>
-void AVLTreeFlat<T, Node, Container>::updateHeight(size_t index) {
+template <class T, class Storage>
+inline uint8_t AVLTreeFlat<T, Storage>::getIndexHeight(const size_t index) const noexcept {
+    return index < tree.size() ? tree.height(index) : 0;
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::updateHeight(const size_t index) {
     /**
      * Helper function to recalculate the height after a node is modified.
      */
-    // The height of the index being check should not be zero
-    assert(getNodeHeight(index) != 0);
-    size_t left_index = getLeft(index);
-
-    uint8_t height;
-    if (left_index < tree.size()) {
-        // left_index and right index are known to exist
-        size_t right_index = getRight(index);
-        height = std::max(tree[left_index].height, tree[right_index].height) + 1;
-    } else {
-        // If left is off of tree, right will be off of tree
-        height = 1;
-    }
-
-    tree[index].height = height;
+    assert(exists(index));
+    tree.height(index) = std::max(getIndexHeight(getLeft(index)), getIndexHeight(getRight(index))) + 1;
 }
 
-template <class T, class Node, class Container>
-bool AVLTreeFlat<T, Node, Container>::contains(const T &value) noexcept {
+template <class T, class Storage>
+size_t AVLTreeFlat<T, Storage>::find(const T &value) const noexcept {
     /**
-     * Check if value is present in the tree.
-     * Uses a binary search to determine if value in the tree.
-     *
-     * Return true if value is contained. False otherwise.
+     * Binary search for the value.
+     * Returns the index holding value, or end_index if not found.
      */
     size_t index = 0;
 
-    // If the height is zero, then stop.
-    while (index < tree.size() && getNodeHeight(index) != 0) {
-        auto cmp = compare(value, getNode(index));
+    // Stop on an empty slot, or falling off the bottom of the array.
+    while (exists(index)) {
+        // The keys of all four grandchildren are adjacent, so fetch them while comparing here
+        const size_t grandchildren = getLeft(getLeft(index));
+        if (grandchildren < tree.size()) tree.prefetch(grandchildren);
+
+        auto cmp = compare(value, tree.key(index));
         if (cmp == 0) {
-            return true;
+            return index;
         } else if (cmp < 0) {
             // Negative comparison
             // value is less than node
@@ -92,227 +88,177 @@ bool AVLTreeFlat<T, Node, Container>::contains(const T &value) noexcept {
     }
 
     // Failed to find the value.
-    return false;
-}
-
-template <class T, class Node, class Container>
-void AVLTreeFlat<T, Node, Container>::leftRotation(size_t index) {
-//    /**
-//     * Rotate the tree left about the given node.
-//     */
-//    // Assert this is a valid value
-//    assert(index < tree.size() && tree[index].height != 0);
-//
-//    // Assert the next value down exists in the tree
-//    assert(getLeft(index) < tree.size());
-//
-//    // Assert that at least one child exists
-//    assert(tree[getLeft(index)].height + tree[getRight(index)].height > 0);
-//
-//    size_t temp = getRight(index);
-//    size_t temp_left = getLeft(temp);
-//    size_t temp_right = getRight(temp);
-//    /* Assume the tree is in a state that would require a rotation.
-//     * Visualization
-//     * Two cases:
-//     ***************************************
-//     * Case 1 (Outer):
-//     *                  B  <- Passed node
-//     *                /   \
-//     * May Exist ->  A     D  <- Must exist
-//     *                    / \
-//     *     May Exist ->  C   F  <- Must exist
-//     *                      / \
-//     *                     E   G  <- May exist (At least 1 will exist if A exists)
-//     *
-//     * Solution 1:
-//     *                  D
-//     *                /   \
-//     *               B     F
-//     *              / \   / \
-//     *             A   C E   G
-//     ***************************************
-//     * Case 2 (Inner):
-//     *                  B  <- Passed node
-//     *                /   \
-//     * May Exist ->  A     F   <- Must exist
-//     *                    / \
-//     *    Must Exist ->  D   G  <- May exist
-//     *                  / \
-//     *                 C   E <- May exist (At least 1 will exist if A exists)
-//     *
-//     * Solution 2:
-//     *                  D
-//     *                /   \
-//     *               B     F
-//     *              / \   / \
-//     *             A   C E   G
-//     */
-//    // Test if right->right exists, that will determine the case
-//    // After careful consideration and testing
-//    // it is noted that if the heights are equal, the outer case *must* be used
-//    // to avoid an odd case that occurs during removals.
-//    if (// If the right exists, and the left doesn't
-//            (temp_right < tree.size()) &&
-//            // Either left doesn't exist or both exist and the right is "taller" than the left
-//            // and so long as we assume one is non-zero
-//            (tree[temp_right].height >= tree[temp_left].height)
-//            ) {
-//        // Case 1
-//        // node->right needs to become node->right->left
-//        // node->right safe in temp
-//        tree[temp].value = tree[temp_left].value;
-//        // (original right)
-//        // temp->left needs to become node
-//        // temp->left is safe because it just became node->right
-//        tree[temp_left].value = tree[index].value;
-//
-//        // node needs to become temp
-//        // node is safe as temp->left
-//        node = temp;
-//    } else {
-//        // Case 2
-//        // node->right needs to become node->right->left->left
-//        // node->right safe in temp
-//        node->right = temp->left->left;
-//
-//        // (original right)
-//        // temp->left->left needs to become node
-//        // temp->left->left is safe because it just became node->right
-//        temp->left->left = node;
-//
-//        // node needs to become temp->left
-//        // node is safe as temp->left->left
-//        node = temp->left;
-//
-//        // temp->left needs to become (new) node->right
-//        // that is the original node->right->left->right
-//        temp->left = node->right;
-//
-//        // (new) node->right needs to become temp
-//        node->right = temp;
-//    }
-//
-//    // Recalculate heights
-//    // Recalculate for node->left, node->right, and node
-//    updateHeight(node->left);
-//    updateHeight(node->right);
-//    updateHeight(node);
-}
-
-template <class T, class Node, class Container>
-void AVLTreeFlat<T, Node, Container>::rightRotation(size_t index) {
-//    /**
-//     * Rotate the tree right about the given node.
-//     */
-//    // Assert node is not null, and left is not null
-//    assert(node != nullptr);
-//
-//    // The temp pointer is constant, but the
-//    // value of the pointer may be modified.
-//    auto * const temp = node->left;
-//
-//    assert(temp != nullptr);
-//    /* Assume the tree is in a state that would require a rotation.
-//     * Visualization
-//     * Two cases:
-//     ***************************************
-//     * Case 1 (Outer):
-//     *                    F  <- Passed node
-//     *                  /   \
-//     * Must Exist ->   D     G  <- May exist
-//     *                / \
-//     * Must Exist -> B   E  <- May exist
-//     *              / \
-//     *             A   C  <- May exist (At least 1 will exist if G exists)
-//     *
-//     * Solution 1:
-//     *                    D
-//     *                  /   \
-//     *                 B     F
-//     *                / \   / \
-//     *               A   C E   G
-//     ***************************************
-//     * Case 2 (Inner):
-//     *                   F  <- Passed node
-//     *                 /   \
-//     * Must Exist ->  B     G   <- May exist
-//     *               / \
-//     * May Exist -> A   D  <- Must exist
-//     *                 / \
-//     *                C   E <- May exist (At least 1 will exist if A exists)
-//     *
-//     * Solution 2:
-//     *                   D
-//     *                 /   \
-//     *                B     F
-//     *               / \   / \
-//     *              A   C E   G
-//     */
-//    // Test if left->left exists, that will determine the case
-//    // After careful consideration and testing
-//    // it is noted that if the heights are equal, the outer case *must* be used
-//    // to avoid an odd case that occurs during removals.
-//    if (
-//        // If the left exists, and the right doesn't
-//            (node->left->left != nullptr) && (
-//                    // Either right doesn't exist
-//                    (node->left->right == nullptr) ||
-//                    // Or both exist and the left is "taller" than the right
-//                    (node->left->left->height >= node->left->right->height)
-//            )) {
-//        // Case 1
-//        // node->left needs to become node->left->right
-//        // node->left safe in temp
-//        node->left = node->left->right;
-//        // (original left)
-//        // temp->right needs to become node
-//        // temp->right is safe because it just became node->left
-//        temp->right = node;
-//
-//        // node needs to become temp
-//        // node is safe as temp->right
-//        node = temp;
-//    } else {
-//        // Case 2
-//        // node->left needs to become node->left->right->right
-//        // node->left safe in temp
-//        node->left = temp->right->right;
-//
-//        // (original left)
-//        // temp->right->right needs to become node
-//        // temp->right->right is safe because it just became node->left
-//        temp->right->right = node;
-//
-//        // node needs to become temp->right
-//        // node is safe as temp->right->right
-//        node = temp->right;
-//
-//        // temp->right needs to become (new) node->left
-//        // that is the original node->left->right->left
-//        temp->right = node->left;
-//
-//        // (new) node->right needs to become temp
-//        node->left = temp;
-//    }
-//
-//    // Recalculate heights
-//    // Recalculate for node->left, node->right, and node
-//
-//    updateHeight(node->left);
-//    updateHeight(node->right);
-//    updateHeight(node);
-}
-
-template <class T, class Node, class Container>
-void AVLTreeFlat<T, Node, Container>::rebalance(size_t index) {
+    return end_index;
+}
+
+template <class T, class Storage>
+bool AVLTreeFlat<T, Storage>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the tree.
+     *
+     * Return true if value is contained. False otherwise.
+     */
+    return find(value) != end_index;
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::moveSubtree(const size_t from, const size_t to) {
+    /**
+     * Move a subtree one level at a time.
+     *
+     * The descendants of an index at a given depth are a contiguous range of the array,
+     * so every level of the subtree is a block move.
+     *
+     * Moving down (to > from), the destination overlaps the bottom of the source.
+     * Going from the bottom level up, each level is read before anything is written over it.
+     * Moving up, the source overlaps the bottom of the destination, so go from the top down.
+     * Sideways moves don't overlap, and either order works.
+     */
+    if (!exists(from)) {
+        // Nothing to move, but to must still end up empty.
+        if (to < tree.size()) tree.erase(to);
+        return;
+    }
+
+    const size_t levels = tree.height(from);
+
+    // Keep the array big enough for the bottom of the subtree.
+    // Rebalancing never makes a subtree taller, so this is only a safety net.
+    while (((to + 1) << (levels - 1)) + (size_t(1) << (levels - 1)) - 1 > tree.size()) {
+        tree.resize(tree.size() * 2 + 1);
+    }
+
+    const auto moveLevel = [this, from, to](size_t level) {
+        const size_t width = size_t(1) << level;
+        const size_t source = ((from + 1) << level) - 1;
+        const size_t destination = ((to + 1) << level) - 1;
+
+        // Empties the source. Anything that should be there is written later.
+        tree.moveRange(source, destination, width);
+    };
+
+    if (to > from) {
+        for (size_t level = levels; level > 0;) moveLevel(--level);
+    } else {
+        for (size_t level = 0; level < levels; level++) moveLevel(level);
+    }
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::singleLeftRotation(const size_t index) {
+    /**
+     * Bring the right node up to index.
+     *
+     *                B                      D
+     *               / \                    / \
+     *              A   D        ->        B   E
+     *                 / \                / \
+     *                C   E              A   C
+     *
+     * Done in an order where each subtree moves into space that is already empty.
+     */
+    const size_t left = getLeft(index);
+    const size_t right = getRight(index);
+    assert(exists(right));
+
+    // A moves down, making space for B
+    moveSubtree(left, getLeft(left));
+    // C moves across
+    moveSubtree(getLeft(right), getRight(left));
+    // B moves down
+    tree.move(index, left);
+    // D moves up
+    tree.move(right, index);
+    // E moves up into the space D left
+    moveSubtree(getRight(right), right);
+
+    updateHeight(left);
+    updateHeight(index);
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::singleRightRotation(const size_t index) {
+    /**
+     * Bring the left node up to index.
+     *
+     *                  D                  B
+     *                 / \                / \
+     *                B   E      ->      A   D
+     *               / \                    / \
+     *              A   C                  C   E
+     *
+     * Done in an order where each subtree moves into space that is already empty.
+     */
+    const size_t left = getLeft(index);
+    const size_t right = getRight(index);
+    assert(exists(left));
+
+    // E moves down, making space for D
+    moveSubtree(right, getRight(right));
+    // C moves across
+    moveSubtree(getRight(left), getLeft(right));
+    // D moves down
+    tree.move(index, right);
+    // B moves up
+    tree.move(left, index);
+    // A moves up into the space B left
+    moveSubtree(getLeft(left), left);
+
+    updateHeight(right);
+    updateHeight(index);
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::leftRotation(const size_t index) {
+    /**
+     * Rotate the tree left about the given node.
+     *
+     * Same cases as AVLTree::leftRotation().
+     * Case 1 (Outer) is a single rotation.
+     * Case 2 (Inner) brings right->left up twice, first above right, then above index.
+     */
+    const size_t right = getRight(index);
+    assert(exists(right));
+
+    // if the heights are equal, the outer case *must* be used
+    // to avoid an odd case that occurs during removals.
+    const uint8_t outer_height = getIndexHeight(getRight(right));
+    if (outer_height == 0 || outer_height < getIndexHeight(getLeft(right))) {
+        // Case 2
+        singleRightRotation(right);
+    }
+    singleLeftRotation(index);
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::rightRotation(const size_t index) {
+    /**
+     * Rotate the tree right about the given node.
+     *
+     * Same cases as AVLTree::rightRotation().
+     * Case 1 (Outer) is a single rotation.
+     * Case 2 (Inner) brings left->right up twice, first above left, then above index.
+     */
+    const size_t left = getLeft(index);
+    assert(exists(left));
+
+    // if the heights are equal, the outer case *must* be used
+    // to avoid an odd case that occurs during removals.
+    const uint8_t outer_height = getIndexHeight(getLeft(left));
+    if (outer_height == 0 || outer_height < getIndexHeight(getRight(left))) {
+        // Case 2
+        singleLeftRotation(left);
+    }
+    singleRightRotation(index);
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::rebalance(const size_t index) {
     /**
      * If needed, shifts node, node->left, and node->right
      * will to transformed to balance the node.
      */
-    // Assert children exist
-    assert(getLeft(index) < tree.size());
-    int cmp = tree[getLeft(index)].height - tree[getRight(index)].height;
+    int cmp = getIndexHeight(getLeft(index)) - getIndexHeight(getRight(index));
 
     // If the difference between left and right is greater than 1, we need to rebalance.
     if (cmp >= 2) {
@@ -329,8 +275,21 @@ void AVLTreeFlat<T, Node, Container>::rebalance(size_t index) {
     // Otherwise, no rotation is needed
 }
 
-template <class T, class Node, class Container>
-bool AVLTreeFlat<T, Node, Container>::insert(const T &value) noexcept {
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::rebalancePath(size_t index) {
+    // Parents are found by arithmetic, so no recursion is needed to walk back up
+    while (true) {
+        if (exists(index)) {
+            updateHeight(index);
+            rebalance(index);
+        }
+        if (index == 0) break;
+        index = getParent(index);
+    }
+}
+
+template <class T, class Storage>
+bool AVLTreeFlat<T, Storage>::insert(const T &value) noexcept {
     /**
      * Insert a new value into the tree.
      *
@@ -340,151 +299,441 @@ bool AVLTreeFlat<T, Node, Container>::insert(const T &value) noexcept {
      */
     size_t index = 0;
 
-    // If the height is zero, then stop.
-    while (index < tree.size()) {
-        if (tree[index].height == 0) {
+    while (true) {
+        if (index >= tree.size()) {
+            // Extend the tree by a level to add the value
+            tree.resize(tree.size() * 2 + 1);
+        }
+
+        if (!tree.occupied(index)) {
             // Insert the new value here
-            tree[index].value = value;
-            tree[index].height = 1;
-            return true;
-        } else {
-            auto cmp = compare(value, getIndexValue(index));
-            if (cmp == 0) {
-                return false;
-            } else if (cmp < 0) {
-                // Negative comparison
-                // value is less than node
-                // Go left
-                index = getLeft(index);
-            } else {
-                // Positive comparison
-                // value is greater than node
-                // Go right
-                index = getRight(index);
-            }
+            tree.set(index, value);
+            break;
         }
+
+        auto cmp = compare(value, tree.key(index));
+        if (cmp == 0) {
+            // value exists in the tree
+            // do not modify, nothing inserted
+            return false;
+        }
+        index = cmp < 0 ? getLeft(index) : getRight(index);
     }
+    count++;
+
+    // Walk back up, raising heights and balancing.
+    // Once a height does not change, nothing above it changes either.
+    while (index != 0) {
+        const size_t child = index;
+        index = getParent(index);
 
-    // Extend the tree to add the value
-    tree.resize(tree.size() * 2);
+        if (tree.height(index) > tree.height(child)) break;
 
-    tree[index].value = value;
-    tree[index].height = 1;
+        tree.height(index)++;
+        rebalance(index);
+    }
     return true;
 }
 
-template <class T, class Node, class Container>
-T AVLTreeFlat<T, Node, Container>::popMostLeft() {
-    return popMostLeftInternal(0)->value;
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::unlink(const size_t index) {
+    assert(!exists(getLeft(index)) || !exists(getRight(index)));
+
+    // The remaining child, if any, takes the place of index.
+    // Because AVL, that child is only a leaf.
+    if (exists(getLeft(index))) {
+        moveSubtree(getLeft(index), index);
+    } else {
+        moveSubtree(getRight(index), index);
+    }
+
+    if (index != 0) rebalancePath(getParent(index));
+    count--;
+    shrink();
 }
 
-template <class T, class Node, class Container>
-Node* AVLTreeFlat<T, Node, Container>::popMostLeftInternal(size_t index) {
-    size_t left = getLeft(index);
-    Node *temp;
-    if (getIndexHeight(left) != 0) {
-        temp = popMostLeftInternal(left);
-        // Update height
-        updateHeight(index);
-        rebalance(index);
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::shrink() {
+    // Keep one spare level, so inserting and removing at the bottom does not resize back and forth
+    const size_t levels = getLevel(tree.size());
+    const size_t height = getHeight();
+
+    if (height == 0) {
+        tree.clear();
+    } else if (levels > height + 1) {
+        tree.resize((size_t(1) << (height + 1)) - 1);
+    }
+}
+
+template <class T, class Storage>
+T AVLTreeFlat<T, Storage>::popMostLeft() {
+    if (empty()) {
+        // There are no values, so nothing valid to return
+        throw std::out_of_range("tree is empty");
+    }
+
+    size_t index = 0;
+    while (exists(getLeft(index))) index = getLeft(index);
+
+    T result = std::move(tree.key(index));
+    unlink(index);
+    return result;
+}
+
+template <class T, class Storage>
+T AVLTreeFlat<T, Storage>::popMostRight() {
+    if (empty()) {
+        // There are no values, so nothing valid to return
+        throw std::out_of_range("tree is empty");
+    }
+
+    size_t index = 0;
+    while (exists(getRight(index))) index = getRight(index);
+
+    T result = std::move(tree.key(index));
+    unlink(index);
+    return result;
+}
+
+template <class T, class Storage>
+bool AVLTreeFlat<T, Storage>::remove(const T &value) noexcept {
+    const size_t index = find(value);
+    if (index == end_index) return false;
+
+    if (exists(getRight(index))) {
+        // Replace this value with the most left value of its right branch.
+        size_t replacement = getRight(index);
+        while (exists(getLeft(replacement))) replacement = getLeft(replacement);
+
+        tree.key(index) = std::move(tree.key(replacement));
+        unlink(replacement);
     } else {
-        // Return node, but remove from tree.
+        // No right branch, so the left (if any) takes its place
+        unlink(index);
     }
-    return temp;
+    return true;
 }
 
-template <class T, class Node, class Container>
-T AVLTreeFlat<T, Node, Container>::popMostRight() {
-    return popMostRightInternal(0)->value;
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::clear() noexcept {
+    tree.clear();
+    count = 0;
 }
 
-template <class T, class Node, class Container>
-Node* AVLTreeFlat<T, Node, Container>::popMostRightInternal(size_t index) {
-    size_t right = getRight(index);
-    Node *temp;
-    if (getIndexHeight(right) != 0) {
-        temp = popMostRightInternal(right);
-        // Update height
-        updateHeight(index);
-        rebalance(index);
+template <class T, class Storage>
+bool AVLTreeFlat<T, Storage>::empty() const noexcept {
+    return count == 0;
+}
+
+template <class T, class Storage>
+size_t AVLTreeFlat<T, Storage>::size() const noexcept {
+    return count;
+}
+
+template <class T, class Storage>
+size_t AVLTreeFlat<T, Storage>::getHeight() const noexcept {
+    // Zero if tree is empty
+    return getIndexHeight(0);
+}
+
+template <class T, class Storage>
+T AVLTreeFlat<T, Storage>::getRoot() const {
+    if (!empty()) {
+        return tree.key(0);
     } else {
-        // Return node, but remove from tree.
+        // Invalid to call this when there is no root.
+        throw std::out_of_range("tree is empty");
+    }
+}
+
+template <class T, class Storage>
+T AVLTreeFlat<T, Storage>::getMostLeft() const {
+    if (!empty()) {
+        return tree.key(firstInorder<false>(0));
+    } else {
+        // There are no values, so nothing valid to return
+        // Raise out of bounds error
+        throw std::out_of_range("tree is empty");
+    }
+}
+
+template <class T, class Storage>
+T AVLTreeFlat<T, Storage>::getMostRight() const {
+    if (!empty()) {
+        return tree.key(firstInorder<true>(0));
+    } else {
+        // There are no values, so nothing valid to return
+        // Raise out of bounds error
+        throw std::out_of_range("tree is empty");
+    }
+}
+
+template <class T, class Storage>
+bool AVLTreeFlat<T, Storage>::operator==(const AVLTreeFlat &tree) const noexcept {
+    // Size must match first
+    if (count != tree.count) return false;
+
+    // Use inorder iterator to compare. Identical if the iterators are identical
+    return std::equal(inorder_begin(), inorder_end(), tree.inorder_begin(), tree.inorder_end());
+}
+
+template <class T, class Storage>
+bool AVLTreeFlat<T, Storage>::operator!=(const AVLTreeFlat &tree) const noexcept {
+    return !operator==(tree);
+}
+
+// Printing
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::printTree() const noexcept {
+    printTree(std::cout);
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::printTree(std::ostream &ostream) const noexcept {
+    printTree(0, 0, ' ', true, false, ' ', ostream);
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::printTree(size_t width, const size_t height, const char fill, const bool biasLeft,
+                                                const bool trailing, const char background, std::ostream &ostream) const noexcept {
+    // Spacing is equal to width
+    if (width == 0) {
+        width = getMaxStringWidth();
+    }
+
+    printTreeWithSpacing(width, width, height, fill, biasLeft, trailing, background, ostream);
+}
+
+template <class T, class Storage>
+void AVLTreeFlat<T, Storage>::printTreeWithSpacing(const size_t spacing, size_t width, size_t height,
+                                                           const char fill, const bool biasLeft, const bool trailing,
+                                                           const char background, std::ostream &ostream) const noexcept {
+    if (width == 0) {
+        width = getMaxStringWidth();
+    }
+
+    size_t tree_height = getHeight();
+
+    // If height is zero, it is the height of the tree.
+    if (height == 0) {
+        height = tree_height;
+    } else if (height < tree_height) {
+        tree_height = height;
+    }
+
+    // The array is already in level order
+    size_t index = 0;
+    print_tree_levels<T>([this, &index]() -> const T* {
+        const size_t current = index++;
+        return exists(current) ? &tree.key(current) : nullptr;
+    }, tree_height, spacing, width, height, fill, biasLeft, trailing, background, ostream);
+}
+
+template <class T, class Storage>
+size_t AVLTreeFlat<T, Storage>::getMaxStringWidth() const noexcept {
+    // If width is zero, search tree to determine the maximum width.
+    size_t width = 0;
+    for (auto it = level_order_begin(); it != level_order_end(); ++it) {
+        // Use stringstream to determine length of string representation
+        std::stringstream buf;
+        buf << *it;
+        const size_t node_width = buf.str().length();
+
+        if (node_width > width) width = node_width;
+    }
+    return width;
+}
+
+// Traversals
+// Written once for both directions. Reverse swaps left and right.
+
+template <class T, class Storage>
+template <bool Reverse>
+inline size_t AVLTreeFlat<T, Storage>::getFirst(const size_t index) const noexcept {
+    return Reverse ? getRight(index) : getLeft(index);
+}
+
+template <class T, class Storage>
+template <bool Reverse>
+inline size_t AVLTreeFlat<T, Storage>::getSecond(const size_t index) const noexcept {
+    return Reverse ? getLeft(index) : getRight(index);
+}
+
+template <class T, class Storage>
+template <bool Reverse>
+inline bool AVLTreeFlat<T, Storage>::isFirst(const size_t index) const noexcept {
+    // Left children have odd indexes, right children even ones
+    return index != 0 && (index % 2 == 1) != Reverse;
+}
+
+template <class T, class Storage>
+template <bool Reverse>
+size_t AVLTreeFlat<T, Storage>::nextPreorder(size_t index) const noexcept {
+    if (exists(getFirst<Reverse>(index))) return getFirst<Reverse>(index);
+    if (exists(getSecond<Reverse>(index))) return getSecond<Reverse>(index);
+
+    // Backtrack until a node is approached from the first, with a second to move to
+    while (index != 0) {
+        const size_t parent = getParent(index);
+        if (isFirst<Reverse>(index) && exists(getSecond<Reverse>(parent)))
+            return getSecond<Reverse>(parent);
+        index = parent;
+    }
+    return end_index;
+}
+
+template <class T, class Storage>
+template <bool Reverse>
+size_t AVLTreeFlat<T, Storage>::firstPostorder(size_t index) const noexcept {
+    // Descend to the first leaf
+    while (true) {
+        if (exists(getFirst<Reverse>(index)))
+            index = getFirst<Reverse>(index);
+        else if (exists(getSecond<Reverse>(index)))
+            index = getSecond<Reverse>(index);
+        else
+            return index;
+    }
+}
+
+template <class T, class Storage>
+template <bool Reverse>
+size_t AVLTreeFlat<T, Storage>::nextPostorder(const size_t index) const noexcept {
+    if (index == 0) return end_index;
+
+    const size_t parent = getParent(index);
+    if (isFirst<Reverse>(index) && exists(getSecond<Reverse>(parent)))
+        return firstPostorder<Reverse>(getSecond<Reverse>(parent));
+    return parent;
+}
+
+template <class T, class Storage>
+template <bool Reverse>
+size_t AVLTreeFlat<T, Storage>::firstInorder(size_t index) const noexcept {
+    while (exists(getFirst<Reverse>(index))) index = getFirst<Reverse>(index);
+    return index;
+}
+
+template <class T, class Storage>
+template <bool Reverse>
+size_t AVLTreeFlat<T, Storage>::nextInorder(size_t index) const noexcept {
+    if (exists(getSecond<Reverse>(index)))
+        return firstInorder<Reverse>(getSecond<Reverse>(index));
+
+    // Backtrack until approached from the first
+    while (index != 0 && !isFirst<Reverse>(index)) index = getParent(index);
+    return index == 0 ? end_index : getParent(index);
+}
+
+template <class T, class Storage>
+size_t AVLTreeFlat<T, Storage>::nextLevelOrder(size_t index) const noexcept {
+    // The array is in level order, skip the empty slots
+    for (index++; index < tree.size(); index++) {
+        if (tree.occupied(index)) return index;
+    }
+    return end_index;
+}
+
+template <class T, class Storage>
+size_t AVLTreeFlat<T, Storage>::nextReverseLevelOrder(size_t index) const noexcept {
+    // Each level is read right to left
+    size_t level = getLevel(index);
+    size_t level_start = (size_t(1) << level) - 1;
+
+    while (level_start < tree.size()) {
+        while (index > level_start) {
+            if (tree.occupied(--index)) return index;
+        }
+
+        // Start from one past the end of the next level
+        level++;
+        level_start = (size_t(1) << level) - 1;
+        index = (level_start << 1) + 1;
     }
-    return temp;
-}
-
-template <class T, class Node, class Container>
-bool AVLTreeFlat<T, Node, Container>::remove(const T &value) noexcept {
-    return removeInternal(0, value);
-}
-
-//template <class T, class Node, class Container>
-//bool AVLTreeFlat<T, Node, Container>::removeInternal(size_t index, const T &value) {
-//    // If the stack has a nullptr on top, then failed to find node.
-//    if (node == nullptr) return false;
-//
-//    // Choose which way to keep searching.
-//    auto cmp = compare(value, node->value);
-//
-//    if (cmp == 0) {
-//        // This is the value that needs to be removed
-//
-//        // Replace this node with the most left value of its right branch.
-//        // If no right branch, replace with its left (because AVL, if not right the left most be a leaf).
-//        // If neither, just delete this one.
-//        if (node->right != nullptr) {
-//            Node *temp = popMostLeftInternal(node->right);
-//
-//            // Left should be known nullptr
-//            assert(temp->left == nullptr);
-//
-//            // Note that this is done particularly to
-//            // not call assignment on the type.
-//            // it is assumed that is more expensive than
-//            // moving an extra two pointers (in testing this seems to hold even for primitives)
-//
-//            // Move temp into the top of value
-//            temp->left = node->left;
-//            temp->right = node->right;
-//            temp->height = node->height;
-//
-//            // Remove the value node
-//            delete node;
-//            node = temp;
-//            updateHeight(node);
-//            rebalance(node);
-//        } else if (node->left != nullptr) {
-//            // Since right doesn't exist, temp must only be a leaf
-//            assert(node->right == nullptr);
-//            Node *temp = node->left;
-//            assert(temp->left == nullptr && temp->right == nullptr);
-//            assert(node->height == 2);
-//            assert(temp->height == 1);
-//
-//            delete node;
-//            node = temp;
-//            updateHeight(node);
-//            rebalance(node);
-//        } else {
-//            // Neither left nor right, just delete the node with value.
-//            delete node;
-//            node = nullptr;
-//        }
-//        return true;
-//    }
-//
-//    // Otherwise handle recursion
-//    // If negative, go left.
-//    // If positive, go right.
-//    Node *&child = cmp < 0 ? node->left : node->right;
-//
-//    if (!removeInternal(child, value))
-//        return false;
-//
-//    // Otherwise, rebalance
-//    updateHeight(node);
-//    rebalance(node);
-//    return true;
-//}
+    return end_index;
+}
+
+// begin() and end() functions for iterators
+// Every traversal but postorder and inorder begins at the root
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::preorder_iterator AVLTreeFlat<T, Storage>::preorder_begin() const noexcept {
+    return preorder_iterator(this, empty() ? end_index : 0);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::preorder_iterator AVLTreeFlat<T, Storage>::preorder_end() const noexcept {
+    return preorder_iterator(this, end_index);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_preorder_iterator AVLTreeFlat<T, Storage>::reverse_preorder_begin() const noexcept {
+    return reverse_preorder_iterator(this, empty() ? end_index : 0);
+}
 
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_preorder_iterator AVLTreeFlat<T, Storage>::reverse_preorder_end() const noexcept {
+    return reverse_preorder_iterator(this, end_index);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::postorder_iterator AVLTreeFlat<T, Storage>::postorder_begin() const noexcept {
+    return postorder_iterator(this, empty() ? end_index : firstPostorder<false>(0));
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::postorder_iterator AVLTreeFlat<T, Storage>::postorder_end() const noexcept {
+    return postorder_iterator(this, end_index);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_postorder_iterator AVLTreeFlat<T, Storage>::reverse_postorder_begin() const noexcept {
+    return reverse_postorder_iterator(this, empty() ? end_index : firstPostorder<true>(0));
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_postorder_iterator AVLTreeFlat<T, Storage>::reverse_postorder_end() const noexcept {
+    return reverse_postorder_iterator(this, end_index);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::inorder_iterator AVLTreeFlat<T, Storage>::inorder_begin() const noexcept {
+    return inorder_iterator(this, empty() ? end_index : firstInorder<false>(0));
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::inorder_iterator AVLTreeFlat<T, Storage>::inorder_end() const noexcept {
+    return inorder_iterator(this, end_index);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_inorder_iterator AVLTreeFlat<T, Storage>::reverse_inorder_begin() const noexcept {
+    return reverse_inorder_iterator(this, empty() ? end_index : firstInorder<true>(0));
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_inorder_iterator AVLTreeFlat<T, Storage>::reverse_inorder_end() const noexcept {
+    return reverse_inorder_iterator(this, end_index);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::level_order_iterator AVLTreeFlat<T, Storage>::level_order_begin() const noexcept {
+    return level_order_iterator(this, empty() ? end_index : 0);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::level_order_iterator AVLTreeFlat<T, Storage>::level_order_end() const noexcept {
+    return level_order_iterator(this, end_index);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_level_order_iterator AVLTreeFlat<T, Storage>::reverse_level_order_begin() const noexcept {
+    return reverse_level_order_iterator(this, empty() ? end_index : 0);
+}
+
+template <class T, class Storage>
+typename AVLTreeFlat<T, Storage>::reverse_level_order_iterator AVLTreeFlat<T, Storage>::reverse_level_order_end() const noexcept {
+    return reverse_level_order_iterator(this, end_index);
+}
 #endif
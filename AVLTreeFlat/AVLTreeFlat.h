@@ -1,55 +1,299 @@
 /*
  * Implementation of the AVLTreeFlat that ignores duplicate entries
+ *
+ * The tree is stored implicitly in level order, indexed like a binary heap.
+ * The children of the node at index i are at 2i + 1 and 2i + 2, and its parent at (i - 1) / 2,
+ * so the nodes carry no pointers. The array always holds whole levels, 2^L - 1 slots.
+ *
+ * The cost is in rotations. A node can't be relinked, so every subtree that changes position
+ * has to be moved through the array, one level at a time.
+ *
+ * Keys, heights and occupancy are stored in separate arrays (see AVLTreeFlatStorage),
+ * so searches only touch packed keys and a bitmap.
  */
 #ifndef AVLTREEFLAT_H
 #define AVLTREEFLAT_H
 
 #include <cstdint>
-#include <optional>
+#include <algorithm>
+#include <iterator>
+#include <iostream>
+#include <stdexcept>
 #include "../binaryTree.h"
+#include "AVLTreeFlatStorage.h"
 
-#ifdef BINARYTREE_SANITY_CHECK
-#include <stdexcept> // For sanity error handling
-#endif
-
-template <class T>
-struct AVLTreeFlatNode {
-    AVLTreeFlatNode() = default; // value uninitialized
-    explicit AVLTreeFlatNode(const T &value): value(value) {}
-
-    // Copy constructor
-    AVLTreeFlatNode(const AVLTreeFlatNode &node) = default;
-    std::optional<T> value;
-};
-
-template <class T, class Node = AVLTreeFlatNode<T>, class Container = std::vector<Node>>
+template <class T, class Storage = AVLTreeFlatStorage<T>>
 class AVLTreeFlat {
+  public:
     // Public reference to T for reference
     using value_type = T;
+
   protected:
+    // Index past the end of any traversal
+    static constexpr size_t end_index = SIZE_MAX;
+
+    // Comparison function
+    int (*compare)(const T &a, const T &b);
+
+    Storage tree;
+    size_t count;
+
     // Methods of traversing the tree
-    inline size_t getLeft(size_t index) const noexcept;
-    inline size_t getRight(size_t index) const noexcept;
-    inline size_t getParent(size_t index) const noexcept;
-    inline uint8_t getNodeHeight(size_t index) const noexcept;
-    inline Node& getNode(size_t index) const noexcept;
+    static inline size_t getLeft(size_t index) noexcept;
+    static inline size_t getRight(size_t index) noexcept;
+    static inline size_t getParent(size_t index) noexcept;
+    // Level of the index. The root is on level 0.
+    static inline size_t getLevel(size_t index) noexcept;
+
+    // If a node is stored at index
+    inline bool exists(size_t index) const noexcept;
+    // Height of the subtree at index, zero if there is none
+    inline uint8_t getIndexHeight(size_t index) const noexcept;
+
+    // Index of the value, or end_index if it is not in the tree
+    size_t find(const T &value) const noexcept;
 
     void updateHeight(size_t index);
+
+    /**
+     * Move the subtree at from, to the position of to.
+     *
+     * The positions covered by the subtree at to must be empty,
+     * other than those belonging to the subtree being moved.
+     * Slots left behind are emptied.
+     */
+    void moveSubtree(size_t from, size_t to);
+
+    // Single rotations. Bring the right (left) child up to index.
+    void singleLeftRotation(size_t index);
+    void singleRightRotation(size_t index);
+
+    // AVL rotations, choosing between a single and a double rotation.
     void leftRotation(size_t index);
     void rightRotation(size_t index);
     void rebalance(size_t index);
 
-    Container tree;
+    // Update heights and rebalance from index up to the root
+    void rebalancePath(size_t index);
+
+    // Remove the node at index, which must have no left or no right child
+    void unlink(size_t index);
+
+    // Shrink the array once the tree no longer reaches its bottom levels
+    void shrink();
+
+    // Traversal in each order, used by the iterators.
+    // Reverse swaps the roles of left and right.
+    template <bool Reverse> inline size_t getFirst(size_t index) const noexcept;
+    template <bool Reverse> inline size_t getSecond(size_t index) const noexcept;
+    template <bool Reverse> inline bool isFirst(size_t index) const noexcept;
+    template <bool Reverse> size_t nextPreorder(size_t index) const noexcept;
+    template <bool Reverse> size_t firstPostorder(size_t index) const noexcept;
+    template <bool Reverse> size_t nextPostorder(size_t index) const noexcept;
+    template <bool Reverse> size_t firstInorder(size_t index) const noexcept;
+    template <bool Reverse> size_t nextInorder(size_t index) const noexcept;
+    size_t nextLevelOrder(size_t index) const noexcept;
+    size_t nextReverseLevelOrder(size_t index) const noexcept;
+
+    /**
+     * Internal function only used for determining how to print
+     * the tree.
+     */
+    size_t getMaxStringWidth() const noexcept;
+
   public:
-    bool contains(const T &value) noexcept override;
-    bool insert(const T &value) noexcept override;
-    bool remove(const T &value) noexcept override;
+    explicit AVLTreeFlat(int (*compare)(const T &a, const T &b) = default_compare): compare(compare), count(0) {}
+
+    bool operator==(const AVLTreeFlat &tree) const noexcept;
+    bool operator!=(const AVLTreeFlat &tree) const noexcept;
+
+    bool contains(const T &value) const noexcept;
+    bool insert(const T &value) noexcept;
+    bool remove(const T &value) noexcept;
 
-    T popMostLeft() override;
-    T popMostRight() override;
+    T popMostLeft();
+    T popMostRight();
+
+    void clear() noexcept;
+    bool empty() const noexcept;
+
+    T getRoot() const;
+    T getMostLeft() const;
+    T getMostRight() const;
 
     // Specialized getHeight(). Implement O(1) algorithm specific to AVL trees
-    size_t getHeight() const;
+    size_t getHeight() const noexcept;
+
+    size_t size() const noexcept;
+
+    // See BinaryTree for the printing options
+    void printTree(size_t width, size_t height = 0, char fill = ' ', bool biasLeft = true,
+                   bool trailing = false, char background = ' ', std::ostream &ostream = std::cout) const noexcept;
+    void printTreeWithSpacing(size_t spacing, size_t width = 0, size_t height = 0,
+                              char fill = ' ', bool biasLeft = true, bool trailing = false,
+                              char background = ' ', std::ostream &ostream = std::cout) const noexcept;
+    void printTree(std::ostream &ostream) const noexcept;
+    void printTree() const noexcept;
+
+  protected:
+    enum class Order {
+        preorder, reverse_preorder,
+        postorder, reverse_postorder,
+        inorder, reverse_inorder,
+        level_order, reverse_level_order
+    };
+
+  public:
+    /*
+     * Iterators only need the current index.
+     * Parents are found by arithmetic, so no stack or queue of nodes is kept.
+     */
+    template <Order order>
+    class index_iterator {
+        // Allow AVLTreeFlat to use the protected constructor
+        friend class AVLTreeFlat;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        index_iterator(const index_iterator &iter) = default;
+        index_iterator& operator=(const index_iterator &iter) = default;
+
+        // Prefix ++ overload
+        index_iterator& operator++() {
+            if (index != end_index) advance();
+            return *this;
+        }
+
+        // Postfix ++ overload
+        index_iterator operator++(int) {
+            index_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const index_iterator &iter) const {
+            return index == iter.index;
+        }
+
+        bool operator!=(const index_iterator &iter) const {
+            return index != iter.index;
+        }
+
+        T operator*() const {
+            if (index == end_index)
+                throw std::out_of_range("iterator has been exhausted");
+            return tree->tree.key(index);
+        }
+
+      protected:
+        index_iterator(const AVLTreeFlat *tree, size_t index): tree(tree), index(index) {}
+
+        void advance() {
+            switch (order) {
+                case Order::preorder:            index = tree->template nextPreorder<false>(index); break;
+                case Order::reverse_preorder:    index = tree->template nextPreorder<true>(index); break;
+                case Order::postorder:           index = tree->template nextPostorder<false>(index); break;
+                case Order::reverse_postorder:   index = tree->template nextPostorder<true>(index); break;
+                case Order::inorder:             index = tree->template nextInorder<false>(index); break;
+                case Order::reverse_inorder:     index = tree->template nextInorder<true>(index); break;
+                case Order::level_order:         index = tree->nextLevelOrder(index); break;
+                case Order::reverse_level_order: index = tree->nextReverseLevelOrder(index); break;
+            }
+        }
+
+        const AVLTreeFlat *tree;
+        size_t index;
+    };
+
+    using preorder_iterator = index_iterator<Order::preorder>;
+    using reverse_preorder_iterator = index_iterator<Order::reverse_preorder>;
+    using postorder_iterator = index_iterator<Order::postorder>;
+    using reverse_postorder_iterator = index_iterator<Order::reverse_postorder>;
+    using inorder_iterator = index_iterator<Order::inorder>;
+    using reverse_inorder_iterator = index_iterator<Order::reverse_inorder>;
+    using level_order_iterator = index_iterator<Order::level_order>;
+    using reverse_level_order_iterator = index_iterator<Order::reverse_level_order>;
+
+    preorder_iterator preorder_begin() const noexcept;
+    preorder_iterator preorder_end() const noexcept;
+
+    reverse_preorder_iterator reverse_preorder_begin() const noexcept;
+    reverse_preorder_iterator reverse_preorder_end() const noexcept;
+
+    postorder_iterator postorder_begin() const noexcept;
+    postorder_iterator postorder_end() const noexcept;
+
+    reverse_postorder_iterator reverse_postorder_begin() const noexcept;
+    reverse_postorder_iterator reverse_postorder_end() const noexcept;
+
+    inorder_iterator inorder_begin() const noexcept;
+    inorder_iterator inorder_end() const noexcept;
+
+    reverse_inorder_iterator reverse_inorder_begin() const noexcept;
+    reverse_inorder_iterator reverse_inorder_end() const noexcept;
+
+    level_order_iterator level_order_begin() const noexcept;
+    level_order_iterator level_order_end() const noexcept;
+
+    reverse_level_order_iterator reverse_level_order_begin() const noexcept;
+    reverse_level_order_iterator reverse_level_order_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong
+    void sanityCheck() const {
+        // The array only ever holds whole levels
+        if ((tree.size() & (tree.size() + 1)) != 0)
+            throw std::logic_error("Array does not hold a whole number of levels");
+
+        size_t sanity_count = 0;
+        for (size_t index = 0; index < tree.size(); index++) {
+            // Empty slots keep a height of zero
+            if (!exists(index)) {
+                if (tree.height(index) != 0)
+                    throw std::logic_error("Empty slot has a height");
+                continue;
+            }
+            sanity_count++;
+
+            if (index != 0 && !exists(getParent(index)))
+                throw std::logic_error("Node has no parent");
+
+            const int left_height = getIndexHeight(getLeft(index));
+            const int right_height = getIndexHeight(getRight(index));
+
+            if (tree.height(index) != std::max(left_height, right_height) + 1)
+                throw std::logic_error("Node height does not match its children");
+            if (left_height - right_height > 1 || right_height - left_height > 1)
+                throw std::logic_error("Node is not balanced");
+
+            if (exists(getLeft(index)) && compare(tree.key(index), tree.key(getLeft(index))) <= 0)
+                throw std::logic_error("Node is less than or equal to its left value");
+            if (exists(getRight(index)) && compare(tree.key(index), tree.key(getRight(index))) >= 0)
+                throw std::logic_error("Node is greater than or equal to its right value");
+        }
+
+        if (count != sanity_count)
+            throw std::logic_error("AVLTreeFlat size does not match count of elements");
+
+        // Parent child ordering is not enough, make sure the whole order holds
+        auto it = inorder_begin();
+        if (it != inorder_end()) {
+            T last = *it;
+            for (++it; it != inorder_end(); ++it) {
+                if (compare(last, *it) >= 0)
+                    throw std::logic_error("Inorder traversal is not increasing");
+                last = *it;
+            }
+        }
+    }
+#endif
 };
 
 #include "AVLTreeFlat.cpp"
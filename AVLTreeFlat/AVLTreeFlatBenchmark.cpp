@@ -15,7 +15,6 @@
 #define TESTS Ranges({{1 << 10, 8 << 10}, {128, 512}})->Complexity()->Threads(1)->ThreadPerCpu()
 
 #include "AVLTreeFlat.h"
-//#include "AVLTreeFlatCountable.h"
 
 inline int RandomNumber() {
     return rand();
@@ -79,48 +78,4 @@ static void BM_AVLTreeFlatContains(benchmark::State &state) {
 }
 BENCHMARK(BM_AVLTreeFlatContains)->TESTS;
 
-//static void BM_AVLTreeFlatCountableInsert(benchmark::State &state) {
-//    AVLTreeFlatCountable<int> tree;
-//    for (auto _ : state) {
-//        state.PauseTiming();
-//        ConstructRandomTree(tree, state.range(0));
-//        state.ResumeTiming();
-//        for (int j = 0; j < state.range(1); j++)
-//            tree.insert(RandomNumber());
-//        benchmark::DoNotOptimize(tree);
-//        benchmark::ClobberMemory();
-//    }
-//    state.SetComplexityN(state.range(0));
-//}
-//BENCHMARK(BM_AVLTreeFlatCountableInsert)->TESTS;
-//
-//static void BM_AVLTreeFlatCountableRemove(benchmark::State &state) {
-//    AVLTreeFlatCountable<int> tree;
-//    for (auto _ : state) {
-//        state.PauseTiming();
-//        ConstructRandomTree(tree, state.range(0));
-//        state.ResumeTiming();
-//        for (int j = 0; j < state.range(1); j++)
-//            tree.remove(RandomNumber());
-//        benchmark::DoNotOptimize(tree);
-//        benchmark::ClobberMemory();
-//    }
-//    state.SetComplexityN(state.range(0));
-//}
-//BENCHMARK(BM_AVLTreeFlatCountableRemove)->TESTS;
-//
-//static void BM_AVLTreeFlatCountableContains(benchmark::State &state) {
-//    AVLTreeFlatCountable<int> tree;
-//    for (auto _ : state) {
-//        state.PauseTiming();
-//        ConstructRandomTree(tree, state.range(0));
-//        state.ResumeTiming();
-//        for (int j = 0; j < state.range(1); j++)
-//            tree.contains(RandomNumber());
-//        benchmark::DoNotOptimize(tree);
-//    }
-//    state.SetComplexityN(state.range(0));
-//}
-//BENCHMARK(BM_AVLTreeFlatCountableContains)->TESTS;
-
 BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+/*
+ * Slot storage for AVLTreeFlat, kept as a structure of arrays.
+ *
+ * Keys, heights and occupancy live in separate arrays, so a search down the tree
+ * only reads packed keys and the occupancy bitmap. Heights are only read while rebalancing.
+ *
+ * A slot is empty when its occupancy bit is clear, and its height is then zero.
+ * The key of an empty slot is left over from whatever was there before, and is never read.
+ */
+#ifndef AVLTREEFLATSTORAGE_H
+#define AVLTREEFLATSTORAGE_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+template <class T>
+class AVLTreeFlatStorage {
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+  protected:
+    static constexpr size_t word_bits = 64;
+
+    std::vector<T> keys;
+    std::vector<uint8_t> heights;
+    std::vector<uint64_t> occupancy;
+
+    static uint64_t bit(const size_t index) noexcept {
+        return uint64_t(1) << (index % word_bits);
+    }
+
+  public:
+    size_t size() const noexcept {
+        return keys.size();
+    }
+
+    void resize(const size_t size) {
+        keys.resize(size);
+        heights.resize(size, 0);
+        occupancy.resize((size + word_bits - 1) / word_bits, 0);
+
+        // Bits past the end must read as empty if the array grows again
+        if (size % word_bits != 0) occupancy.back() &= bit(size) - 1;
+    }
+
+    void clear() noexcept {
+        keys.clear();
+        heights.clear();
+        occupancy.clear();
+    }
+
+    bool occupied(const size_t index) const noexcept {
+        return (occupancy[index / word_bits] & bit(index)) != 0;
+    }
+
+    T& key(const size_t index) noexcept {
+        return keys[index];
+    }
+
+    const T& key(const size_t index) const noexcept {
+        return keys[index];
+    }
+
+    uint8_t& height(const size_t index) noexcept {
+        return heights[index];
+    }
+
+    uint8_t height(const size_t index) const noexcept {
+        return heights[index];
+    }
+
+    // Start loading the key and occupancy of index, ahead of a search reaching it
+    void prefetch(const size_t index) const noexcept {
+        __builtin_prefetch(keys.data() + index);
+        __builtin_prefetch(occupancy.data() + index / word_bits);
+    }
+
+    // Fill an empty slot with a leaf
+    void set(const size_t index, const T &value) {
+        keys[index] = value;
+        heights[index] = 1;
+        occupancy[index / word_bits] |= bit(index);
+    }
+
+    void erase(const size_t index) noexcept {
+        heights[index] = 0;
+        occupancy[index / word_bits] &= ~bit(index);
+    }
+
+    // Move one occupied slot, leaving from empty
+    void move(const size_t from, const size_t to) {
+        keys[to] = std::move(keys[from]);
+        heights[to] = heights[from];
+        occupancy[to / word_bits] |= bit(to);
+        erase(from);
+    }
+
+    /**
+     * Move width consecutive slots, empty or not, leaving the source range empty.
+     * The two ranges must not overlap.
+     */
+    void moveRange(const size_t from, const size_t to, const size_t width) {
+        std::move(keys.begin() + from, keys.begin() + from + width, keys.begin() + to);
+        std::copy(heights.begin() + from, heights.begin() + from + width, heights.begin() + to);
+        std::fill(heights.begin() + from, heights.begin() + from + width, 0);
+
+        for (size_t i = 0; i < width; i++) {
+            if (occupied(from + i)) {
+                occupancy[(to + i) / word_bits] |= bit(to + i);
+                occupancy[(from + i) / word_bits] &= ~bit(from + i);
+            } else {
+                occupancy[(to + i) / word_bits] &= ~bit(to + i);
+            }
+        }
+    }
+};
+
+#endif //AVLTREEFLATSTORAGE_H
@@ -0,0 +1,718 @@
+#ifndef ADAPTIVERADIXTREE_CPP
+#define ADAPTIVERADIXTREE_CPP
+
+#include <algorithm>
+#include <cstring>
+#include "AdaptiveRadixTree.h"
+
+#ifdef __SSE2__
+// Part of the x86-64 baseline, so no runtime check is needed
+#include <emmintrin.h>
+#endif
+
+// Taken by reference in std::min, so needs a definition before C++17
+template <class T>
+constexpr size_t AdaptiveRadixTree<T>::max_prefix;
+
+template <class T>
+void AdaptiveRadixTree<T>::deleteNode(Inner *node) noexcept {
+    switch (node->type) {
+        case NodeType::node4: delete static_cast<Node4*>(node); break;
+        case NodeType::node16: delete static_cast<Node16*>(node); break;
+        case NodeType::node48: delete static_cast<Node48*>(node); break;
+        case NodeType::node256: delete static_cast<Node256*>(node); break;
+    }
+}
+
+template <class T>
+void AdaptiveRadixTree<T>::moveHeader(Inner *to, const Inner *from) noexcept {
+    to->count = from->count;
+    to->prefix_length = from->prefix_length;
+    std::memcpy(to->prefix, from->prefix, max_prefix);
+    to->terminal = from->terminal;
+}
+
+template <class T>
+void** AdaptiveRadixTree<T>::findChild(Inner *node, const uint8_t byte) noexcept {
+    switch (node->type) {
+        case NodeType::node4: {
+            Node4 *n = static_cast<Node4*>(node);
+            for (size_t i = 0; i < n->count; i++) {
+                if (n->keys[i] == byte) return &n->children[i];
+            }
+            return nullptr;
+        }
+        case NodeType::node16: {
+            Node16 *n = static_cast<Node16*>(node);
+#ifdef __SSE2__
+            // Compare all 16 keys at once, ignoring the unused ones
+            const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys));
+            const unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte))))
+                                & ((1u << n->count) - 1);
+            return mask != 0 ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+            for (size_t i = 0; i < n->count; i++) {
+                if (n->keys[i] == byte) return &n->children[i];
+            }
+            return nullptr;
+#endif
+        }
+        case NodeType::node48: {
+            Node48 *n = static_cast<Node48*>(node);
+            return n->index[byte] != 0 ? &n->children[n->index[byte] - 1] : nullptr;
+        }
+        case NodeType::node256: {
+            Node256 *n = static_cast<Node256*>(node);
+            return n->children[byte] != nullptr ? &n->children[byte] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+uint8_t AdaptiveRadixTree<T>::childByte(const Inner *node, const int position) noexcept {
+    if (node->type == NodeType::node4) return static_cast<const Node4*>(node)->keys[position];
+    if (node->type == NodeType::node16) return static_cast<const Node16*>(node)->keys[position];
+    return static_cast<uint8_t>(position);
+}
+
+template <class T>
+void AdaptiveRadixTree<T>::addChild(void *&node, const uint8_t byte, void *child) {
+    Inner *inner = asInner(node);
+
+    // Shift larger keys up to keep the keys sorted
+    const auto insertSorted = [byte, child](uint8_t *keys, void **children, uint16_t &count) {
+        size_t i = count;
+        for (; i > 0 && keys[i - 1] > byte; i--) {
+            keys[i] = keys[i - 1];
+            children[i] = children[i - 1];
+        }
+        keys[i] = byte;
+        children[i] = child;
+        count++;
+    };
+
+    switch (inner->type) {
+        case NodeType::node4: {
+            Node4 *n = static_cast<Node4*>(inner);
+            if (n->count < 4) {
+                insertSorted(n->keys, n->children, n->count);
+                return;
+            }
+
+            Node16 *bigger = new Node16();
+            moveHeader(bigger, n);
+            std::copy(n->keys, n->keys + 4, bigger->keys);
+            std::copy(n->children, n->children + 4, bigger->children);
+            delete n;
+            node = bigger;
+            insertSorted(bigger->keys, bigger->children, bigger->count);
+            return;
+        }
+        case NodeType::node16: {
+            Node16 *n = static_cast<Node16*>(inner);
+            if (n->count < 16) {
+                insertSorted(n->keys, n->children, n->count);
+                return;
+            }
+
+            Node48 *bigger = new Node48();
+            moveHeader(bigger, n);
+            for (uint8_t i = 0; i < 16; i++) {
+                bigger->children[i] = n->children[i];
+                bigger->index[n->keys[i]] = i + 1;
+            }
+            delete n;
+            node = bigger;
+            bigger->children[16] = child;
+            bigger->index[byte] = 17;
+            bigger->count++;
+            return;
+        }
+        case NodeType::node48: {
+            Node48 *n = static_cast<Node48*>(inner);
+            if (n->count < 48) {
+                // Removes leave holes, so take the first free slot
+                uint8_t slot = 0;
+                while (n->children[slot] != nullptr) slot++;
+                n->children[slot] = child;
+                n->index[byte] = slot + 1;
+                n->count++;
+                return;
+            }
+
+            Node256 *bigger = new Node256();
+            moveHeader(bigger, n);
+            for (size_t b = 0; b < 256; b++) {
+                if (n->index[b] != 0) bigger->children[b] = n->children[n->index[b] - 1];
+            }
+            delete n;
+            node = bigger;
+            bigger->children[byte] = child;
+            bigger->count++;
+            return;
+        }
+        case NodeType::node256: {
+            Node256 *n = static_cast<Node256*>(inner);
+            n->children[byte] = child;
+            n->count++;
+            return;
+        }
+    }
+}
+
+template <class T>
+void AdaptiveRadixTree<T>::removeChild(void *&node, const uint8_t byte) {
+    Inner *inner = asInner(node);
+
+    const auto eraseSorted = [byte](uint8_t *keys, void **children, uint16_t &count) {
+        size_t i = 0;
+        while (keys[i] != byte) i++;
+        for (count--; i < count; i++) {
+            keys[i] = keys[i + 1];
+            children[i] = children[i + 1];
+        }
+    };
+
+    /*
+     * Each type shrinks a few children below where the smaller type would have grown,
+     * so a node on the boundary does not change type on every insert and remove.
+     */
+    switch (inner->type) {
+        case NodeType::node4: {
+            Node4 *n = static_cast<Node4*>(inner);
+            eraseSorted(n->keys, n->children, n->count);
+            return;
+        }
+        case NodeType::node16: {
+            Node16 *n = static_cast<Node16*>(inner);
+            eraseSorted(n->keys, n->children, n->count);
+            if (n->count > 3) return;
+
+            Node4 *smaller = new Node4();
+            moveHeader(smaller, n);
+            std::copy(n->keys, n->keys + n->count, smaller->keys);
+            std::copy(n->children, n->children + n->count, smaller->children);
+            delete n;
+            node = smaller;
+            return;
+        }
+        case NodeType::node48: {
+            Node48 *n = static_cast<Node48*>(inner);
+            n->children[n->index[byte] - 1] = nullptr;
+            n->index[byte] = 0;
+            n->count--;
+            if (n->count > 12) return;
+
+            Node16 *smaller = new Node16();
+            moveHeader(smaller, n);
+            size_t i = 0;
+            for (size_t b = 0; b < 256; b++) {
+                if (n->index[b] == 0) continue;
+                smaller->keys[i] = static_cast<uint8_t>(b);
+                smaller->children[i++] = n->children[n->index[b] - 1];
+            }
+            delete n;
+            node = smaller;
+            return;
+        }
+        case NodeType::node256: {
+            Node256 *n = static_cast<Node256*>(inner);
+            n->children[byte] = nullptr;
+            n->count--;
+            if (n->count > 40) return;
+
+            Node48 *smaller = new Node48();
+            moveHeader(smaller, n);
+            uint8_t slot = 0;
+            for (size_t b = 0; b < 256; b++) {
+                if (n->children[b] == nullptr) continue;
+                smaller->children[slot] = n->children[b];
+                smaller->index[b] = ++slot;
+            }
+            delete n;
+            node = smaller;
+            return;
+        }
+    }
+}
+
+template <class T>
+const void* AdaptiveRadixTree<T>::nextChild(const Inner *node, int &position) noexcept {
+    switch (node->type) {
+        case NodeType::node4:
+        case NodeType::node16: {
+            const int next = position + 1;
+            if (next >= node->count) return nullptr;
+            position = next;
+            return node->type == NodeType::node4 ? static_cast<const Node4*>(node)->children[next]
+                                                 : static_cast<const Node16*>(node)->children[next];
+        }
+        case NodeType::node48: {
+            const Node48 *n = static_cast<const Node48*>(node);
+            for (int b = position + 1; b < 256; b++) {
+                if (n->index[b] == 0) continue;
+                position = b;
+                return n->children[n->index[b] - 1];
+            }
+            return nullptr;
+        }
+        case NodeType::node256: {
+            const Node256 *n = static_cast<const Node256*>(node);
+            for (int b = position + 1; b < 256; b++) {
+                if (n->children[b] == nullptr) continue;
+                position = b;
+                return n->children[b];
+            }
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+const void* AdaptiveRadixTree<T>::prevChild(const Inner *node, int &position) noexcept {
+    switch (node->type) {
+        case NodeType::node4:
+        case NodeType::node16: {
+            const int prev = std::min<int>(position, node->count) - 1;
+            if (prev < 0) return nullptr;
+            position = prev;
+            return node->type == NodeType::node4 ? static_cast<const Node4*>(node)->children[prev]
+                                                 : static_cast<const Node16*>(node)->children[prev];
+        }
+        case NodeType::node48: {
+            const Node48 *n = static_cast<const Node48*>(node);
+            for (int b = std::min(position, 256) - 1; b >= 0; b--) {
+                if (n->index[b] == 0) continue;
+                position = b;
+                return n->children[n->index[b] - 1];
+            }
+            return nullptr;
+        }
+        case NodeType::node256: {
+            const Node256 *n = static_cast<const Node256*>(node);
+            for (int b = std::min(position, 256) - 1; b >= 0; b--) {
+                if (n->children[b] == nullptr) continue;
+                position = b;
+                return n->children[b];
+            }
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+const typename AdaptiveRadixTree<T>::Leaf* AdaptiveRadixTree<T>::minimumLeaf(const void *child) noexcept {
+    while (!isLeaf(child)) {
+        const Inner *node = asInner(child);
+        // A key ending here is less than any key that carries on
+        if (node->terminal != nullptr) return node->terminal;
+        int position = -1;
+        child = nextChild(node, position);
+    }
+    return asLeaf(child);
+}
+
+template <class T>
+const typename AdaptiveRadixTree<T>::Leaf* AdaptiveRadixTree<T>::maximumLeaf(const void *child) noexcept {
+    while (!isLeaf(child)) {
+        const Inner *node = asInner(child);
+        int position = 256;
+        const void *last = prevChild(node, position);
+        if (last == nullptr) return node->terminal;
+        child = last;
+    }
+    return asLeaf(child);
+}
+
+template <class T>
+size_t AdaptiveRadixTree<T>::prefixMatch(const Inner *node, const T &key, const size_t depth) noexcept {
+    const size_t limit = std::min<size_t>(node->prefix_length, key.size() - depth);
+    const size_t stored = std::min<size_t>(limit, max_prefix);
+
+    size_t i = 0;
+    for (; i < stored; i++) {
+        if (node->prefix[i] != byteAt(key, depth + i)) return i;
+    }
+
+    // The rest of a long prefix is only held by the leaves
+    if (i < limit) {
+        const Leaf *leaf = minimumLeaf(node);
+        for (; i < limit; i++) {
+            if (leaf->key[depth + i] != key[depth + i]) return i;
+        }
+    }
+    return i;
+}
+
+template <class T>
+bool AdaptiveRadixTree<T>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the tree.
+     *
+     * Only the stored prefix bytes are checked on the way down, the leaf is compared in full.
+     */
+    const void *node = root;
+    size_t depth = 0;
+    while (node != nullptr) {
+        if (isLeaf(node)) return asLeaf(node)->key == value;
+
+        const Inner *inner = asInner(node);
+        if (value.size() - depth < inner->prefix_length) return false;
+
+        const size_t stored = std::min<size_t>(inner->prefix_length, max_prefix);
+        for (size_t i = 0; i < stored; i++) {
+            if (inner->prefix[i] != byteAt(value, depth + i)) return false;
+        }
+        depth += inner->prefix_length;
+
+        if (depth == value.size()) return inner->terminal != nullptr && inner->terminal->key == value;
+
+        void **slot = findChild(const_cast<Inner*>(inner), byteAt(value, depth));
+        if (slot == nullptr) return false;
+        node = *slot;
+        depth++;
+    }
+    return false;
+}
+
+template <class T>
+void AdaptiveRadixTree<T>::placeLeaf(void *&node, Leaf *leaf, const size_t depth) {
+    if (leaf->key.size() == depth) {
+        asInner(node)->terminal = leaf;
+    } else {
+        addChild(node, byteAt(leaf->key, depth), tagLeaf(leaf));
+    }
+}
+
+template <class T>
+bool AdaptiveRadixTree<T>::insert(const T &value) noexcept {
+    bool result = insertInternal(root, value, 0);
+    if (result) count++;
+    return result;
+}
+
+/**
+ * An internal insert command that inserts a new value recursively.
+ * node is reached through the first depth bytes of value.
+ *
+ * Returns true if the value is inserted.
+ * Returns false if the value is found in the tree, and the tree is not modified.
+ */
+template <class T>
+bool AdaptiveRadixTree<T>::insertInternal(void *&node, const T &value, size_t depth) {
+    // Handle if node does not exist
+    if (node == nullptr) {
+        node = tagLeaf(new Leaf(value));
+        return true;
+    }
+
+    if (isLeaf(node)) {
+        Leaf *leaf = asLeaf(node);
+        if (leaf->key == value) return false;
+
+        // Replace the leaf with a node holding both keys, under the bytes they share
+        const size_t limit = std::min(leaf->key.size(), value.size());
+        size_t common = 0;
+        while (depth + common < limit && leaf->key[depth + common] == value[depth + common]) common++;
+
+        Node4 *parent = new Node4();
+        parent->prefix_length = common;
+        for (size_t i = 0; i < std::min(common, max_prefix); i++) {
+            parent->prefix[i] = byteAt(value, depth + i);
+        }
+
+        node = parent;
+        placeLeaf(node, leaf, depth + common);
+        placeLeaf(node, new Leaf(value), depth + common);
+        return true;
+    }
+
+    Inner *inner = asInner(node);
+    const size_t match = prefixMatch(inner, value, depth);
+
+    if (match < inner->prefix_length) {
+        // value leaves the prefix part way, so split the prefix with a new node above
+        Node4 *parent = new Node4();
+        parent->prefix_length = match;
+        for (size_t i = 0; i < std::min(match, max_prefix); i++) {
+            parent->prefix[i] = byteAt(value, depth + i);
+        }
+
+        // The old node goes under the byte where they differ, keeping the prefix after it
+        uint8_t byte;
+        if (inner->prefix_length <= max_prefix) {
+            byte = inner->prefix[match];
+            inner->prefix_length -= match + 1;
+            std::memmove(inner->prefix, inner->prefix + match + 1, inner->prefix_length);
+        } else {
+            const Leaf *leaf = minimumLeaf(inner);
+            byte = byteAt(leaf->key, depth + match);
+            inner->prefix_length -= match + 1;
+            for (size_t i = 0; i < std::min<size_t>(inner->prefix_length, max_prefix); i++) {
+                inner->prefix[i] = byteAt(leaf->key, depth + match + 1 + i);
+            }
+        }
+
+        void *split = parent;
+        addChild(split, byte, inner);
+        placeLeaf(split, new Leaf(value), depth + match);
+        node = split;
+        return true;
+    }
+
+    depth += inner->prefix_length;
+    if (depth == value.size()) {
+        // Every byte on the way matched, so a terminal here is value
+        if (inner->terminal != nullptr) return false;
+        inner->terminal = new Leaf(value);
+        return true;
+    }
+
+    const uint8_t byte = byteAt(value, depth);
+    void **slot = findChild(inner, byte);
+    if (slot != nullptr) return insertInternal(*slot, value, depth + 1);
+
+    addChild(node, byte, tagLeaf(new Leaf(value)));
+    return true;
+}
+
+template <class T>
+bool AdaptiveRadixTree<T>::remove(const T &value) noexcept {
+    bool result = removeInternal(root, value, 0);
+    if (result) count--;
+    return result;
+}
+
+template <class T>
+bool AdaptiveRadixTree<T>::removeInternal(void *&node, const T &value, size_t depth) {
+    // If node is nullptr, then failed to find value.
+    if (node == nullptr) return false;
+
+    if (isLeaf(node)) {
+        Leaf *leaf = asLeaf(node);
+        if (leaf->key != value) return false;
+        delete leaf;
+        node = nullptr;
+        return true;
+    }
+
+    // As in contains, the stored prefix is enough on the way down
+    Inner *inner = asInner(node);
+    if (value.size() - depth < inner->prefix_length) return false;
+
+    const size_t stored = std::min<size_t>(inner->prefix_length, max_prefix);
+    for (size_t i = 0; i < stored; i++) {
+        if (inner->prefix[i] != byteAt(value, depth + i)) return false;
+    }
+    depth += inner->prefix_length;
+
+    if (depth == value.size()) {
+        if (inner->terminal == nullptr || inner->terminal->key != value) return false;
+        delete inner->terminal;
+        inner->terminal = nullptr;
+    } else {
+        const uint8_t byte = byteAt(value, depth);
+        void **slot = findChild(inner, byte);
+        if (slot == nullptr || !removeInternal(*slot, value, depth + 1)) return false;
+        if (*slot == nullptr) removeChild(node, byte);
+    }
+
+    collapse(node);
+    return true;
+}
+
+template <class T>
+void AdaptiveRadixTree<T>::collapse(void *&node) {
+    Inner *inner = asInner(node);
+    if (inner->count + (inner->terminal != nullptr) > 1) return;
+
+    if (inner->count == 0) {
+        // Only the terminal is left, and leaves hold their whole key
+        node = tagLeaf(inner->terminal);
+        deleteNode(inner);
+        return;
+    }
+
+    int position = -1;
+    void *child = const_cast<void*>(nextChild(inner, position));
+
+    if (!isLeaf(child)) {
+        // Take this prefix and the byte to the child onto the front of the child's prefix
+        Inner *below = asInner(child);
+        uint8_t prefix[max_prefix];
+        size_t length = std::min<size_t>(inner->prefix_length, max_prefix);
+        std::memcpy(prefix, inner->prefix, length);
+        if (length < max_prefix) prefix[length++] = childByte(inner, position);
+
+        const size_t rest = std::min<size_t>(below->prefix_length, max_prefix - length);
+        std::memcpy(prefix + length, below->prefix, rest);
+        std::memcpy(below->prefix, prefix, length + rest);
+        below->prefix_length += inner->prefix_length + 1;
+    }
+
+    node = child;
+    deleteNode(inner);
+}
+
+template <class T>
+T AdaptiveRadixTree<T>::popMostLeft() {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+
+    T value = minimumLeaf(root)->key;
+    remove(value);
+    return value;
+}
+
+template <class T>
+T AdaptiveRadixTree<T>::popMostRight() {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+
+    T value = maximumLeaf(root)->key;
+    remove(value);
+    return value;
+}
+
+template <class T>
+T AdaptiveRadixTree<T>::getMostLeft() const {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+    return minimumLeaf(root)->key;
+}
+
+template <class T>
+T AdaptiveRadixTree<T>::getMostRight() const {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+    return maximumLeaf(root)->key;
+}
+
+template <class T>
+void AdaptiveRadixTree<T>::clearInternal(void *node) noexcept {
+    if (node == nullptr) return;
+    if (isLeaf(node)) {
+        delete asLeaf(node);
+        return;
+    }
+
+    Inner *inner = asInner(node);
+    int position = -1;
+    for (const void *child = nextChild(inner, position); child != nullptr; child = nextChild(inner, position)) {
+        clearInternal(const_cast<void*>(child));
+    }
+    delete inner->terminal;
+    deleteNode(inner);
+}
+
+template <class T>
+void* AdaptiveRadixTree<T>::copyInternal(const void *node) {
+    if (node == nullptr) return nullptr;
+    if (isLeaf(node)) return tagLeaf(new Leaf(*asLeaf(node)));
+
+    const Inner *inner = asInner(node);
+    Inner *copy = nullptr;
+    void **children = nullptr;
+    size_t slots = 0;
+
+    // Copy the node as is, then replace every child with a copy
+    switch (inner->type) {
+        case NodeType::node4: {
+            Node4 *n = new Node4(*static_cast<const Node4*>(inner));
+            copy = n, children = n->children, slots = n->count;
+            break;
+        }
+        case NodeType::node16: {
+            Node16 *n = new Node16(*static_cast<const Node16*>(inner));
+            copy = n, children = n->children, slots = n->count;
+            break;
+        }
+        case NodeType::node48: {
+            Node48 *n = new Node48(*static_cast<const Node48*>(inner));
+            copy = n, children = n->children, slots = 48;
+            break;
+        }
+        case NodeType::node256: {
+            Node256 *n = new Node256(*static_cast<const Node256*>(inner));
+            copy = n, children = n->children, slots = 256;
+            break;
+        }
+    }
+
+    if (copy->terminal != nullptr) copy->terminal = new Leaf(*copy->terminal);
+    for (size_t i = 0; i < slots; i++) {
+        children[i] = copyInternal(children[i]);
+    }
+    return copy;
+}
+
+template <class T>
+AdaptiveRadixTree<T>::AdaptiveRadixTree(const AdaptiveRadixTree &tree): root(copyInternal(tree.root)), count(tree.count) {}
+
+template <class T>
+AdaptiveRadixTree<T>& AdaptiveRadixTree<T>::operator=(const AdaptiveRadixTree &tree) {
+    if (this == &tree) return *this;
+
+    clear();
+    root = copyInternal(tree.root);
+    count = tree.count;
+    return *this;
+}
+
+template <class T>
+AdaptiveRadixTree<T>::~AdaptiveRadixTree() {
+    clearInternal(root);
+}
+
+template <class T>
+bool AdaptiveRadixTree<T>::operator==(const AdaptiveRadixTree &tree) const noexcept {
+    if (count != tree.count) return false;
+
+    // Shapes depend only on the keys, but walking the leaves is simpler than comparing nodes
+    for (auto a = inorder_begin(), b = tree.inorder_begin(); a != inorder_end(); ++a, ++b) {
+        if (a.leaf->key != b.leaf->key) return false;
+    }
+    return true;
+}
+
+template <class T>
+bool AdaptiveRadixTree<T>::operator!=(const AdaptiveRadixTree &tree) const noexcept {
+    return !operator==(tree);
+}
+
+template <class T>
+void AdaptiveRadixTree<T>::clear() noexcept {
+    clearInternal(root);
+    root = nullptr;
+    count = 0;
+}
+
+template <class T>
+bool AdaptiveRadixTree<T>::empty() const noexcept {
+    return root == nullptr;
+}
+
+template <class T>
+size_t AdaptiveRadixTree<T>::size() const noexcept {
+    return count;
+}
+
+template <class T>
+typename AdaptiveRadixTree<T>::inorder_iterator AdaptiveRadixTree<T>::inorder_begin() const noexcept {
+    return inorder_iterator(root);
+}
+
+template <class T>
+typename AdaptiveRadixTree<T>::inorder_iterator AdaptiveRadixTree<T>::inorder_end() const noexcept {
+    return inorder_iterator(nullptr);
+}
+
+template <class T>
+typename AdaptiveRadixTree<T>::reverse_inorder_iterator AdaptiveRadixTree<T>::reverse_inorder_begin() const noexcept {
+    return reverse_inorder_iterator(root);
+}
+
+template <class T>
+typename AdaptiveRadixTree<T>::reverse_inorder_iterator AdaptiveRadixTree<T>::reverse_inorder_end() const noexcept {
+    return reverse_inorder_iterator(nullptr);
+}
+#endif //ADAPTIVERADIXTREE_CPP
@@ -0,0 +1,362 @@
+/*
+ * Implementation of an adaptive radix tree (ART) over string keys, that ignores duplicate entries
+ *
+ * Keys are split into bytes, and each inner node branches on one byte, so a lookup
+ * never compares whole strings until it reaches the single leaf that might match.
+ * Inner nodes come in four sizes, holding up to 4, 16, 48 or 256 children, and grow or shrink as needed.
+ * Bytes shared by everything under a node are kept once as its prefix, so chains of single children never form.
+ *
+ * Leis, Kemper and Neumann, "The Adaptive Radix Tree: ARTful Indexing for Main-Memory Databases" (2013).
+ *
+ * Keys are ordered byte by byte as unsigned chars, then by length, which is the order of std::string::compare.
+ * A key that is a prefix of others is held by the node where it ends, as its terminal, so keys may hold any byte.
+ * The interface matches BinaryTree where it makes sense, but there is no compare function, and no binary shape.
+ */
+#ifndef ADAPTIVERADIXTREE_H
+#define ADAPTIVERADIXTREE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+template <class T = std::string>
+class AdaptiveRadixTree {
+    static_assert(sizeof(typename T::value_type) == 1, "AdaptiveRadixTree keys must be strings of bytes");
+
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Prefix bytes stored in a node. Longer prefixes are checked against a leaf under the node.
+    static constexpr size_t max_prefix = 8;
+
+  protected:
+    struct Leaf {
+        explicit Leaf(const T &key): key(key) {}
+        T key;
+    };
+
+    enum class NodeType: uint8_t { node4, node16, node48, node256 };
+
+    struct Inner {
+        explicit Inner(NodeType type): type(type), count(0), prefix_length(0), prefix(), terminal(nullptr) {}
+
+        NodeType type;
+        // Number of children, not counting the terminal
+        uint16_t count;
+        // Bytes under this node all share, following the byte that led here
+        uint32_t prefix_length;
+        uint8_t prefix[max_prefix];
+        // Leaf for the key that ends right after the prefix, if any
+        Leaf *terminal;
+    };
+
+    /*
+     * Children are tagged pointers, either an Inner or a Leaf with the lowest bit set.
+     * Node4 and Node16 keep their bytes sorted. Node48 maps each byte to a slot, plus one, or zero if none.
+     */
+    struct Node4: Inner {
+        Node4(): Inner(NodeType::node4), keys(), children() {}
+        uint8_t keys[4];
+        void *children[4];
+    };
+
+    struct Node16: Inner {
+        Node16(): Inner(NodeType::node16), keys(), children() {}
+        uint8_t keys[16];
+        void *children[16];
+    };
+
+    struct Node48: Inner {
+        Node48(): Inner(NodeType::node48), index(), children() {}
+        uint8_t index[256];
+        void *children[48];
+    };
+
+    struct Node256: Inner {
+        Node256(): Inner(NodeType::node256), children() {}
+        void *children[256];
+    };
+
+    static bool isLeaf(const void *child) noexcept {return reinterpret_cast<uintptr_t>(child) & 1;}
+    static Leaf* asLeaf(const void *child) noexcept {
+        return reinterpret_cast<Leaf*>(reinterpret_cast<uintptr_t>(child) & ~uintptr_t(1));
+    }
+    static Inner* asInner(const void *child) noexcept {return static_cast<Inner*>(const_cast<void*>(child));}
+    static void* tagLeaf(Leaf *leaf) noexcept {return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(leaf) | 1);}
+
+    static uint8_t byteAt(const T &key, size_t depth) noexcept {return static_cast<uint8_t>(key[depth]);}
+
+    void *root;
+    size_t count;
+
+    static void deleteNode(Inner *node) noexcept;
+    // Move the count, prefix and terminal of from onto to, when changing node type
+    static void moveHeader(Inner *to, const Inner *from) noexcept;
+
+    // Slot holding the child for byte, or nullptr if there is none
+    static void** findChild(Inner *node, uint8_t byte) noexcept;
+    // Byte of the child at position, see nextChild
+    static uint8_t childByte(const Inner *node, int position) noexcept;
+    // Add child under byte, which must not be present. Grows node into a larger type if full.
+    static void addChild(void *&node, uint8_t byte, void *child);
+    // Remove the child under byte, which must be present. Shrinks node into a smaller type if sparse.
+    static void removeChild(void *&node, uint8_t byte);
+
+    /**
+     * Children in key order. position is where to continue from, and is updated to the child returned.
+     * Positions are slots for Node4 and Node16, and bytes for Node48 and Node256.
+     * Start nextChild from -1, and prevChild from 256. Returns nullptr once there are no more.
+     */
+    static const void* nextChild(const Inner *node, int &position) noexcept;
+    static const void* prevChild(const Inner *node, int &position) noexcept;
+
+    // Most left and most right leaves under child
+    static const Leaf* minimumLeaf(const void *child) noexcept;
+    static const Leaf* maximumLeaf(const void *child) noexcept;
+
+    // Number of prefix bytes of node, starting at depth, that key matches
+    static size_t prefixMatch(const Inner *node, const T &key, size_t depth) noexcept;
+
+    // Put leaf under node, whose prefix ends at depth, as its terminal if leaf ends there too
+    static void placeLeaf(void *&node, Leaf *leaf, size_t depth);
+
+    bool insertInternal(void *&node, const T &value, size_t depth);
+    bool removeInternal(void *&node, const T &value, size_t depth);
+    // Replace node with its only child or terminal, if it has nothing else
+    static void collapse(void *&node);
+
+    static void clearInternal(void *node) noexcept;
+    static void* copyInternal(const void *node);
+
+  public:
+    AdaptiveRadixTree(): root(nullptr), count(0) {}
+
+    // Copy constructor
+    AdaptiveRadixTree(const AdaptiveRadixTree &tree);
+
+    // Assignment constructor
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree &tree);
+
+    ~AdaptiveRadixTree();
+
+    bool operator==(const AdaptiveRadixTree &tree) const noexcept;
+    bool operator!=(const AdaptiveRadixTree &tree) const noexcept;
+
+    bool contains(const T &value) const noexcept;
+    bool insert(const T &value) noexcept;
+    bool remove(const T &value) noexcept;
+
+    T popMostLeft();
+    T popMostRight();
+
+    void clear() noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    T getMostLeft() const;
+    T getMostRight() const;
+
+    /*
+     * Iterators keep the path from the root, so they need no pointers back up the tree.
+     */
+    template <bool Reverse>
+    class leaf_iterator {
+        // Allow AdaptiveRadixTree to use the protected constructor
+        friend class AdaptiveRadixTree;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        leaf_iterator(const leaf_iterator &iter) = default;
+        leaf_iterator& operator=(const leaf_iterator &iter) = default;
+
+        // Prefix ++ overload
+        leaf_iterator& operator++() {
+            leaf = nullptr;
+            while (!path.empty()) {
+                Frame &frame = path.back();
+                const void *child = Reverse ? prevChild(frame.node, frame.position)
+                                            : nextChild(frame.node, frame.position);
+                if (child != nullptr) {
+                    descend(child);
+                    return *this;
+                }
+
+                // In reverse, the terminal comes after the children
+                if (Reverse && frame.node->terminal != nullptr && frame.position != terminal_position) {
+                    frame.position = terminal_position;
+                    leaf = frame.node->terminal;
+                    return *this;
+                }
+                path.pop_back();
+            }
+            return *this;
+        }
+
+        // Postfix ++ overload
+        leaf_iterator operator++(int) {
+            leaf_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const leaf_iterator &iter) const {
+            return leaf == iter.leaf;
+        }
+
+        bool operator!=(const leaf_iterator &iter) const {
+            return !operator==(iter);
+        }
+
+        T operator*() const {
+            if (leaf == nullptr)
+                throw std::out_of_range("iterator has been exhausted");
+            return leaf->key;
+        }
+
+      protected:
+        struct Frame {
+            const Inner *node;
+            int position;
+        };
+        // Position of a node whose terminal has been visited, after its children in reverse
+        static constexpr int terminal_position = -2;
+
+        explicit leaf_iterator(const void *root): leaf(nullptr) {
+            if (root != nullptr) descend(root);
+        }
+
+        // Walk down to the first leaf of child in iteration order
+        void descend(const void *child) {
+            while (!isLeaf(child)) {
+                const Inner *node = asInner(child);
+                path.push_back({node, Reverse ? 256 : -1});
+
+                // Forward, the terminal comes before the children
+                if (!Reverse && node->terminal != nullptr) {
+                    leaf = node->terminal;
+                    return;
+                }
+
+                Frame &frame = path.back();
+                child = Reverse ? prevChild(node, frame.position) : nextChild(node, frame.position);
+            }
+            leaf = asLeaf(child);
+        }
+
+        std::vector<Frame> path;
+        const Leaf *leaf;
+    };
+
+    using inorder_iterator = leaf_iterator<false>;
+    using reverse_inorder_iterator = leaf_iterator<true>;
+
+    inorder_iterator inorder_begin() const noexcept;
+    inorder_iterator inorder_end() const noexcept;
+
+    reverse_inorder_iterator reverse_inorder_begin() const noexcept;
+    reverse_inorder_iterator reverse_inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong
+    void sanityCheck() const {
+        size_t sanity_count = 0;
+        if (root != nullptr) {
+            T path;
+            sanityCheckInternal(root, path, sanity_count);
+        }
+
+        if (count != sanity_count)
+            throw std::logic_error("AdaptiveRadixTree size does not match count of elements");
+
+        // Iterators must visit every key in increasing order
+        T previous;
+        size_t visited = 0;
+        for (auto it = inorder_begin(); it != inorder_end(); ++it, visited++) {
+            T value = *it;
+            if (visited > 0 && !(previous < value))
+                throw std::logic_error("Keys are not in increasing order");
+            previous = value;
+        }
+        if (visited != count)
+            throw std::logic_error("Iterator does not visit every key");
+
+        size_t reverse_visited = 0;
+        for (auto it = reverse_inorder_begin(); it != reverse_inorder_end(); ++it) reverse_visited++;
+        if (reverse_visited != count)
+            throw std::logic_error("Reverse iterator does not visit every key");
+    }
+
+  protected:
+    // path holds the bytes leading to child
+    void sanityCheckInternal(const void *child, T &path, size_t &sanity_count) const {
+        if (isLeaf(child)) {
+            const Leaf *leaf = asLeaf(child);
+            if (leaf->key.size() < path.size() || leaf->key.compare(0, path.size(), path) != 0)
+                throw std::logic_error("Leaf does not match the path to it");
+            sanity_count++;
+            return;
+        }
+
+        const Inner *node = asInner(child);
+        const size_t depth = path.size();
+
+        // Check the prefix against a leaf, and take its bytes onto the path
+        const Leaf *leaf = minimumLeaf(child);
+        if (leaf->key.size() < depth + node->prefix_length)
+            throw std::logic_error("Leaf is shorter than the prefix above it");
+        for (size_t i = 0; i < node->prefix_length && i < max_prefix; i++) {
+            if (node->prefix[i] != byteAt(leaf->key, depth + i))
+                throw std::logic_error("Prefix does not match the leaves under it");
+        }
+        path.append(leaf->key, depth, node->prefix_length);
+
+        if (node->terminal != nullptr) {
+            if (node->terminal->key != path)
+                throw std::logic_error("Terminal does not end at its node");
+            sanity_count++;
+        }
+
+        size_t children = 0;
+        int position = -1, last_byte = -1;
+        for (const void *next = nextChild(node, position); next != nullptr; next = nextChild(node, position)) {
+            const int byte = childByte(node, position);
+            if (byte <= last_byte)
+                throw std::logic_error("Children are not in increasing order");
+            last_byte = byte;
+
+            path.push_back(static_cast<typename T::value_type>(byte));
+            sanityCheckInternal(next, path, sanity_count);
+            path.pop_back();
+            children++;
+        }
+
+        if (children != node->count)
+            throw std::logic_error("Node count does not match its children");
+        if (children + (node->terminal != nullptr) < 2)
+            throw std::logic_error("Node should have been collapsed");
+
+        size_t capacity = 256;
+        if (node->type == NodeType::node4) capacity = 4;
+        if (node->type == NodeType::node16) capacity = 16;
+        if (node->type == NodeType::node48) capacity = 48;
+        if (children > capacity)
+            throw std::logic_error("Node holds more children than its type");
+
+        path.resize(depth);
+    }
+  public:
+#endif
+};
+
+#include "AdaptiveRadixTree.cpp"
+#endif //ADAPTIVERADIXTREE_H
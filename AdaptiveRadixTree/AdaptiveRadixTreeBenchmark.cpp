@@ -0,0 +1,91 @@
+/*
+ * Performance Benchmark for AdaptiveRadixTree against the comparison trees, over string keys
+ *
+ * g++ AdaptiveRadixTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o AdaptiveRadixTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#define TESTS RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Complexity()
+
+#include "AdaptiveRadixTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../SplayTree/splayTree.h"
+
+// Keys shaped like paths, so they share starts the way real string keys tend to
+inline std::string RandomString() {
+    static const char *parts[] = {"user/", "data/", "cache/", "log/", "tmp/", "home/", "var/", "etc/"};
+    std::string key = parts[rand() % 8];
+    key += parts[rand() % 8];
+    key += std::to_string(rand());
+    return key;
+}
+
+template <class Tree>
+inline void ConstructRandomTree(Tree &tree, size_t size) {
+    while (tree.size() < size)
+        tree.insert(RandomString());
+}
+
+// Generating the keys costs more than the lookups, so draw them from a fixed pool
+inline const std::vector<std::string>& KeyPool() {
+    static std::vector<std::string> pool;
+    if (pool.empty()) {
+        for (size_t i = 0; i < (1 << 16); i++) pool.push_back(RandomString());
+    }
+    return pool;
+}
+
+template <class Tree>
+static void BM_Contains(benchmark::State &state) {
+    Tree tree;
+    ConstructRandomTree(tree, state.range(0));
+    const std::vector<std::string> &pool = KeyPool();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.contains(pool[i++ % pool.size()]));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Contains, AVLTree<std::string>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Contains, SplayTree<std::string>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Contains, AdaptiveRadixTree<std::string>)->TESTS;
+
+template <class Tree>
+static void BM_Churn(benchmark::State &state) {
+    Tree tree;
+    ConstructRandomTree(tree, state.range(0));
+    const std::vector<std::string> &pool = KeyPool();
+    size_t i = 0;
+    for (auto _ : state) {
+        tree.insert(pool[i++ % pool.size()]);
+        tree.remove(pool[i++ % pool.size()]);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Churn, AVLTree<std::string>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, SplayTree<std::string>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, AdaptiveRadixTree<std::string>)->TESTS;
+
+template <class Tree>
+static void BM_PopMostLeft(benchmark::State &state) {
+    Tree tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        // Put back a key, so the tree stays the same size
+        tree.insert(tree.popMostLeft());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_PopMostLeft, AVLTree<std::string>)->TESTS;
+BENCHMARK_TEMPLATE(BM_PopMostLeft, AdaptiveRadixTree<std::string>)->TESTS;
+
+BENCHMARK_MAIN();
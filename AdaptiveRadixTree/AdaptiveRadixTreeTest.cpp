@@ -0,0 +1,141 @@
+/*
+ * Test cases for testing the sanity of the AdaptiveRadixTree
+ */
+
+#include <set>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "AdaptiveRadixTree.h"
+
+using namespace std;
+
+// A random key from alphabet, sharing a long start with other keys if shared is set
+string randomKey(const string &alphabet, size_t max_length, bool shared) {
+    string key = shared ? "a shared start, longer than a node prefix " : "";
+    const size_t length = rand() % (max_length + 1);
+    for (size_t i = 0; i < length; i++) key += alphabet[rand() % alphabet.size()];
+    return key;
+}
+
+int main() {
+    cout << "AdaptiveRadixTree Tests" << endl;
+
+    bool passed = true;
+    {
+        AdaptiveRadixTree<string> tree;
+        passed &= tree.empty() && tree.size() == 0;
+        passed &= tree.inorder_begin() == tree.inorder_end();
+        passed &= tree.reverse_inorder_begin() == tree.reverse_inorder_end();
+        passed &= !tree.contains("") && !tree.remove("");
+
+        try {
+            tree.popMostLeft();
+            passed = false;
+        } catch (std::out_of_range &) {}
+        try {
+            tree.getMostRight();
+            passed = false;
+        } catch (std::out_of_range &) {}
+        tree.sanityCheck();
+    }
+    cout << "Empty Check                : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        AdaptiveRadixTree<string> tree;
+        for (string s : {"tree", "trie", "try", "t", "", "treetop", "art", "tr"}) passed &= tree.insert(s);
+        passed &= !tree.insert("trie") && !tree.insert("");
+        passed &= tree.size() == 8;
+        passed &= tree.contains("t") && tree.contains("") && tree.contains("treetop");
+        passed &= !tree.contains("tre") && !tree.contains("trees") && !tree.contains("a");
+        passed &= tree.getMostLeft() == "" && tree.getMostRight() == "try";
+
+        // Keys that are prefixes of others come first
+        const string expected[] = {"", "art", "t", "tr", "tree", "treetop", "trie", "try"};
+        passed &= equal(tree.inorder_begin(), tree.inorder_end(), begin(expected), end(expected));
+        passed &= equal(tree.reverse_inorder_begin(), tree.reverse_inorder_end(), rbegin(expected), rend(expected));
+        tree.sanityCheck();
+
+        passed &= tree.remove("tr") && !tree.remove("tr") && !tree.remove("tre");
+        passed &= tree.popMostLeft() == "" && tree.popMostRight() == "try";
+        passed &= tree.size() == 5 && !tree.contains("tr") && tree.contains("tree");
+        tree.sanityCheck();
+
+        AdaptiveRadixTree<string> copy = tree;
+        passed &= copy == tree;
+        copy.insert("zebra");
+        passed &= copy != tree;
+        copy = tree;
+        passed &= copy == tree;
+
+        tree.clear();
+        passed &= tree.empty() && tree.size() == 0;
+        tree.sanityCheck();
+    }
+    cout << "Insert Remove Check        : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Every byte value under one node grows it through each type, and back down
+        AdaptiveRadixTree<string> tree;
+        set<string> reference;
+        for (int b = 255; b >= 0; b--) {
+            const string key = "key" + string(1, (char) b);
+            passed &= tree.insert(key) && reference.insert(key).second;
+            if (b % 16 == 0) tree.sanityCheck();
+        }
+        passed &= tree.insert("key");
+        reference.insert("key");
+        passed &= equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end());
+        passed &= tree.getMostRight() == "key" + string(1, (char) 255);
+
+        for (int b = 0; b < 256; b++) {
+            passed &= tree.remove("key" + string(1, (char) b));
+            if (b % 16 == 0) tree.sanityCheck();
+        }
+        passed &= tree.size() == 1 && tree.contains("key");
+        tree.sanityCheck();
+    }
+    cout << "Node Type Check            : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Random churn against std::set, with zero bytes, short keys, and prefixes beyond those stored in a node
+        for (bool shared : {false, true}) {
+            AdaptiveRadixTree<string> tree;
+            set<string> reference;
+            srand(0);
+            const string alphabet("ab\0\xff", 4);
+            for (int i = 0; i < 50000; i++) {
+                const string value = randomKey(alphabet, 6, shared);
+                const int action = rand() % 5;
+                if (action < 2) {
+                    passed &= tree.insert(value) == reference.insert(value).second;
+                } else if (action < 4) {
+                    passed &= tree.remove(value) == (reference.erase(value) != 0);
+                } else {
+                    passed &= tree.contains(value) == (reference.count(value) != 0);
+                }
+                if (i % 1000 == 0) tree.sanityCheck();
+            }
+            tree.sanityCheck();
+            passed &= tree.size() == reference.size();
+            passed &= equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end());
+            passed &= equal(tree.reverse_inorder_begin(), tree.reverse_inorder_end(),
+                                     reference.rbegin(), reference.rend());
+
+            while (!tree.empty()) {
+                passed &= tree.popMostLeft() == *reference.begin();
+                reference.erase(reference.begin());
+            }
+            tree.sanityCheck();
+        }
+    }
+    cout << "Churn Check                : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,505 @@
+#ifndef BPLUSTREE_CPP
+#define BPLUSTREE_CPP
+
+#include <algorithm>
+#include "BPlusTree.h"
+
+template <class T, size_t NodeBytes>
+BPlusTree<T, NodeBytes>::BPlusTree(const BPlusTree &tree):
+    compare(tree.compare), root(nullptr), height(tree.height), count(tree.count), first_leaf(nullptr), last_leaf(nullptr) {
+    if (tree.root != nullptr) root = copyInternal(tree.root, height, last_leaf);
+}
+
+template <class T, size_t NodeBytes>
+BPlusTree<T, NodeBytes>& BPlusTree<T, NodeBytes>::operator=(const BPlusTree &tree) {
+    if (this == &tree) return *this;
+
+    clear();
+    compare = tree.compare;
+    height = tree.height;
+    count = tree.count;
+    if (tree.root != nullptr) root = copyInternal(tree.root, height, last_leaf);
+    return *this;
+}
+
+template <class T, size_t NodeBytes>
+BPlusTree<T, NodeBytes>::~BPlusTree() {
+    clear();
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::Node*
+BPlusTree<T, NodeBytes>::copyInternal(const Node *node, const size_t levels, Leaf *&previous) {
+    if (levels == 1) {
+        const Leaf *source = static_cast<const Leaf*>(node);
+        Leaf *leaf = new Leaf();
+        leaf->count = source->count;
+        std::copy(source->keys, source->keys + source->count, leaf->keys);
+
+        // Copied in order, so link onto the previous leaf
+        leaf->prev = previous;
+        leaf->next = nullptr;
+        if (previous != nullptr) previous->next = leaf;
+        else first_leaf = leaf;
+        previous = leaf;
+        return leaf;
+    }
+
+    const Inner *source = static_cast<const Inner*>(node);
+    Inner *inner = new Inner();
+    inner->count = source->count;
+    std::copy(source->keys, source->keys + source->count, inner->keys);
+    for (size_t i = 0; i <= source->count; i++) {
+        inner->children[i] = copyInternal(source->children[i], levels - 1, previous);
+    }
+    return inner;
+}
+
+template <class T, size_t NodeBytes>
+void BPlusTree<T, NodeBytes>::clearInternal(Node *node, const size_t levels) noexcept {
+    if (levels == 1) {
+        delete static_cast<Leaf*>(node);
+        return;
+    }
+
+    Inner *inner = static_cast<Inner*>(node);
+    for (size_t i = 0; i <= inner->count; i++) clearInternal(inner->children[i], levels - 1);
+    delete inner;
+}
+
+template <class T, size_t NodeBytes>
+bool BPlusTree<T, NodeBytes>::operator==(const BPlusTree &tree) const noexcept {
+    // Size must match first
+    if (count != tree.count) return false;
+
+    // Use inorder iterator to compare. Identical if the iterators are identical
+    return std::equal(inorder_begin(), inorder_end(), tree.inorder_begin(), tree.inorder_end());
+}
+
+template <class T, size_t NodeBytes>
+bool BPlusTree<T, NodeBytes>::operator!=(const BPlusTree &tree) const noexcept {
+    return !operator==(tree);
+}
+
+template <class T, size_t NodeBytes>
+size_t BPlusTree<T, NodeBytes>::lowerBound(const Node *node, const T &value) const noexcept {
+    size_t low = 0, high = node->count;
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        if (compare(node->keys[middle], value) < 0) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+template <class T, size_t NodeBytes>
+size_t BPlusTree<T, NodeBytes>::childIndex(const Node *node, const T &value) const noexcept {
+    // A key equal to value is the smallest value of the child after it, so count the keys not greater
+    size_t low = 0, high = node->count;
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        if (compare(node->keys[middle], value) <= 0) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::Leaf* BPlusTree<T, NodeBytes>::findLeaf(const T &value) const noexcept {
+    Node *node = root;
+    for (size_t levels = height; levels > 1; levels--) {
+        node = static_cast<Inner*>(node)->children[childIndex(node, value)];
+    }
+    return static_cast<Leaf*>(node);
+}
+
+template <class T, size_t NodeBytes>
+bool BPlusTree<T, NodeBytes>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the tree.
+     *
+     * Return true if value is contained. False otherwise.
+     */
+    if (root == nullptr) return false;
+
+    const Leaf *leaf = findLeaf(value);
+    const size_t position = lowerBound(leaf, value);
+    return position < leaf->count && compare(leaf->keys[position], value) == 0;
+}
+
+template <class T, size_t NodeBytes>
+bool BPlusTree<T, NodeBytes>::insert(const T &value) noexcept {
+    /**
+     * Insert value into the tree.
+     *
+     * Return true if value was inserted. False if value was already in the tree.
+     */
+    if (root == nullptr) {
+        Leaf *leaf = new Leaf();
+        leaf->count = 1;
+        leaf->keys[0] = value;
+        leaf->prev = leaf->next = nullptr;
+
+        root = first_leaf = last_leaf = leaf;
+        height = 1;
+        count = 1;
+        return true;
+    }
+
+    T separator;
+    bool inserted = false;
+    Node *right = insertInternal(root, height, value, separator, inserted);
+
+    if (right != nullptr) {
+        // Root split, grow a level
+        Inner *inner = new Inner();
+        inner->count = 1;
+        inner->keys[0] = std::move(separator);
+        inner->children[0] = root;
+        inner->children[1] = right;
+        root = inner;
+        height++;
+    }
+
+    if (inserted) count++;
+    return inserted;
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::Node*
+BPlusTree<T, NodeBytes>::insertInternal(Node *node, const size_t levels, const T &value, T &separator, bool &inserted) {
+    if (levels == 1) {
+        Leaf *leaf = static_cast<Leaf*>(node);
+        const size_t position = lowerBound(leaf, value);
+        // Ignore duplicates
+        if (position < leaf->count && compare(leaf->keys[position], value) == 0) return nullptr;
+
+        inserted = true;
+        return insertLeaf(leaf, position, value, separator);
+    }
+
+    Inner *inner = static_cast<Inner*>(node);
+    const size_t i = childIndex(inner, value);
+
+    T child_separator;
+    Node *right = insertInternal(inner->children[i], levels - 1, value, child_separator, inserted);
+    if (right == nullptr) return nullptr;
+
+    return insertInner(inner, i, child_separator, right, separator);
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::Node*
+BPlusTree<T, NodeBytes>::insertLeaf(Leaf *leaf, const size_t position, const T &value, T &separator) {
+    if (leaf->count < node_keys) {
+        std::move_backward(leaf->keys + position, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        leaf->keys[position] = value;
+        leaf->count++;
+        return nullptr;
+    }
+
+    // Full, split so the left keeps the lower half of the node_keys + 1 values
+    const size_t middle = (node_keys + 1) / 2;
+    Leaf *right = new Leaf();
+
+    if (position < middle) {
+        // Value goes left, so the left gives up one more
+        std::move(leaf->keys + middle - 1, leaf->keys + node_keys, right->keys);
+        right->count = node_keys - middle + 1;
+        leaf->count = middle - 1;
+
+        std::move_backward(leaf->keys + position, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        leaf->keys[position] = value;
+        leaf->count++;
+    } else {
+        std::move(leaf->keys + middle, leaf->keys + position, right->keys);
+        right->keys[position - middle] = value;
+        std::move(leaf->keys + position, leaf->keys + node_keys, right->keys + position - middle + 1);
+        right->count = node_keys - middle + 1;
+        leaf->count = middle;
+    }
+
+    // Link in after leaf
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next != nullptr) leaf->next->prev = right;
+    else last_leaf = right;
+    leaf->next = right;
+
+    separator = right->keys[0];
+    return right;
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::Node*
+BPlusTree<T, NodeBytes>::insertInner(Inner *inner, const size_t position, const T &separator_in, Node *right_child,
+                                     T &separator) {
+    // separator_in goes at keys[position], with right_child after it
+    if (inner->count < node_keys) {
+        std::move_backward(inner->keys + position, inner->keys + inner->count, inner->keys + inner->count + 1);
+        std::move_backward(inner->children + position + 1, inner->children + inner->count + 1,
+                           inner->children + inner->count + 2);
+        inner->keys[position] = separator_in;
+        inner->children[position + 1] = right_child;
+        inner->count++;
+        return nullptr;
+    }
+
+    // Full, lay out all node_keys + 1 keys to split them
+    T keys[node_keys + 1];
+    Node *children[node_keys + 2];
+
+    std::move(inner->keys, inner->keys + position, keys);
+    keys[position] = separator_in;
+    std::move(inner->keys + position, inner->keys + node_keys, keys + position + 1);
+
+    std::copy(inner->children, inner->children + position + 1, children);
+    children[position + 1] = right_child;
+    std::copy(inner->children + position + 1, inner->children + node_keys + 1, children + position + 2);
+
+    // The middle key moves up, it does not stay in either half
+    const size_t middle = (node_keys + 1) / 2;
+    Inner *right = new Inner();
+
+    std::move(keys, keys + middle, inner->keys);
+    std::copy(children, children + middle + 1, inner->children);
+    inner->count = middle;
+
+    std::move(keys + middle + 1, keys + node_keys + 1, right->keys);
+    std::copy(children + middle + 1, children + node_keys + 2, right->children);
+    right->count = node_keys - middle;
+
+    separator = std::move(keys[middle]);
+    return right;
+}
+
+template <class T, size_t NodeBytes>
+bool BPlusTree<T, NodeBytes>::remove(const T &value) noexcept {
+    /**
+     * Remove value from the tree.
+     *
+     * Return true if value was removed. False if value was not in the tree.
+     */
+    if (root == nullptr) return false;
+
+    if (!removeInternal(root, height, value)) return false;
+
+    count--;
+    shrinkRoot();
+    return true;
+}
+
+template <class T, size_t NodeBytes>
+bool BPlusTree<T, NodeBytes>::removeInternal(Node *node, const size_t levels, const T &value) {
+    if (levels == 1) {
+        Leaf *leaf = static_cast<Leaf*>(node);
+        const size_t position = lowerBound(leaf, value);
+        if (position == leaf->count || compare(leaf->keys[position], value) != 0) return false;
+
+        removeFromLeaf(leaf, position);
+        return true;
+    }
+
+    /**
+     * Separators above the removed value are left alone.
+     * They still sort between their children, even if no longer equal to a value in the tree.
+     */
+    Inner *inner = static_cast<Inner*>(node);
+    const size_t i = childIndex(inner, value);
+    if (!removeInternal(inner->children[i], levels - 1, value)) return false;
+
+    if (inner->children[i]->count < min_keys) rebalance(inner, i, levels - 1);
+    return true;
+}
+
+template <class T, size_t NodeBytes>
+void BPlusTree<T, NodeBytes>::removeFromLeaf(Leaf *leaf, const size_t position) {
+    std::move(leaf->keys + position + 1, leaf->keys + leaf->count, leaf->keys + position);
+    leaf->count--;
+}
+
+template <class T, size_t NodeBytes>
+void BPlusTree<T, NodeBytes>::rebalance(Inner *parent, size_t i, const size_t levels) {
+    Node *child = parent->children[i];
+    Node *left = i > 0 ? parent->children[i - 1] : nullptr;
+    Node *right = i < parent->count ? parent->children[i + 1] : nullptr;
+
+    if (left != nullptr && left->count > min_keys) {
+        // Borrow the largest key of the left sibling
+        std::move_backward(child->keys, child->keys + child->count, child->keys + child->count + 1);
+
+        if (levels == 1) {
+            child->keys[0] = std::move(left->keys[left->count - 1]);
+            parent->keys[i - 1] = child->keys[0];
+        } else {
+            Inner *inner = static_cast<Inner*>(child);
+            Inner *sibling = static_cast<Inner*>(left);
+            std::move_backward(inner->children, inner->children + inner->count + 1,
+                               inner->children + inner->count + 2);
+
+            // Rotate through the parent
+            inner->keys[0] = std::move(parent->keys[i - 1]);
+            inner->children[0] = sibling->children[sibling->count];
+            parent->keys[i - 1] = std::move(sibling->keys[sibling->count - 1]);
+        }
+
+        left->count--;
+        child->count++;
+        return;
+    }
+
+    if (right != nullptr && right->count > min_keys) {
+        // Borrow the smallest key of the right sibling
+        if (levels == 1) {
+            child->keys[child->count] = std::move(right->keys[0]);
+            std::move(right->keys + 1, right->keys + right->count, right->keys);
+            parent->keys[i] = right->keys[0];
+        } else {
+            Inner *inner = static_cast<Inner*>(child);
+            Inner *sibling = static_cast<Inner*>(right);
+
+            // Rotate through the parent
+            inner->keys[inner->count] = std::move(parent->keys[i]);
+            inner->children[inner->count + 1] = sibling->children[0];
+            parent->keys[i] = std::move(sibling->keys[0]);
+
+            std::move(sibling->keys + 1, sibling->keys + sibling->count, sibling->keys);
+            std::copy(sibling->children + 1, sibling->children + sibling->count + 1, sibling->children);
+        }
+
+        right->count--;
+        child->count++;
+        return;
+    }
+
+    // Neither sibling can spare a key, so merge with one. Always merge the right of the pair into the left.
+    if (left != nullptr) {
+        right = child;
+        child = left;
+        i--;
+    }
+
+    if (levels == 1) {
+        Leaf *leaf = static_cast<Leaf*>(child);
+        Leaf *sibling = static_cast<Leaf*>(right);
+        std::move(sibling->keys, sibling->keys + sibling->count, leaf->keys + leaf->count);
+        leaf->count += sibling->count;
+
+        leaf->next = sibling->next;
+        if (sibling->next != nullptr) sibling->next->prev = leaf;
+        else last_leaf = leaf;
+        delete sibling;
+    } else {
+        Inner *inner = static_cast<Inner*>(child);
+        Inner *sibling = static_cast<Inner*>(right);
+
+        // The separator comes down between the two halves
+        inner->keys[inner->count] = std::move(parent->keys[i]);
+        std::move(sibling->keys, sibling->keys + sibling->count, inner->keys + inner->count + 1);
+        std::copy(sibling->children, sibling->children + sibling->count + 1, inner->children + inner->count + 1);
+        inner->count += sibling->count + 1;
+        delete sibling;
+    }
+
+    // Drop the separator and the merged child from the parent
+    std::move(parent->keys + i + 1, parent->keys + parent->count, parent->keys + i);
+    std::copy(parent->children + i + 2, parent->children + parent->count + 1, parent->children + i + 1);
+    parent->count--;
+}
+
+template <class T, size_t NodeBytes>
+void BPlusTree<T, NodeBytes>::shrinkRoot() {
+    if (root->count != 0) return;
+
+    if (height == 1) {
+        // Last value removed
+        delete static_cast<Leaf*>(root);
+        root = nullptr;
+        first_leaf = last_leaf = nullptr;
+        height = 0;
+        return;
+    }
+
+    Inner *inner = static_cast<Inner*>(root);
+    root = inner->children[0];
+    delete inner;
+    height--;
+}
+
+template <class T, size_t NodeBytes>
+T BPlusTree<T, NodeBytes>::popMostLeft() {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+
+    T value = first_leaf->keys[0];
+    remove(value);
+    return value;
+}
+
+template <class T, size_t NodeBytes>
+T BPlusTree<T, NodeBytes>::popMostRight() {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+
+    T value = last_leaf->keys[last_leaf->count - 1];
+    remove(value);
+    return value;
+}
+
+template <class T, size_t NodeBytes>
+void BPlusTree<T, NodeBytes>::clear() noexcept {
+    if (root != nullptr) clearInternal(root, height);
+    root = nullptr;
+    first_leaf = last_leaf = nullptr;
+    height = 0;
+    count = 0;
+}
+
+template <class T, size_t NodeBytes>
+bool BPlusTree<T, NodeBytes>::empty() const noexcept {
+    return root == nullptr;
+}
+
+template <class T, size_t NodeBytes>
+size_t BPlusTree<T, NodeBytes>::size() const noexcept {
+    return count;
+}
+
+template <class T, size_t NodeBytes>
+T BPlusTree<T, NodeBytes>::getMostLeft() const {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+    return first_leaf->keys[0];
+}
+
+template <class T, size_t NodeBytes>
+T BPlusTree<T, NodeBytes>::getMostRight() const {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+    return last_leaf->keys[last_leaf->count - 1];
+}
+
+template <class T, size_t NodeBytes>
+size_t BPlusTree<T, NodeBytes>::getHeight() const noexcept {
+    return height;
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::inorder_iterator BPlusTree<T, NodeBytes>::inorder_begin() const noexcept {
+    return inorder_iterator(first_leaf, 0);
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::inorder_iterator BPlusTree<T, NodeBytes>::inorder_end() const noexcept {
+    return inorder_iterator(nullptr, 0);
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::reverse_inorder_iterator
+BPlusTree<T, NodeBytes>::reverse_inorder_begin() const noexcept {
+    return reverse_inorder_iterator(last_leaf, last_leaf != nullptr ? last_leaf->count - 1 : 0);
+}
+
+template <class T, size_t NodeBytes>
+typename BPlusTree<T, NodeBytes>::reverse_inorder_iterator
+BPlusTree<T, NodeBytes>::reverse_inorder_end() const noexcept {
+    return reverse_inorder_iterator(nullptr, 0);
+}
+
+#endif //BPLUSTREE_CPP
@@ -0,0 +1,265 @@
+/*
+ * Implementation of a B+ tree that ignores duplicate entries
+ *
+ * Each node holds a block of sorted keys, sized by NodeBytes (a few cache lines by default),
+ * so a lookup takes one miss per level of a tree with a fanout of dozens, instead of one per binary level.
+ * Values are only stored in the leaves. Inner nodes hold copies that separate their children,
+ * and the leaves are linked in order for the iterators.
+ *
+ * The public interface matches BinaryTree where it makes sense. There is no binary shape,
+ * so there is no root value, no preorder or level order traversals, and no printing.
+ */
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include "../binaryTree.h"
+
+template <class T, size_t Keys>
+struct BPlusTreeNode {
+    // Number of keys in use
+    size_t count;
+    T keys[Keys];
+};
+
+template <class T, size_t Keys>
+struct BPlusTreeLeaf: public BPlusTreeNode<T, Keys> {
+    BPlusTreeLeaf *prev;
+    BPlusTreeLeaf *next;
+};
+
+template <class T, size_t Keys>
+struct BPlusTreeInner: public BPlusTreeNode<T, Keys> {
+    // Child i holds the values from keys[i - 1] up to, but not including keys[i]
+    BPlusTreeNode<T, Keys> *children[Keys + 1];
+};
+
+template <class T, size_t NodeBytes = 256>
+class BPlusTree {
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Keys in each node. Every node but the root keeps at least half of them.
+    static constexpr size_t node_keys = NodeBytes / sizeof(T) > 4 ? NodeBytes / sizeof(T) : 4;
+    static constexpr size_t min_keys = node_keys / 2;
+
+  protected:
+    using Node = BPlusTreeNode<T, node_keys>;
+    using Leaf = BPlusTreeLeaf<T, node_keys>;
+    using Inner = BPlusTreeInner<T, node_keys>;
+
+    // Comparison function
+    int (*compare)(const T &a, const T &b);
+
+    Node *root;
+    // Levels of nodes. The root is a leaf if this is 1, and there is no root if it is 0.
+    size_t height;
+    size_t count;
+
+    Leaf *first_leaf;
+    Leaf *last_leaf;
+
+    // Position of the first key of node not less than value
+    size_t lowerBound(const Node *node, const T &value) const noexcept;
+    // Child of node that value belongs in
+    size_t childIndex(const Node *node, const T &value) const noexcept;
+
+    Leaf* findLeaf(const T &value) const noexcept;
+
+    /**
+     * Insert into the subtree at node, with the given number of levels.
+     *
+     * @return If node split, the new node holding its upper half, and separator is set to its smallest value.
+     * Otherwise nullptr.
+     */
+    Node* insertInternal(Node *node, size_t levels, const T &value, T &separator, bool &inserted);
+    Node* insertLeaf(Leaf *leaf, size_t position, const T &value, T &separator);
+    Node* insertInner(Inner *inner, size_t position, const T &separator_in, Node *right, T &separator);
+
+    // Remove from the subtree at node. Children left with too few keys are fixed, node itself is not.
+    bool removeInternal(Node *node, size_t levels, const T &value);
+    void removeFromLeaf(Leaf *leaf, size_t position);
+    // Fix child i of parent, at levels, after it drops below min_keys
+    void rebalance(Inner *parent, size_t i, size_t levels);
+    // Replace the root while it has a single child, or delete it if it is empty
+    void shrinkRoot();
+
+    void clearInternal(Node *node, size_t levels) noexcept;
+    Node* copyInternal(const Node *node, size_t levels, Leaf *&previous);
+
+  public:
+    explicit BPlusTree(int (*compare)(const T &a, const T &b) = default_compare):
+        compare(compare), root(nullptr), height(0), count(0), first_leaf(nullptr), last_leaf(nullptr) {}
+
+    // Copy constructor
+    BPlusTree(const BPlusTree &tree);
+
+    // Assignment constructor
+    BPlusTree& operator=(const BPlusTree &tree);
+
+    ~BPlusTree();
+
+    bool operator==(const BPlusTree &tree) const noexcept;
+    bool operator!=(const BPlusTree &tree) const noexcept;
+
+    bool contains(const T &value) const noexcept;
+    bool insert(const T &value) noexcept;
+    bool remove(const T &value) noexcept;
+
+    T popMostLeft();
+    T popMostRight();
+
+    void clear() noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    T getMostLeft() const;
+    T getMostRight() const;
+
+    // Levels of nodes, not of a binary tree. Zero if the tree is empty.
+    size_t getHeight() const noexcept;
+
+    /*
+     * Iterators walk the linked leaves.
+     */
+    template <bool Reverse>
+    class leaf_iterator {
+        // Allow BPlusTree to use the protected constructor
+        friend class BPlusTree;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        leaf_iterator(const leaf_iterator &iter) = default;
+        leaf_iterator& operator=(const leaf_iterator &iter) = default;
+
+        // Prefix ++ overload
+        leaf_iterator& operator++() {
+            if (leaf == nullptr) return *this;
+
+            if (Reverse) {
+                if (position > 0) {
+                    position--;
+                } else {
+                    leaf = leaf->prev;
+                    position = leaf != nullptr ? leaf->count - 1 : 0;
+                }
+            } else {
+                if (++position == leaf->count) {
+                    leaf = leaf->next;
+                    position = 0;
+                }
+            }
+            return *this;
+        }
+
+        // Postfix ++ overload
+        leaf_iterator operator++(int) {
+            leaf_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const leaf_iterator &iter) const {
+            return leaf == iter.leaf && position == iter.position;
+        }
+
+        bool operator!=(const leaf_iterator &iter) const {
+            return !operator==(iter);
+        }
+
+        T operator*() const {
+            if (leaf == nullptr)
+                throw std::out_of_range("iterator has been exhausted");
+            return leaf->keys[position];
+        }
+
+      protected:
+        leaf_iterator(const Leaf *leaf, size_t position): leaf(leaf), position(position) {}
+
+        const Leaf *leaf;
+        size_t position;
+    };
+
+    using inorder_iterator = leaf_iterator<false>;
+    using reverse_inorder_iterator = leaf_iterator<true>;
+
+    inorder_iterator inorder_begin() const noexcept;
+    inorder_iterator inorder_end() const noexcept;
+
+    reverse_inorder_iterator reverse_inorder_begin() const noexcept;
+    reverse_inorder_iterator reverse_inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong
+    void sanityCheck() const {
+        if ((root == nullptr) != (height == 0))
+            throw std::logic_error("Height does not match the root");
+        if (root == nullptr) {
+            if (count != 0 || first_leaf != nullptr || last_leaf != nullptr)
+                throw std::logic_error("Empty tree still holds values");
+            return;
+        }
+
+        size_t sanity_count = 0;
+        const Leaf *previous = nullptr;
+        sanityCheckInternal(root, height, nullptr, nullptr, sanity_count, previous);
+
+        if (count != sanity_count)
+            throw std::logic_error("BPlusTree size does not match count of elements");
+        if (previous != last_leaf || previous->next != nullptr)
+            throw std::logic_error("Last leaf is not linked");
+    }
+
+  protected:
+    // Checks the subtree at node holds values in [low, high). Null bounds are unbounded.
+    void sanityCheckInternal(const Node *node, size_t levels, const T *low, const T *high,
+                             size_t &sanity_count, const Leaf *&previous) const {
+        if (node->count > node_keys)
+            throw std::logic_error("Node holds too many keys");
+        if (node != root && node->count < min_keys)
+            throw std::logic_error("Node holds too few keys");
+        if (node->count == 0)
+            throw std::logic_error("Node is empty");
+
+        for (size_t i = 0; i < node->count; i++) {
+            if (i > 0 && compare(node->keys[i - 1], node->keys[i]) >= 0)
+                throw std::logic_error("Keys are not increasing");
+            if (low != nullptr && compare(node->keys[i], *low) < 0)
+                throw std::logic_error("Key is less than its lower separator");
+            if (high != nullptr && compare(node->keys[i], *high) >= 0)
+                throw std::logic_error("Key is not less than its upper separator");
+        }
+
+        if (levels == 1) {
+            const Leaf *leaf = static_cast<const Leaf*>(node);
+            if (leaf->prev != previous || (previous == nullptr ? first_leaf != leaf : previous->next != leaf))
+                throw std::logic_error("Leaves are not linked in order");
+            previous = leaf;
+            sanity_count += leaf->count;
+            return;
+        }
+
+        const Inner *inner = static_cast<const Inner*>(node);
+        for (size_t i = 0; i <= inner->count; i++) {
+            sanityCheckInternal(inner->children[i], levels - 1,
+                                i == 0 ? low : &inner->keys[i - 1],
+                                i == inner->count ? high : &inner->keys[i],
+                                sanity_count, previous);
+        }
+    }
+  public:
+#endif
+};
+
+#include "BPlusTree.cpp"
+#endif //BPLUSTREE_H
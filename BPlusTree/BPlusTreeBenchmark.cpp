@@ -0,0 +1,76 @@
+/*
+ * Performance Benchmark for BPlusTree
+ *
+ * g++ BPlusTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o BPlusTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+// Each tree is only built once, the misses per lookup only show once it is far larger than the cache
+#define TESTS RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Complexity()
+
+#include "BPlusTree.h"
+#include "../AVLTree/AVLTree.h"
+
+inline int RandomNumber() {
+    return rand();
+}
+
+template <class Tree>
+inline void ConstructRandomTree(Tree &tree, size_t size) {
+    while (tree.size() < size)
+        tree.insert(RandomNumber());
+}
+
+static void BM_AVLTreeContains(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.contains(RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AVLTreeContains)->TESTS;
+
+template <size_t NodeBytes>
+static void BM_BPlusTreeContains(benchmark::State &state) {
+    BPlusTree<int, NodeBytes> tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.contains(RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_BPlusTreeContains, 64)->TESTS;
+BENCHMARK_TEMPLATE(BM_BPlusTreeContains, 256)->TESTS;
+BENCHMARK_TEMPLATE(BM_BPlusTreeContains, 4096)->TESTS;
+
+static void BM_AVLTreeChurn(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        tree.insert(RandomNumber());
+        tree.remove(RandomNumber());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AVLTreeChurn)->TESTS;
+
+template <size_t NodeBytes>
+static void BM_BPlusTreeChurn(benchmark::State &state) {
+    BPlusTree<int, NodeBytes> tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        tree.insert(RandomNumber());
+        tree.remove(RandomNumber());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_BPlusTreeChurn, 256)->TESTS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,39 @@
+/*
+ * Test cases for testing the sanity of the BPlusTree
+ */
+
+#include <iostream>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "BPlusTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "BPlusTree Tests" << endl;
+    test_set<BPlusTree<int>>(compare);
+
+    bool passed = true;
+    {
+        // Sequential inserts always split the last leaf
+        BPlusTree<int> tree(compare);
+        for (int i = 0; i < 10000; i++) tree.insert(i);
+        for (int i = -1; i >= -10000; i--) tree.insert(i);
+        tree.sanityCheck();
+        passed &= tree.size() == 20000;
+        // Nodes at least half full bound the height
+        passed &= tree.getHeight() <= 4;
+
+        // Removing most values merges the nodes back together
+        for (int i = -10000; i < 9990; i++) tree.remove(i);
+        tree.sanityCheck();
+        passed &= tree.size() == 10 && tree.getHeight() == 1;
+
+        while (!tree.empty()) tree.popMostRight();
+        passed &= tree.getHeight() == 0;
+        tree.sanityCheck();
+    }
+    cout << "Height Check               : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,320 @@
+#ifndef BITMAPTRIE_CPP
+#define BITMAPTRIE_CPP
+
+#include "BitmapTrie.h"
+
+template <class T>
+typename BitmapTrie<T>::Key BitmapTrie<T>::minimumKey(Slot slot, unsigned level, Key prefix) noexcept {
+    for (; level > 0; level--) {
+        const Node *node = slot.node;
+        prefix = prefix << level_bits | __builtin_ctzll(node->mask);
+        slot = node->slots.front();
+    }
+    return prefix << level_bits | __builtin_ctzll(slot.bits);
+}
+
+template <class T>
+typename BitmapTrie<T>::Key BitmapTrie<T>::maximumKey(Slot slot, unsigned level, Key prefix) noexcept {
+    for (; level > 0; level--) {
+        const Node *node = slot.node;
+        prefix = prefix << level_bits | (63 - __builtin_clzll(node->mask));
+        slot = node->slots.back();
+    }
+    return prefix << level_bits | (63 - __builtin_clzll(slot.bits));
+}
+
+template <class T>
+bool BitmapTrie<T>::successorInternal(Slot slot, unsigned level, Key key, Key &next) noexcept {
+    const unsigned index = indexAt(key, level);
+
+    // Every bit above index. Shifting by 64 is undefined, so shift twice.
+    const uint64_t above = ~uint64_t(0) << index << 1;
+
+    if (level == 0) {
+        const uint64_t bits = slot.bits & above;
+        if (bits == 0) return false;
+        next = (key & ~Key(63)) | __builtin_ctzll(bits);
+        return true;
+    }
+
+    const Node *node = slot.node;
+    if ((node->mask >> index & 1) && successorInternal(node->slots[slotOf(node->mask, index)], level - 1, key, next))
+        return true;
+
+    // Nothing greater under index, so take the least key of the next child along
+    const uint64_t mask = node->mask & above;
+    if (mask == 0) return false;
+
+    const unsigned next_index = __builtin_ctzll(mask);
+    const Key prefix = key >> (level * level_bits) >> level_bits << level_bits | next_index;
+    next = minimumKey(node->slots[slotOf(node->mask, next_index)], level - 1, prefix);
+    return true;
+}
+
+template <class T>
+bool BitmapTrie<T>::predecessorInternal(Slot slot, unsigned level, Key key, Key &prev) noexcept {
+    const unsigned index = indexAt(key, level);
+    const uint64_t below = (uint64_t(1) << index) - 1;
+
+    if (level == 0) {
+        const uint64_t bits = slot.bits & below;
+        if (bits == 0) return false;
+        prev = (key & ~Key(63)) | (63 - __builtin_clzll(bits));
+        return true;
+    }
+
+    const Node *node = slot.node;
+    if ((node->mask >> index & 1) && predecessorInternal(node->slots[slotOf(node->mask, index)], level - 1, key, prev))
+        return true;
+
+    // Nothing less under index, so take the greatest key of the previous child
+    const uint64_t mask = node->mask & below;
+    if (mask == 0) return false;
+
+    const unsigned prev_index = 63 - __builtin_clzll(mask);
+    const Key prefix = key >> (level * level_bits) >> level_bits << level_bits | prev_index;
+    prev = maximumKey(node->slots[slotOf(node->mask, prev_index)], level - 1, prefix);
+    return true;
+}
+
+template <class T>
+bool BitmapTrie<T>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the tree.
+     */
+    if (root == nullptr) return false;
+
+    const Key key = toKey(value);
+    const Node *node = root;
+    for (unsigned level = levels; level > 1; level--) {
+        const unsigned index = indexAt(key, level);
+        if (!(node->mask >> index & 1)) return false;
+        node = node->slots[slotOf(node->mask, index)].node;
+    }
+
+    const unsigned index = indexAt(key, 1);
+    if (!(node->mask >> index & 1)) return false;
+    return node->slots[slotOf(node->mask, index)].bits >> indexAt(key, 0) & 1;
+}
+
+template <class T>
+bool BitmapTrie<T>::insert(const T &value) noexcept {
+    const Key key = toKey(value);
+    if (root == nullptr) root = new Node();
+
+    Node *node = root;
+    for (unsigned level = levels; ; level--) {
+        const unsigned index = indexAt(key, level);
+        const unsigned position = slotOf(node->mask, index);
+
+        if (!(node->mask >> index & 1)) {
+            // Add the missing child in order
+            Slot slot;
+            if (level == 1) {
+                slot.bits = 0;
+            } else {
+                slot.node = new Node();
+            }
+            node->slots.insert(node->slots.begin() + position, slot);
+            node->mask |= uint64_t(1) << index;
+        }
+
+        if (level == 1) {
+            uint64_t &bits = node->slots[position].bits;
+            const uint64_t bit = uint64_t(1) << indexAt(key, 0);
+            // value exists in the tree
+            if (bits & bit) return false;
+
+            bits |= bit;
+            count++;
+            return true;
+        }
+        node = node->slots[position].node;
+    }
+}
+
+template <class T>
+bool BitmapTrie<T>::removeInternal(Node *node, unsigned level, Key key) {
+    const unsigned index = indexAt(key, level);
+    if (!(node->mask >> index & 1)) return false;
+
+    const unsigned position = slotOf(node->mask, index);
+    if (level == 1) {
+        uint64_t &bits = node->slots[position].bits;
+        const uint64_t bit = uint64_t(1) << indexAt(key, 0);
+        if (!(bits & bit)) return false;
+
+        bits &= ~bit;
+        if (bits != 0) return true;
+    } else {
+        Node *child = node->slots[position].node;
+        if (!removeInternal(child, level - 1, key)) return false;
+        if (child->mask != 0) return true;
+        delete child;
+    }
+
+    // The child is empty, so drop it
+    node->slots.erase(node->slots.begin() + position);
+    node->mask &= ~(uint64_t(1) << index);
+    return true;
+}
+
+template <class T>
+bool BitmapTrie<T>::remove(const T &value) noexcept {
+    if (root == nullptr || !removeInternal(root, levels, toKey(value))) return false;
+
+    count--;
+    if (root->mask == 0) {
+        delete root;
+        root = nullptr;
+    }
+    return true;
+}
+
+template <class T>
+bool BitmapTrie<T>::successor(const T &value, T &result) const noexcept {
+    if (root == nullptr) return false;
+
+    Slot slot;
+    slot.node = root;
+    Key next;
+    if (!successorInternal(slot, levels, toKey(value), next)) return false;
+
+    result = fromKey(next);
+    return true;
+}
+
+template <class T>
+bool BitmapTrie<T>::predecessor(const T &value, T &result) const noexcept {
+    if (root == nullptr) return false;
+
+    Slot slot;
+    slot.node = root;
+    Key prev;
+    if (!predecessorInternal(slot, levels, toKey(value), prev)) return false;
+
+    result = fromKey(prev);
+    return true;
+}
+
+template <class T>
+T BitmapTrie<T>::getMostLeft() const {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+
+    Slot slot;
+    slot.node = root;
+    return fromKey(minimumKey(slot, levels, 0));
+}
+
+template <class T>
+T BitmapTrie<T>::getMostRight() const {
+    if (root == nullptr) throw std::out_of_range("tree is empty");
+
+    Slot slot;
+    slot.node = root;
+    return fromKey(maximumKey(slot, levels, 0));
+}
+
+template <class T>
+T BitmapTrie<T>::popMostLeft() {
+    T value = getMostLeft();
+    remove(value);
+    return value;
+}
+
+template <class T>
+T BitmapTrie<T>::popMostRight() {
+    T value = getMostRight();
+    remove(value);
+    return value;
+}
+
+template <class T>
+void BitmapTrie<T>::clearInternal(Node *node, unsigned level) noexcept {
+    if (level > 1) {
+        for (Slot &slot : node->slots) clearInternal(slot.node, level - 1);
+    }
+    delete node;
+}
+
+template <class T>
+typename BitmapTrie<T>::Node* BitmapTrie<T>::copyInternal(const Node *node, unsigned level) {
+    // Leaf bitmaps are copied with the slots, only nodes need copying further
+    Node *copy = new Node(*node);
+    if (level > 1) {
+        for (Slot &slot : copy->slots) slot.node = copyInternal(slot.node, level - 1);
+    }
+    return copy;
+}
+
+template <class T>
+BitmapTrie<T>::BitmapTrie(const BitmapTrie &tree):
+    root(tree.root != nullptr ? copyInternal(tree.root, levels) : nullptr), count(tree.count) {}
+
+template <class T>
+BitmapTrie<T>& BitmapTrie<T>::operator=(const BitmapTrie &tree) {
+    if (this == &tree) return *this;
+
+    clear();
+    if (tree.root != nullptr) root = copyInternal(tree.root, levels);
+    count = tree.count;
+    return *this;
+}
+
+template <class T>
+BitmapTrie<T>::~BitmapTrie() {
+    clear();
+}
+
+template <class T>
+bool BitmapTrie<T>::operator==(const BitmapTrie &tree) const noexcept {
+    if (count != tree.count) return false;
+
+    for (auto a = inorder_begin(), b = tree.inorder_begin(); a != inorder_end(); ++a, ++b) {
+        if (a.value != b.value) return false;
+    }
+    return true;
+}
+
+template <class T>
+bool BitmapTrie<T>::operator!=(const BitmapTrie &tree) const noexcept {
+    return !operator==(tree);
+}
+
+template <class T>
+void BitmapTrie<T>::clear() noexcept {
+    if (root != nullptr) clearInternal(root, levels);
+    root = nullptr;
+    count = 0;
+}
+
+template <class T>
+bool BitmapTrie<T>::empty() const noexcept {
+    return root == nullptr;
+}
+
+template <class T>
+size_t BitmapTrie<T>::size() const noexcept {
+    return count;
+}
+
+template <class T>
+typename BitmapTrie<T>::inorder_iterator BitmapTrie<T>::inorder_begin() const noexcept {
+    return root != nullptr ? inorder_iterator(this, getMostLeft()) : inorder_end();
+}
+
+template <class T>
+typename BitmapTrie<T>::inorder_iterator BitmapTrie<T>::inorder_end() const noexcept {
+    return inorder_iterator(nullptr, T());
+}
+
+template <class T>
+typename BitmapTrie<T>::reverse_inorder_iterator BitmapTrie<T>::reverse_inorder_begin() const noexcept {
+    return root != nullptr ? reverse_inorder_iterator(this, getMostRight()) : reverse_inorder_end();
+}
+
+template <class T>
+typename BitmapTrie<T>::reverse_inorder_iterator BitmapTrie<T>::reverse_inorder_end() const noexcept {
+    return reverse_inorder_iterator(nullptr, T());
+}
+#endif //BITMAPTRIE_CPP
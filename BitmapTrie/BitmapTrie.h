@@ -0,0 +1,234 @@
+/*
+ * Implementation of an ordered set of integers as a trie of 64 bit bitmaps, that ignores duplicate entries
+ *
+ * Each node branches on 6 bits of the key, and keeps a bitmap of which of its 64 children exist.
+ * The children are packed in order, so a child is found by the popcount of the bits below it,
+ * and the next child along by a count of trailing zeros. The bottom 6 bits of a key are a bit in a leaf bitmap.
+ *
+ * Every operation takes one step per level, 6 for a 32 bit key, whatever the number of keys.
+ * That is O(log U / 6) for a universe of U keys, each step a bitmap test and a popcount.
+ * Only nodes on the way to a key are allocated, so sparse keys cost about one small node each.
+ *
+ * Signed keys are stored with their sign bit flipped, so they are ordered as the integers are.
+ */
+#ifndef BITMAPTRIE_H
+#define BITMAPTRIE_H
+
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+template <class T = int>
+class BitmapTrie {
+    static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t), "BitmapTrie keys must be integers");
+
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Bits of the key each level branches on
+    static constexpr unsigned level_bits = 6;
+    static constexpr unsigned key_bits = sizeof(T) * 8;
+    // Levels of nodes above the leaf bitmaps. The top one takes whatever bits are left.
+    static constexpr unsigned levels = (key_bits - 1) / level_bits;
+
+  protected:
+    using Key = uint64_t;
+
+    struct Node;
+    // Nodes on the lowest level hold leaf bitmaps, the rest hold nodes
+    union Slot {
+        Node *node;
+        uint64_t bits;
+    };
+
+    struct Node {
+        // Which children are present, one bit per 6 bit index
+        uint64_t mask = 0;
+        // The present children, in order of index
+        std::vector<Slot> slots;
+    };
+
+    Node *root;
+    size_t count;
+
+    // Flip the sign bit of signed keys, so negative keys order first
+    static Key toKey(const T &value) noexcept {
+        using Unsigned = typename std::make_unsigned<T>::type;
+        Key key = static_cast<Unsigned>(value);
+        if (std::is_signed<T>::value) key ^= Key(1) << (key_bits - 1);
+        return key;
+    }
+    static T fromKey(Key key) noexcept {
+        using Unsigned = typename std::make_unsigned<T>::type;
+        if (std::is_signed<T>::value) key ^= Key(1) << (key_bits - 1);
+        return static_cast<T>(static_cast<Unsigned>(key));
+    }
+
+    // Index of key within a node on level, where level 0 is the leaf bitmap
+    static unsigned indexAt(Key key, unsigned level) noexcept {return (key >> (level * level_bits)) & 63;}
+    // Position of index among the present children of mask
+    static unsigned slotOf(uint64_t mask, unsigned index) noexcept {
+        return __builtin_popcountll(mask & ((uint64_t(1) << index) - 1));
+    }
+
+    // Least and greatest keys under slot, a child on level, whose higher bits are prefix
+    static Key minimumKey(Slot slot, unsigned level, Key prefix) noexcept;
+    static Key maximumKey(Slot slot, unsigned level, Key prefix) noexcept;
+
+    // Least key in slot, a child on level, greater than key. The bits of key above level must match slot.
+    static bool successorInternal(Slot slot, unsigned level, Key key, Key &next) noexcept;
+    // Greatest key in slot, a child on level, less than key
+    static bool predecessorInternal(Slot slot, unsigned level, Key key, Key &prev) noexcept;
+
+    // Remove key under node, on level. Returns false if key is not present.
+    static bool removeInternal(Node *node, unsigned level, Key key);
+
+    static void clearInternal(Node *node, unsigned level) noexcept;
+    static Node* copyInternal(const Node *node, unsigned level);
+
+  public:
+    BitmapTrie(): root(nullptr), count(0) {}
+
+    // Copy constructor
+    BitmapTrie(const BitmapTrie &tree);
+
+    // Assignment constructor
+    BitmapTrie& operator=(const BitmapTrie &tree);
+
+    ~BitmapTrie();
+
+    bool operator==(const BitmapTrie &tree) const noexcept;
+    bool operator!=(const BitmapTrie &tree) const noexcept;
+
+    bool contains(const T &value) const noexcept;
+    bool insert(const T &value) noexcept;
+    bool remove(const T &value) noexcept;
+
+    /**
+     * Least value greater than value, and greatest value less than value.
+     * Set result and return true, or return false if there is no such value.
+     * value itself need not be present.
+     */
+    bool successor(const T &value, T &result) const noexcept;
+    bool predecessor(const T &value, T &result) const noexcept;
+
+    T popMostLeft();
+    T popMostRight();
+
+    void clear() noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    T getMostLeft() const;
+    T getMostRight() const;
+
+    /*
+     * Iterators step with successor() and predecessor(), so each step takes one walk down the levels.
+     */
+    template <bool Reverse>
+    class bitmap_iterator {
+        // Allow BitmapTrie to use the protected constructor
+        friend class BitmapTrie;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        bitmap_iterator(const bitmap_iterator &iter) = default;
+        bitmap_iterator& operator=(const bitmap_iterator &iter) = default;
+
+        // Prefix ++ overload
+        bitmap_iterator& operator++() {
+            if (tree != nullptr) {
+                T next;
+                bool found = Reverse ? tree->predecessor(value, next) : tree->successor(value, next);
+                if (found) {
+                    value = next;
+                } else {
+                    tree = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        // Postfix ++ overload
+        bitmap_iterator operator++(int) {
+            bitmap_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const bitmap_iterator &iter) const {
+            return tree == iter.tree && (tree == nullptr || value == iter.value);
+        }
+
+        bool operator!=(const bitmap_iterator &iter) const {
+            return !operator==(iter);
+        }
+
+        T operator*() const {
+            if (tree == nullptr)
+                throw std::out_of_range("iterator has been exhausted");
+            return value;
+        }
+
+      protected:
+        // A nullptr tree is the end
+        bitmap_iterator(const BitmapTrie *tree, T value): tree(tree), value(value) {}
+
+        const BitmapTrie *tree;
+        T value;
+    };
+
+    using inorder_iterator = bitmap_iterator<false>;
+    using reverse_inorder_iterator = bitmap_iterator<true>;
+
+    inorder_iterator inorder_begin() const noexcept;
+    inorder_iterator inorder_end() const noexcept;
+
+    reverse_inorder_iterator reverse_inorder_begin() const noexcept;
+    reverse_inorder_iterator reverse_inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong
+    void sanityCheck() const {
+        size_t sanity_count = 0;
+        if (root != nullptr) sanityCheckInternal(root, levels, sanity_count);
+
+        if (count != sanity_count)
+            throw std::logic_error("BitmapTrie size does not match count of elements");
+        if ((root == nullptr) != (count == 0))
+            throw std::logic_error("Empty tree should have no root");
+    }
+
+  protected:
+    static void sanityCheckInternal(const Node *node, unsigned level, size_t &sanity_count) {
+        if (node->mask == 0)
+            throw std::logic_error("Node has no children");
+        if ((size_t) __builtin_popcountll(node->mask) != node->slots.size())
+            throw std::logic_error("Node mask does not match its children");
+
+        for (const Slot &slot : node->slots) {
+            if (level == 1) {
+                if (slot.bits == 0)
+                    throw std::logic_error("Leaf bitmap is empty");
+                sanity_count += __builtin_popcountll(slot.bits);
+            } else {
+                sanityCheckInternal(slot.node, level - 1, sanity_count);
+            }
+        }
+    }
+  public:
+#endif
+};
+
+#include "BitmapTrie.cpp"
+#endif //BITMAPTRIE_H
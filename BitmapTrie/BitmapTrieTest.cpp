@@ -0,0 +1,77 @@
+/*
+ * Test cases for testing the sanity of the BitmapTrie
+ */
+
+#include <set>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "BitmapTrie.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "BitmapTrie Tests" << endl;
+    test_set<BitmapTrie<int>>();
+
+    bool passed = true;
+    {
+        // Nothing follows or precedes anything in an empty trie
+        BitmapTrie<int> tree;
+        int result;
+        passed &= !tree.successor(0, result) && !tree.predecessor(0, result);
+
+        // Negative keys order first, and the extremes are reachable
+        for (int i : {0, -1, INT_MIN, INT_MAX, 64, -64, 63, -65}) passed &= tree.insert(i);
+        passed &= iteratorEquals(tree.inorder_begin(), tree.inorder_end(), {INT_MIN, -65, -64, -1, 0, 63, 64, INT_MAX});
+
+        passed &= tree.successor(-1, result) && result == 0;
+        passed &= tree.successor(-63, result) && result == -1;
+        passed &= tree.predecessor(64, result) && result == 63;
+        passed &= tree.predecessor(0, result) && result == -1;
+        passed &= tree.successor(1000, result) && result == INT_MAX;
+        passed &= !tree.successor(INT_MAX, result) && !tree.predecessor(INT_MIN, result);
+        tree.sanityCheck();
+
+        BitmapTrie<unsigned long long> wide;
+        passed &= wide.insert(0) && wide.insert(ULLONG_MAX);
+        unsigned long long wide_result;
+        passed &= wide.successor(0, wide_result) && wide_result == ULLONG_MAX;
+        passed &= wide.popMostRight() == ULLONG_MAX && wide.popMostRight() == 0 && wide.empty();
+        wide.sanityCheck();
+    }
+    cout << "Order Check                : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Random churn against std::set, with negative values and successor lookups
+        BitmapTrie<int> tree;
+        set<int> reference;
+        srand(0);
+        for (int i = 0; i < 50000; i++) {
+            const int value = rand() % 5000 - 2500;
+            const int action = rand() % 3;
+            if (action == 0) {
+                passed &= tree.insert(value) == reference.insert(value).second;
+            } else if (action == 1) {
+                passed &= tree.remove(value) == (reference.erase(value) != 0);
+            } else {
+                int result;
+                auto next = reference.upper_bound(value);
+                passed &= tree.successor(value, result) == (next != reference.end());
+                if (next != reference.end()) passed &= result == *next;
+            }
+            if (i % 1000 == 0) tree.sanityCheck();
+        }
+        tree.sanityCheck();
+        passed &= tree.size() == reference.size();
+        passed &= equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end());
+        passed &= equal(tree.reverse_inorder_begin(), tree.reverse_inorder_end(), reference.rbegin(), reference.rend());
+    }
+    cout << "Successor Churn Check      : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,315 @@
+#ifndef CBTREE_CPP
+#define CBTREE_CPP
+
+#include "CBTree.h"
+
+template <class T, class Node>
+CBTree<T, Node>::CBTree(int (*compare)(const T &a, const T &b)): BinaryTree<T, Node>(compare) {
+    discardDeferred();
+}
+
+template <class T, class Node>
+CBTree<T, Node>::CBTree(const CBTree &tree): BinaryTree<T, Node>(tree) {
+    // Recorded nodes belong to the other tree
+    discardDeferred();
+}
+
+template <class T, class Node>
+CBTree<T, Node>& CBTree<T, Node>::operator=(const CBTree &tree) {
+    // Every node is replaced, so nothing recorded survives
+    discardDeferred();
+    BinaryTree<T, Node>::operator=(tree);
+    return *this;
+}
+
+template <class T, class Node>
+uint64_t CBTree<T, Node>::selfWeight(const Node *node) noexcept {
+    const uint64_t weight = weightOf(node), children = weightOf(node->left) + weightOf(node->right);
+    return weight > children ? weight - children : 0;
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::touch(const Node *node) noexcept {
+    node->weight.store(node->weight.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::discount(Node *node, uint64_t weight) noexcept {
+    const uint64_t current = node->weight.load(std::memory_order_relaxed);
+    node->weight.store(current > weight ? current - weight : 0, std::memory_order_relaxed);
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::reweigh(Node *node, uint64_t self) noexcept {
+    node->weight.store(self + weightOf(node->left) + weightOf(node->right), std::memory_order_relaxed);
+}
+
+template <class T, class Node>
+int CBTree<T, Node>::rotation(const Node *node, bool left) noexcept {
+    /*
+     * With child c of node p, and inner the child of c towards p's other side:
+     *
+     * A single rotation raises c and its outer subtree by one level and lowers p and its other subtree by one,
+     * a gain of w(c) - w(inner) against a loss of w(p) - w(c).
+     *
+     * A double rotation raises inner by two levels and its subtrees by one, and lowers p and its other subtree by one,
+     * a gain of w(inner) + self(inner) against the same loss.
+     */
+    const Node *child = left ? node->left : node->right;
+    if (child == nullptr) return 0;
+
+    const uint64_t weight = weightOf(node), child_weight = weightOf(child);
+    // Neither rotation can gain more than twice the weight of child, check that before looking any deeper
+    if (3 * child_weight <= weight) return 0;
+
+    const Node *inner = left ? child->right : child->left;
+    const uint64_t inner_weight = weightOf(inner);
+    const uint64_t inner_gain = inner != nullptr ? inner_weight + selfWeight(inner) : 0;
+
+    // Lost bumps can leave a child heavier than its parent, or lighter than its own child, so never below zero
+    const uint64_t loss = weight > child_weight ? weight - child_weight : 0;
+    const uint64_t single_gain = child_weight > inner_weight ? child_weight - inner_weight : 0;
+
+    const bool single = single_gain > loss;
+    const bool twice = inner_gain > loss;
+    if (single && twice) return single_gain >= inner_gain ? 1 : 2;
+    return single ? 1 : twice ? 2 : 0;
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::leftRotation(Node *&node) noexcept {
+    Node *child = node->right;
+    const uint64_t self = selfWeight(node), child_self = selfWeight(child);
+
+    node->right = child->left;
+    child->left = node;
+
+    // Only node and child have new subtrees
+    reweigh(node, self);
+    reweigh(child, child_self);
+    node = child;
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::rightRotation(Node *&node) noexcept {
+    Node *child = node->left;
+    const uint64_t self = selfWeight(node), child_self = selfWeight(child);
+
+    node->left = child->right;
+    child->right = node;
+
+    reweigh(node, self);
+    reweigh(child, child_self);
+    node = child;
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::adjust(Node *&node, bool left) noexcept {
+    switch (rotation(node, left)) {
+        case 2:
+            // Raise the inner grandchild to be the child first
+            if (left) leftRotation(node->left);
+            else rightRotation(node->right);
+            // Fall through to raise it again
+        case 1:
+            if (left) rightRotation(node);
+            else leftRotation(node);
+            break;
+        default:
+            break;
+    }
+}
+
+template <class T, class Node>
+bool CBTree<T, Node>::contains(const T &value) noexcept {
+    return accessInternal(root, value, true);
+}
+
+template <class T, class Node>
+bool CBTree<T, Node>::accessInternal(Node *&node, const T &value, bool touched) noexcept {
+    if (node == nullptr) return false;
+    if (touched) touch(node);
+
+    auto cmp = compare(value, node->value);
+    if (cmp == 0) return true;
+
+    // Adjust on the way back up, so a node can climb more than one level per access
+    const bool found = accessInternal(cmp < 0 ? node->left : node->right, value, touched);
+    adjust(node, cmp < 0);
+    return found;
+}
+
+template <class T, class Node>
+bool CBTree<T, Node>::containsDeferred(const T &value) const noexcept {
+    const Node *parent = nullptr;
+    const Node *node = root;
+
+    // The counts drift slowly, so only one lookup in deferred_check_interval looks for rotations, picked by the
+    // count of the root. The rest only count.
+    bool checked = node != nullptr && weightOf(node) % deferred_check_interval == 0;
+    bool due = false;
+    while (node != nullptr) {
+        touch(node);
+
+        // Only the first rotation due matters, applyDeferred() goes over the whole path again
+        if (checked && parent != nullptr && rotation(parent, node == parent->left) != 0) {
+            due = true;
+            checked = false;
+        }
+
+        int cmp = compare(value, node->value);
+        if (cmp == 0) break;
+
+        parent = node;
+        node = cmp < 0 ? node->left : node->right;
+    }
+
+    // A miss is remembered by the last node on its path, which leads applyDeferred() down the same one
+    const Node *last = node != nullptr ? node : parent;
+    if (due && last != nullptr) {
+        // Readers only ever write these atomics and the counts. Avoid dirtying the flag's cache line when already set.
+        deferred[deferredSlot(last)].store(last, std::memory_order_relaxed);
+        if (!deferred_pending.load(std::memory_order_relaxed))
+            deferred_pending.store(true, std::memory_order_relaxed);
+    }
+    return node != nullptr;
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::applyDeferred() noexcept {
+    /*
+     * Adjust along the path to every recorded node, without counting it again.
+     *
+     * The caller has exclusive access, so relaxed loads are enough.
+     * Whatever lock gave that access also orders the readers' stores before this.
+     */
+    if (!deferred_pending.load(std::memory_order_relaxed)) return;
+    deferred_pending.store(false, std::memory_order_relaxed);
+
+    for (auto &slot : deferred) {
+        const Node *node = slot.exchange(nullptr, std::memory_order_relaxed);
+        if (node != nullptr) accessInternal(root, node->value, false);
+    }
+}
+
+template <class T, class Node>
+bool CBTree<T, Node>::deferredPending() const noexcept {
+    return deferred_pending.load(std::memory_order_relaxed);
+}
+
+template <class T, class Node>
+size_t CBTree<T, Node>::deferredSlot(const Node *node) noexcept {
+    // Fibonacci hashing of the address. The low bits are mostly alignment.
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 32) % deferred_slots;
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::forgetDeferred(const Node *node) noexcept {
+    // A node can only be in its own slot
+    auto &slot = deferred[deferredSlot(node)];
+    if (slot.load(std::memory_order_relaxed) == node)
+        slot.store(nullptr, std::memory_order_relaxed);
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::discardDeferred() noexcept {
+    for (auto &slot : deferred)
+        slot.store(nullptr, std::memory_order_relaxed);
+    deferred_pending.store(false, std::memory_order_relaxed);
+}
+
+template <class T, class Node>
+void CBTree<T, Node>::clear() noexcept {
+    discardDeferred();
+    BinaryTree<T, Node>::clear();
+}
+
+template <class T, class Node>
+bool CBTree<T, Node>::insertInternal(Node *&node, const T &value) {
+    // New values start with the one access inserting them
+    if (node == nullptr) {
+        node = new Node(value);
+        return true;
+    }
+    touch(node);
+
+    auto cmp = compare(value, node->value);
+    if (cmp == 0) return false;
+
+    const bool inserted = insertInternal(cmp < 0 ? node->left : node->right, value);
+    adjust(node, cmp < 0);
+    return inserted;
+}
+
+template <class T, class Node>
+bool CBTree<T, Node>::removeInternal(Node *&node, const T &value) {
+    uint64_t removed;
+    return removeInternal(node, value, removed);
+}
+
+template <class T, class Node>
+bool CBTree<T, Node>::removeInternal(Node *&node, const T &value, uint64_t &removed) {
+    if (node == nullptr) return false;
+
+    auto cmp = compare(value, node->value);
+    if (cmp != 0) {
+        if (!removeInternal(cmp < 0 ? node->left : node->right, value, removed)) return false;
+
+        // Ancestors lose the accesses to the removed node
+        discount(node, removed);
+        return true;
+    }
+
+    Node *temp = node;
+    removed = selfWeight(temp);
+    if (temp->left == nullptr) {
+        node = temp->right;
+    } else if (temp->right == nullptr) {
+        node = temp->left;
+    } else {
+        // Relink the successor in place of node, so nodes never change value
+        Node *successor = popMostLeftInternal(temp->right);
+        successor->left = temp->left;
+        successor->right = temp->right;
+        reweigh(successor, weightOf(successor));
+        node = successor;
+    }
+
+    forgetDeferred(temp);
+    this->destroyNode(temp);
+    return true;
+}
+
+template <class T, class Node>
+Node* CBTree<T, Node>::popMostLeftInternal(Node *&node) {
+    if (node->left != nullptr) {
+        Node *temp = popMostLeftInternal(node->left);
+        discount(node, weightOf(temp));
+        return temp;
+    }
+
+    // Return node, but remove from tree.
+    Node *temp = node;
+    temp->weight.store(selfWeight(temp), std::memory_order_relaxed);
+    forgetDeferred(temp);
+    node = node->right;
+    return temp;
+}
+
+template <class T, class Node>
+Node* CBTree<T, Node>::popMostRightInternal(Node *&node) {
+    if (node->right != nullptr) {
+        Node *temp = popMostRightInternal(node->right);
+        discount(node, weightOf(temp));
+        return temp;
+    }
+
+    // Return node, but remove from tree.
+    Node *temp = node;
+    temp->weight.store(selfWeight(temp), std::memory_order_relaxed);
+    forgetDeferred(temp);
+    node = node->left;
+    return temp;
+}
+#endif //CBTREE_CPP
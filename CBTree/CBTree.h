@@ -0,0 +1,136 @@
+/*
+ * Implementation of a counter based self adjusting tree, that ignores duplicate entries
+ *
+ * Each node counts the accesses to its subtree. A node is rotated above its parent only when the counts show that
+ * lowers the total depth of the accesses, so hot values drift to the top like in a SplayTree, but the tree stops
+ * changing once it fits the access pattern instead of restructuring on every lookup.
+ *
+ * That makes it a good fit for sharing between threads under a reader-writer lock. containsDeferred() is const, and
+ * only bumps the counts, with relaxed atomics, on its way down. When the counts call for a rotation along the way it
+ * remembers the node, for a writer to adjust later with applyDeferred(). The counts are approximate, as bumps that
+ * race each other may be lost, which only ever costs some accuracy in where nodes end up.
+ *
+ * Based on "CBTree: A Practical Concurrent Self-Adjusting Search Tree" by Afek, Kaplan, Korenfeld, Morrison and Tarjan.
+ */
+#ifndef CBTREE_H
+#define CBTREE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "../binaryTree.h"
+
+template <class T>
+struct CBTreeNode {
+    // Public reference to T for reference
+    using value_type = T;
+
+    explicit CBTreeNode(const T &value): left(nullptr), right(nullptr), weight(1), value(value) {}
+
+    // Copy constructor
+    CBTreeNode(const CBTreeNode &node):
+        left(node.left), right(node.right), weight(node.weight.load(std::memory_order_relaxed)), value(node.value) {}
+
+    CBTreeNode *left;
+    CBTreeNode *right;
+
+    // Accesses to this subtree, including this node's own, bumped by readers
+    mutable std::atomic<uint64_t> weight;
+
+    T value;
+};
+
+template <class T, class Node = CBTreeNode<T>>
+class CBTree: virtual public BinaryTree<T, Node> {
+  public:
+    using value_type = T;
+
+    // Number of distinct nodes containsDeferred() can remember between calls to applyDeferred()
+    static constexpr size_t deferred_slots = 64;
+
+    // containsDeferred() looks for rotations due on one lookup in this many
+    static constexpr uint64_t deferred_check_interval = 8;
+
+  protected:
+    using BinaryTree<T, Node>::root;
+    using BinaryTree<T, Node>::count;
+    using BinaryTree<T, Node>::compare;
+
+    static uint64_t weightOf(const Node *node) noexcept {
+        return node != nullptr ? node->weight.load(std::memory_order_relaxed) : 0;
+    }
+    // Accesses to node itself. Lost bumps can leave a parent lighter than its children, so never below zero.
+    static uint64_t selfWeight(const Node *node) noexcept;
+    // Count an access. A plain load and store rather than an atomic add, so readers never wait on each other.
+    static void touch(const Node *node) noexcept;
+    static void discount(Node *node, uint64_t weight) noexcept;
+    static void reweigh(Node *node, uint64_t self) noexcept;
+
+    /*
+     * Whether to raise the child of node on side left, or that child's inner child, above node.
+     * Returns 1 for a single rotation, 2 for a double, and 0 when neither would lower the total depth of the
+     * accesses counted so far.
+     */
+    static int rotation(const Node *node, bool left) noexcept;
+
+    static void leftRotation(Node *&node) noexcept;
+    static void rightRotation(Node *&node) noexcept;
+    // Rotate the child of node on side left up, if the counts call for it
+    static void adjust(Node *&node, bool left) noexcept;
+
+    /**
+     * Search for value, adjusting each node on the way back up.
+     * Counts the access if touched is true.
+     */
+    bool accessInternal(Node *&node, const T &value, bool touched) noexcept;
+
+    bool insertInternal(Node *&node, const T &value);
+    bool removeInternal(Node *&node, const T &value);
+    // As removeInternal(), also giving the weight taken out with the node
+    bool removeInternal(Node *&node, const T &value, uint64_t &removed);
+    // The popped node's weight is left as its own accesses
+    Node* popMostLeftInternal(Node *&node);
+    Node* popMostRightInternal(Node *&node);
+
+    /*
+     * Deferred adjustments, as in SplayTree.
+     *
+     * Each node found by containsDeferred() hashes to one slot, and overwrites whatever was there.
+     * Nodes are never dereferenced until applyDeferred(), so removing a node only has to clear its slot.
+     */
+    mutable std::array<std::atomic<const Node*>, deferred_slots> deferred;
+    // Set when any slot may be filled, so applyDeferred() is cheap when there is nothing to do
+    mutable std::atomic<bool> deferred_pending;
+
+    static size_t deferredSlot(const Node *node) noexcept;
+    void forgetDeferred(const Node *node) noexcept;
+    void discardDeferred() noexcept;
+
+  public:
+    using BinaryTree<T, Node>::empty;
+
+    explicit CBTree(int (*compare)(const T &a, const T &b) = default_compare);
+
+    // Copy constructor
+    CBTree(const CBTree &tree);
+
+    // Assignment constructor
+    CBTree& operator=(const CBTree &tree);
+
+    // Counts the access and adjusts the tree right away
+    bool contains(const T &value) noexcept override;
+
+    // Search without changing the tree, only counting the access, and remembering nodes due to be adjusted.
+    // Safe to call from many threads at once, as long as no thread modifies the tree at the same time.
+    bool containsDeferred(const T &value) const noexcept;
+
+    // Adjust the nodes remembered by containsDeferred(). Must not run alongside any reader.
+    void applyDeferred() noexcept;
+
+    // Whether applyDeferred() has anything to do, cheap enough to check after every read
+    bool deferredPending() const noexcept;
+
+    void clear() noexcept override;
+};
+#include "CBTree.cpp"
+#endif //CBTREE_H
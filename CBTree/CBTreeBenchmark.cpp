@@ -0,0 +1,91 @@
+/*
+ * Performance Benchmark for CBTree against SplayTree, both shared between threads
+ * Lookups follow a Zipf distribution, so a few values take most of them, with a trickle of writes.
+ *
+ * g++ CBTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o CBTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <shared_mutex>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "CBTree.h"
+#include "../SplayTree/splayTree.h"
+#include "../util/tree_benchmark.h"
+
+// Readers share the lock, and whichever finds adjustments waiting applies them if no one else holds it
+template <class T>
+class SharedCBTree {
+  public:
+    bool contains(const T &value) {
+        bool found;
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex);
+            found = tree.containsDeferred(value);
+        }
+        if (tree.deferredPending()) {
+            std::unique_lock<std::shared_timed_mutex> lock(mutex, std::try_to_lock);
+            if (lock.owns_lock()) tree.applyDeferred();
+        }
+        return found;
+    }
+
+    bool insert(const T &value) {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        tree.applyDeferred();
+        return tree.insert(value);
+    }
+
+    bool remove(const T &value) {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        tree.applyDeferred();
+        return tree.remove(value);
+    }
+
+  protected:
+    std::shared_timed_mutex mutex;
+    CBTree<T> tree;
+};
+
+// Zipf distributed values in [0, range), with the hot ones spread over the range rather than all at the start
+class ZipfValues {
+  public:
+    explicit ZipfValues(int range): values(1 << 20) {
+        std::vector<double> cumulative(range);
+        double total = 0;
+        for (int i = 0; i < range; i++) cumulative[i] = total += 1.0 / (i + 1);
+
+        std::vector<int> shuffled(range);
+        for (int i = 0; i < range; i++) shuffled[i] = i;
+        std::minstd_rand generator(0);
+        std::shuffle(shuffled.begin(), shuffled.end(), generator);
+
+        // Drawn once up front, so the threads only pick from them
+        std::uniform_real_distribution<double> distribution(0, total);
+        for (int &value : values) {
+            const auto rank = std::lower_bound(cumulative.begin(), cumulative.end(), distribution(generator));
+            value = shuffled[std::min<size_t>(rank - cumulative.begin(), range - 1)];
+        }
+    }
+
+    int operator()(std::minstd_rand &generator) const {
+        return values[generator() % values.size()];
+    }
+
+  private:
+    std::vector<int> values;
+};
+
+BENCHMARK_TEMPLATE(BM_ReadMostly, LockedTree<SplayTree<int>>, ZipfValues)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, LockedTree<CBTree<int>>, ZipfValues)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, SharedCBTree<int>, ZipfValues)->THREADED_TESTS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,182 @@
+/*
+ * Test cases for testing the sanity of the CBTree
+ */
+
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <shared_mutex>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "CBTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+// Exposes the nodes and the rotation choice, to set up counts no sequence of accesses gives reliably
+struct SkewedCBTree: CBTree<int> {
+    using CBTree<int>::root;
+    using CBTree<int>::rotation;
+};
+
+int main() {
+    cout << "CBTree Tests" << endl;
+    test_set<CBTree<int>>();
+
+    bool passed = true;
+    {
+        // Sequential inserts always add to the right edge, the counts of the inserts alone keep the tree shallow
+        CBTree<int> tree;
+        for (int i = 0; i < 10000; i++) tree.insert(i);
+        tree.sanityCheck();
+        passed &= tree.size() == 10000 && tree.getHeight() <= 40;
+
+        // A value looked up more than all the rest together rises to the top, and stays there
+        for (int i = 0; i < 20000; i++) passed &= tree.contains(1234);
+        passed &= tree.getRoot() == 1234;
+        for (int i = 0; i < 10000; i++) passed &= tree.contains(i);
+        passed &= tree.getRoot() == 1234;
+        tree.sanityCheck();
+    }
+    cout << "Adjust Check               : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        CBTree<int> tree;
+        for (int i = 0; i < 1000; i++) tree.insert(i);
+        const int root = tree.getRoot();
+        const int hot = root == 700 ? 300 : 700;
+
+        // Deferred lookups only count, the tree changes once the adjustments are applied
+        const CBTree<int> &reader = tree;
+        passed &= !CBTree<int>().containsDeferred(0);
+        for (int i = 0; i < 1000; i++) passed &= reader.containsDeferred(hot);
+        passed &= !reader.containsDeferred(-1) && !reader.containsDeferred(1000);
+        passed &= tree.getRoot() == root && tree.deferredPending();
+        tree.applyDeferred();
+        passed &= tree.getRoot() == hot && !tree.deferredPending();
+        tree.sanityCheck();
+
+        // Removing a remembered node forgets it
+        for (int i = 0; i < 1000; i++) reader.containsDeferred(999);
+        passed &= tree.remove(999) && tree.popMostLeft() == 0;
+        tree.applyDeferred();
+        passed &= tree.size() == 998 && !tree.contains(999);
+        tree.sanityCheck();
+
+        // So do copies and clearing
+        for (int i = 0; i < 1000; i++) reader.containsDeferred(500);
+        CBTree<int> copy = tree;
+        copy.applyDeferred();
+        passed &= !copy.deferredPending() && tree.deferredPending();
+        tree.clear();
+        tree.applyDeferred();
+        passed &= tree.empty();
+        copy.sanityCheck();
+    }
+    cout << "Deferred Check             : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Lost bumps leave a child lighter than its inner child, and heavier than its parent
+        SkewedCBTree tree;
+        for (int i : {4, 2, 6, 1, 3, 5, 7}) tree.insert(i);
+        CBTreeNode<int> *node = tree.root, *child = node->left, *inner = child->right;
+        passed &= node->value == 4 && child->value == 2 && inner->value == 3;
+        node->weight = 0;
+        child->weight = 5;
+        inner->weight = 9;
+
+        // Raising child would lower inner, so only the double rotation gains
+        passed &= SkewedCBTree::rotation(node, true) == 2;
+
+        passed &= tree.contains(3) && tree.contains(1) && !tree.contains(0);
+        passed &= iteratorEquals(tree.inorder_begin(), tree.inorder_end(), {1, 2, 3, 4, 5, 6, 7});
+        tree.sanityCheck();
+    }
+    cout << "Skewed Weight Check        : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Random churn against std::set, skewed so the tree keeps adjusting, and with deferred lookups
+        CBTree<int> tree;
+        set<int> reference;
+        srand(0);
+        for (int i = 0; i < 100000; i++) {
+            const int value = rand() % 2 ? rand() % 50 : rand() % 5000;
+            switch (rand() % 4) {
+                case 0:
+                    passed &= tree.insert(value) == reference.insert(value).second;
+                    break;
+                case 1:
+                    passed &= tree.remove(value) == (reference.erase(value) != 0);
+                    break;
+                case 2:
+                    passed &= tree.contains(value) == (reference.count(value) != 0);
+                    break;
+                default:
+                    passed &= tree.containsDeferred(value) == (reference.count(value) != 0);
+                    if (i % 16 == 0) tree.applyDeferred();
+                    break;
+            }
+            if (i % 1000 == 0) tree.sanityCheck();
+        }
+        tree.sanityCheck();
+        passed &= tree.size() == reference.size();
+        passed &= equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end());
+
+        while (!reference.empty()) {
+            passed &= tree.popMostRight() == *reference.rbegin();
+            reference.erase(prev(reference.end()));
+        }
+        passed &= tree.empty();
+    }
+    cout << "Deferred Churn Check       : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Readers share the tree under a reader-writer lock, while a writer churns the odd values and adjusts
+        CBTree<int> tree;
+        shared_timed_mutex lock;
+        for (int i = 0; i < 2000; i++) tree.insert(i);
+
+        const int readers = 4;
+        atomic<int> finished(0);
+        atomic<bool> failed(false);
+        vector<thread> workers;
+        for (int t = 0; t < readers; t++) {
+            workers.emplace_back([&tree, &lock, &finished, &failed, t]() {
+                unsigned seed = t;
+                for (int i = 0; i < 50000; i++) {
+                    // Even values are never removed
+                    const int value = (rand_r(&seed) % 2 ? rand_r(&seed) % 20 : rand_r(&seed) % 1000) * 2;
+                    shared_lock<shared_timed_mutex> guard(lock);
+                    if (!tree.containsDeferred(value)) failed = true;
+                }
+                finished++;
+            });
+        }
+
+        // Readers may starve the writer, so it writes for as long as they read rather than a set number of times
+        set<int> odd;
+        for (int i = 1; i < 2000; i += 2) odd.insert(i);
+        for (int i = 0; finished < readers; i++) {
+            unique_lock<shared_timed_mutex> guard(lock);
+            const int value = (i % 1000) * 2 + 1;
+            passed &= i % 2000 < 1000 ? tree.remove(value) == (odd.erase(value) != 0)
+                                      : tree.insert(value) == odd.insert(value).second;
+            tree.applyDeferred();
+        }
+        for (thread &worker : workers) worker.join();
+
+        passed &= !failed && tree.size() == 1000 + odd.size();
+        tree.sanityCheck();
+    }
+    cout << "Concurrent Check           : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,770 @@
+#ifndef CONCURRENTAVLTREE_CPP
+#define CONCURRENTAVLTREE_CPP
+
+#include <algorithm>
+#include "ConcurrentAVLTree.h"
+
+template <class T>
+void ConcurrentAVLTree<T>::destroyNode(void *node) noexcept {
+    delete static_cast<Node*>(node);
+}
+
+template <class T>
+void ConcurrentAVLTree<T>::waitUntilNotShrinking(Node *node) noexcept {
+    // Rotations are short, so spin for a while first
+    for (int spins = 0; spins < 100; spins++) {
+        if (!(node->version.load() & shrinking)) return;
+    }
+
+    // The rotating thread holds the lock until it is done
+    std::lock_guard<std::mutex> lock(node->lock);
+}
+
+template <class T>
+ConcurrentAVLTree<T>::ConcurrentAVLTree(int (*compare)(const T &a, const T &b)):
+    compare(compare), holder(T(), nullptr), count(0) {}
+
+template <class T>
+ConcurrentAVLTree<T>::ConcurrentAVLTree(const ConcurrentAVLTree &tree): ConcurrentAVLTree(tree.compare) {
+    *this = tree;
+}
+
+template <class T>
+ConcurrentAVLTree<T>& ConcurrentAVLTree<T>::operator=(const ConcurrentAVLTree &tree) {
+    if (this == &tree) return *this;
+
+    clear();
+    compare = tree.compare;
+    for (auto it = tree.inorder_begin(); it != tree.inorder_end(); ++it) {
+        insert(*it);
+    }
+    return *this;
+}
+
+template <class T>
+ConcurrentAVLTree<T>::~ConcurrentAVLTree() {
+    clear();
+}
+
+template <class T>
+bool ConcurrentAVLTree<T>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the tree.
+     *
+     * Takes no locks. A step that a rotation may have invalidated is retried from the node before it.
+     */
+    EpochReclaimer::Guard guard;
+
+    while (true) {
+        Node *root = holder.right.load(std::memory_order_acquire);
+        if (root == nullptr) return false;
+
+        const int cmp = compare(value, root->value);
+        if (cmp == 0) return root->present.load(std::memory_order_acquire);
+
+        const uint64_t version = root->version.load(std::memory_order_acquire);
+        if (isShrinkingOrUnlinked(version)) {
+            waitUntilNotShrinking(root);
+        } else if (root == holder.right.load(std::memory_order_acquire)) {
+            const Result result = attemptContains(value, root, cmp, version);
+            if (result != retry) return result == succeeded;
+        }
+    }
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Result ConcurrentAVLTree<T>::attemptContains(
+        const T &value, Node *node, int cmp, uint64_t version) const noexcept {
+    /**
+     * Search below node, which was reached while it had version.
+     * Returns retry if node has since shrunk, and the search must restart from its parent.
+     */
+    while (true) {
+        Node *child = node->child(cmp).load(std::memory_order_acquire);
+        if (child == nullptr) {
+            if (node->version.load(std::memory_order_acquire) != version) return retry;
+            return failed;
+        }
+
+        // Values never move between nodes, so a match needs no validation
+        const int child_cmp = compare(value, child->value);
+        if (child_cmp == 0) return child->present.load(std::memory_order_acquire) ? succeeded : failed;
+
+        const uint64_t child_version = child->version.load(std::memory_order_acquire);
+        if (isShrinkingOrUnlinked(child_version)) {
+            waitUntilNotShrinking(child);
+            if (node->version.load(std::memory_order_acquire) != version) return retry;
+        } else if (child != node->child(cmp).load(std::memory_order_acquire)) {
+            if (node->version.load(std::memory_order_acquire) != version) return retry;
+        } else {
+            // Once child is validated, changes to node no longer matter
+            if (node->version.load(std::memory_order_acquire) != version) return retry;
+            const Result result = attemptContains(value, child, child_cmp, child_version);
+            if (result != retry) return result;
+        }
+    }
+}
+
+template <class T>
+bool ConcurrentAVLTree<T>::insert(const T &value) {
+    return update(value, true);
+}
+
+template <class T>
+bool ConcurrentAVLTree<T>::remove(const T &value) {
+    return update(value, false);
+}
+
+template <class T>
+bool ConcurrentAVLTree<T>::update(const T &value, const bool insert) {
+    /**
+     * Insert or remove value. Returns false if it was already present, or already absent.
+     */
+    EpochReclaimer::Guard guard;
+
+    while (true) {
+        Node *root = holder.right.load();
+        if (root == nullptr) {
+            if (!insert) return false;
+            const Result result = attemptInsertIntoEmpty(value);
+            if (result != retry) return result == succeeded;
+        } else {
+            const uint64_t version = root->version.load();
+            if (isShrinkingOrUnlinked(version)) {
+                waitUntilNotShrinking(root);
+            } else if (root == holder.right.load()) {
+                const Result result = attemptUpdate(value, insert, &holder, root, version);
+                if (result != retry) return result == succeeded;
+            }
+        }
+    }
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Result ConcurrentAVLTree<T>::attemptInsertIntoEmpty(const T &value) {
+    std::lock_guard<std::mutex> lock(holder.lock);
+    if (holder.right.load() != nullptr) return retry;
+
+    Node *node = new Node(value, &holder);
+    count.fetch_add(1, std::memory_order_relaxed);
+    holder.right.store(node);
+    holder.height.store(2);
+    return succeeded;
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Result ConcurrentAVLTree<T>::attemptUpdate(
+        const T &value, const bool insert, Node *parent, Node *node, uint64_t version) {
+    /**
+     * Insert or remove value below node, which was reached from parent while it had version.
+     */
+    const int cmp = compare(value, node->value);
+    if (cmp == 0) return attemptNodeUpdate(insert, parent, node);
+
+    while (true) {
+        Node *child = node->child(cmp).load();
+        if (node->version.load() != version) return retry;
+
+        if (child == nullptr) {
+            // value is not in the tree
+            if (!insert) return failed;
+
+            Node *damaged;
+            {
+                std::lock_guard<std::mutex> lock(node->lock);
+                // Holding the lock, no further rotation can change node
+                if (node->version.load() != version) return retry;
+                // Lost a race with another insert, so look again
+                if (node->child(cmp).load() != nullptr) continue;
+
+                Node *created = new Node(value, node);
+                count.fetch_add(1, std::memory_order_relaxed);
+                node->child(cmp).store(created);
+                damaged = fixHeightLocked(node);
+            }
+            fixHeightAndRebalance(damaged);
+            return succeeded;
+        }
+
+        const uint64_t child_version = child->version.load();
+        if (isShrinkingOrUnlinked(child_version)) {
+            waitUntilNotShrinking(child);
+        } else if (child == node->child(cmp).load()) {
+            if (node->version.load() != version) return retry;
+            const Result result = attemptUpdate(value, insert, node, child, child_version);
+            if (result != retry) return result;
+        }
+    }
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Result ConcurrentAVLTree<T>::attemptNodeUpdate(const bool insert, Node *parent, Node *node) {
+    /**
+     * Insert or remove the value of node, a child of parent.
+     */
+    if (!insert) {
+        if (!node->present.load()) return failed;
+
+        if (node->left.load() == nullptr || node->right.load() == nullptr) {
+            // node can be unlinked rather than left as a routing node, which needs its parent locked too
+            Node *damaged;
+            {
+                std::lock_guard<std::mutex> parent_lock(parent->lock);
+                if (isUnlinked(parent->version.load()) || node->parent.load() != parent) return retry;
+                {
+                    std::lock_guard<std::mutex> node_lock(node->lock);
+                    if (!node->present.load()) return failed;
+                    if (!attemptUnlinkLocked(parent, node)) return retry;
+                }
+                count.fetch_sub(1, std::memory_order_relaxed);
+                damaged = fixHeightLocked(parent);
+            }
+            fixHeightAndRebalance(damaged);
+            return succeeded;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(node->lock);
+    if (isUnlinked(node->version.load())) return retry;
+    if (node->present.load() == insert) return failed;
+
+    // A child went since it was checked, so node should be unlinked instead
+    if (!insert && (node->left.load() == nullptr || node->right.load() == nullptr)) return retry;
+
+    if (insert) {
+        count.fetch_add(1, std::memory_order_relaxed);
+        node->present.store(true);
+    } else {
+        node->present.store(false);
+        count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return succeeded;
+}
+
+template <class T>
+bool ConcurrentAVLTree<T>::attemptUnlinkLocked(Node *parent, Node *node) {
+    /**
+     * Splice node, which has at most one child, out from under parent.
+     * Returns false if node is no longer a child of parent, or has gained a second child.
+     */
+    Node *parent_left = parent->left.load();
+    Node *parent_right = parent->right.load();
+    if (parent_left != node && parent_right != node) return false;
+
+    Node *left = node->left.load();
+    Node *right = node->right.load();
+    if (left != nullptr && right != nullptr) return false;
+
+    Node *splice = left != nullptr ? left : right;
+    (parent_left == node ? parent->left : parent->right).store(splice);
+    if (splice != nullptr) splice->parent.store(parent);
+
+    node->version.store(unlinked);
+    node->present.store(false);
+
+    // Readers may still be passing through it
+    EpochReclaimer::retire(node, &ConcurrentAVLTree::destroyNode);
+    return true;
+}
+
+template <class T>
+int ConcurrentAVLTree<T>::nodeCondition(Node *node) noexcept {
+    /**
+     * What node needs to be repaired. Either a new height, or one of the constants.
+     *
+     * The reads are not atomic together, but anyone who changes node after them takes on repairing it,
+     * so nothing_required is always safe to act on.
+     */
+    Node *left = node->left.load();
+    Node *right = node->right.load();
+    if ((left == nullptr || right == nullptr) && !node->present.load()) return unlink_required;
+
+    const int node_height = node->height.load();
+    const int left_height = height(left);
+    const int right_height = height(right);
+
+    const int balance = left_height - right_height;
+    if (balance < -1 || balance > 1) return rebalance_required;
+
+    const int replacement = 1 + std::max(left_height, right_height);
+    return node_height != replacement ? replacement : nothing_required;
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::fixHeightLocked(Node *node) noexcept {
+    /**
+     * Repair the height of node if that is all it needs.
+     * Returns the next node needing repair, node itself if it needs more than a height, or nullptr.
+     */
+    const int condition = nodeCondition(node);
+    switch (condition) {
+        case rebalance_required:
+        case unlink_required:
+            return node;
+        case nothing_required:
+            return nullptr;
+        default:
+            node->height.store(condition);
+            // The parent's height may now be wrong
+            return node->parent.load();
+    }
+}
+
+template <class T>
+void ConcurrentAVLTree<T>::fixHeightAndRebalance(Node *node) {
+    /**
+     * Repair node, then its ancestors, until nothing more is needed.
+     * Heights only need node locked. Rotations and unlinks need the parent locked as well.
+     */
+    while (node != nullptr && node->parent.load() != nullptr) {
+        const int condition = nodeCondition(node);
+        // Either fine, or nothing to repair any more
+        if (condition == nothing_required || isUnlinked(node->version.load())) return;
+
+        if (condition != unlink_required && condition != rebalance_required) {
+            std::lock_guard<std::mutex> lock(node->lock);
+            node = fixHeightLocked(node);
+        } else {
+            Node *parent = node->parent.load();
+            std::lock_guard<std::mutex> parent_lock(parent->lock);
+            // Otherwise node has moved, so try again
+            if (!isUnlinked(parent->version.load()) && node->parent.load() == parent) {
+                std::lock_guard<std::mutex> node_lock(node->lock);
+                node = rebalanceLocked(parent, node);
+            }
+        }
+    }
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::rebalanceLocked(Node *parent, Node *node) {
+    /**
+     * Unlink, rotate or fix the height of node, with parent and node locked.
+     * Returns the next node needing repair, or nullptr.
+     *
+     * The rebalance functions lock the children and grandchildren they rotate, below the two locks already held.
+     * As in Bronson et al.'s protocol every lock is taken parent before child, and a child is only locked after it
+     * was read from its parent under the parent's lock, which no one can relink without that lock. So a thread
+     * only ever waits on a node below every node it holds, and no cycle of waits can form. A rotation does make
+     * a child the parent of its old parent, and ThreadSanitizer sees the same two locks taken in both orders at
+     * different times, here and where attemptNodeUpdate() locks a parent and then the child it unlinks.
+     * ConcurrentAVLTree/tsan.supp suppresses those reports.
+     */
+    Node *left = node->left.load();
+    Node *right = node->right.load();
+    if ((left == nullptr || right == nullptr) && !node->present.load()) {
+        if (attemptUnlinkLocked(parent, node)) return fixHeightLocked(parent);
+        return node;
+    }
+
+    const int node_height = node->height.load();
+    const int left_height = height(left);
+    const int right_height = height(right);
+    const int balance = left_height - right_height;
+
+    if (balance >= 2) {
+        // Left is too much taller than right, shift the tree right
+        return rebalanceToRightLocked(parent, node, left, right_height);
+    } else if (balance <= -2) {
+        // Right is too much taller than left, shift the tree left
+        return rebalanceToLeftLocked(parent, node, right, left_height);
+    }
+
+    const int replacement = 1 + std::max(left_height, right_height);
+    if (node_height != replacement) {
+        node->height.store(replacement);
+        return fixHeightLocked(parent);
+    }
+    return nullptr;
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::rebalanceToRightLocked(
+        Node *parent, Node *node, Node *left, int right_height) {
+    /**
+     * Rotate right about node, choosing the case as AVLTree::rightRotation does.
+     */
+    std::lock_guard<std::mutex> left_lock(left->lock);
+    const int left_height = left->height.load();
+    // Already repaired by someone else
+    if (left_height - right_height <= 1) return node;
+
+    Node *left_right = left->right.load();
+    const int left_left_height = height(left->left.load());
+    int left_right_height = height(left_right);
+
+    // The outer case, taken on a tie too, to avoid the odd case that occurs during removals
+    if (left_left_height >= left_right_height)
+        return rotateRightLocked(parent, node, left, right_height, left_left_height, left_right, left_right_height);
+
+    {
+        std::lock_guard<std::mutex> left_right_lock(left_right->lock);
+        // Heights read before the lock may be out of date
+        left_right_height = left_right->height.load();
+        if (left_left_height >= left_right_height)
+            return rotateRightLocked(parent, node, left, right_height, left_left_height, left_right, left_right_height);
+
+        // The inner case, unless it would leave left out of balance
+        const int left_right_left_height = height(left_right->left.load());
+        const int balance = left_left_height - left_right_left_height;
+        if (balance >= -1 && balance <= 1)
+            return rotateRightOverLeftLocked(parent, node, left, right_height,
+                                             left_left_height, left_right, left_right_left_height);
+    }
+
+    // Repair left on its own first, node is repaired after if it still needs it
+    return rebalanceToLeftLocked(node, left, left_right, left_left_height);
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::rebalanceToLeftLocked(
+        Node *parent, Node *node, Node *right, int left_height) {
+    /**
+     * Rotate left about node, choosing the case as AVLTree::leftRotation does.
+     */
+    std::lock_guard<std::mutex> right_lock(right->lock);
+    const int right_height = right->height.load();
+    // Already repaired by someone else
+    if (right_height - left_height <= 1) return node;
+
+    Node *right_left = right->left.load();
+    const int right_right_height = height(right->right.load());
+    int right_left_height = height(right_left);
+
+    // The outer case, taken on a tie too, to avoid the odd case that occurs during removals
+    if (right_right_height >= right_left_height)
+        return rotateLeftLocked(parent, node, right, left_height, right_right_height, right_left, right_left_height);
+
+    {
+        std::lock_guard<std::mutex> right_left_lock(right_left->lock);
+        // Heights read before the lock may be out of date
+        right_left_height = right_left->height.load();
+        if (right_right_height >= right_left_height)
+            return rotateLeftLocked(parent, node, right, left_height, right_right_height, right_left, right_left_height);
+
+        // The inner case, unless it would leave right out of balance
+        const int right_left_right_height = height(right_left->right.load());
+        const int balance = right_right_height - right_left_right_height;
+        if (balance >= -1 && balance <= 1)
+            return rotateLeftOverRightLocked(parent, node, right, left_height,
+                                             right_right_height, right_left, right_left_right_height);
+    }
+
+    // Repair right on its own first, node is repaired after if it still needs it
+    return rebalanceToRightLocked(node, right, right_left, right_right_height);
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::rotateRightLocked(
+        Node *parent, Node *node, Node *left, int right_height,
+        int left_left_height, Node *left_right, int left_right_height) noexcept {
+    /**
+     * The outer case of AVLTree::rightRotation, with parent, node and left locked.
+     *
+     *                    F  <- node
+     *                  /   \
+     *     left ->     D     G
+     *                / \
+     *               B   E  <- left_right
+     *
+     * becomes
+     *
+     *                    D
+     *                  /   \
+     *                 B     F
+     *                      / \
+     *                     E   G
+     *
+     * Returns the deepest node left needing repair, or nullptr.
+     */
+    const uint64_t version = node->version.load();
+    Node *parent_left = parent->left.load();
+
+    // Values under node are about to move up, so readers below it must retry
+    node->version.store(beginShrink(version));
+
+    node->left.store(left_right);
+    if (left_right != nullptr) left_right->parent.store(node);
+
+    left->right.store(node);
+    node->parent.store(left);
+
+    (parent_left == node ? parent->left : parent->right).store(left);
+    left->parent.store(parent);
+
+    const int node_height = 1 + std::max(left_right_height, right_height);
+    node->height.store(node_height);
+    left->height.store(1 + std::max(left_left_height, node_height));
+
+    node->version.store(endShrink(version));
+
+    // node is now the deepest damaged node, repair as much as the locks held allow
+    const int node_balance = left_right_height - right_height;
+    if (node_balance < -1 || node_balance > 1) return node;
+    if ((left_right == nullptr || right_height == 0) && !node->present.load()) return node;
+
+    const int left_balance = left_left_height - node_height;
+    if (left_balance < -1 || left_balance > 1) return left;
+    if (left_left_height == 0 && !left->present.load()) return left;
+
+    return fixHeightLocked(parent);
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::rotateLeftLocked(
+        Node *parent, Node *node, Node *right, int left_height,
+        int right_right_height, Node *right_left, int right_left_height) noexcept {
+    /**
+     * The outer case of AVLTree::leftRotation, with parent, node and right locked.
+     *
+     *                  B  <- node
+     *                /   \
+     *               A     D  <- right
+     *                    / \
+     *  right_left ->    C   F
+     *
+     * becomes
+     *
+     *                  D
+     *                /   \
+     *               B     F
+     *              / \
+     *             A   C
+     *
+     * Returns the deepest node left needing repair, or nullptr.
+     */
+    const uint64_t version = node->version.load();
+    Node *parent_left = parent->left.load();
+
+    // Values under node are about to move up, so readers below it must retry
+    node->version.store(beginShrink(version));
+
+    node->right.store(right_left);
+    if (right_left != nullptr) right_left->parent.store(node);
+
+    right->left.store(node);
+    node->parent.store(right);
+
+    (parent_left == node ? parent->left : parent->right).store(right);
+    right->parent.store(parent);
+
+    const int node_height = 1 + std::max(right_left_height, left_height);
+    node->height.store(node_height);
+    right->height.store(1 + std::max(right_right_height, node_height));
+
+    node->version.store(endShrink(version));
+
+    // node is now the deepest damaged node, repair as much as the locks held allow
+    const int node_balance = right_left_height - left_height;
+    if (node_balance < -1 || node_balance > 1) return node;
+    if ((right_left == nullptr || left_height == 0) && !node->present.load()) return node;
+
+    const int right_balance = right_right_height - node_height;
+    if (right_balance < -1 || right_balance > 1) return right;
+    if (right_right_height == 0 && !right->present.load()) return right;
+
+    return fixHeightLocked(parent);
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::rotateRightOverLeftLocked(
+        Node *parent, Node *node, Node *left, int right_height,
+        int left_left_height, Node *left_right, int left_right_left_height) noexcept {
+    /**
+     * The inner case of AVLTree::rightRotation, with parent, node, left and left_right locked.
+     *
+     *                   F  <- node
+     *                 /   \
+     *     left ->    B     G
+     *               / \
+     *              A   D  <- left_right
+     *                 / \
+     *                C   E
+     *
+     * becomes
+     *
+     *                   D
+     *                 /   \
+     *                B     F
+     *               / \   / \
+     *              A   C E   G
+     *
+     * Returns the deepest node left needing repair, or nullptr.
+     */
+    const uint64_t node_version = node->version.load();
+    const uint64_t left_version = left->version.load();
+    Node *parent_left = parent->left.load();
+    Node *left_right_left = left_right->left.load();
+    Node *left_right_right = left_right->right.load();
+    const int left_right_right_height = height(left_right_right);
+
+    // Both node and left lose values
+    node->version.store(beginShrink(node_version));
+    left->version.store(beginShrink(left_version));
+
+    left->right.store(left_right_left);
+    if (left_right_left != nullptr) left_right_left->parent.store(left);
+
+    node->left.store(left_right_right);
+    if (left_right_right != nullptr) left_right_right->parent.store(node);
+
+    left_right->right.store(node);
+    node->parent.store(left_right);
+    left_right->left.store(left);
+    left->parent.store(left_right);
+
+    (parent_left == node ? parent->left : parent->right).store(left_right);
+    left_right->parent.store(parent);
+
+    const int node_height = 1 + std::max(left_right_right_height, right_height);
+    node->height.store(node_height);
+    const int left_height = 1 + std::max(left_left_height, left_right_left_height);
+    left->height.store(left_height);
+    left_right->height.store(1 + std::max(left_height, node_height));
+
+    node->version.store(endShrink(node_version));
+    left->version.store(endShrink(left_version));
+
+    // The caller made sure left is balanced, so node is the deepest unbalanced node
+    const int node_balance = left_right_right_height - right_height;
+    if (node_balance < -1 || node_balance > 1) return node;
+
+    // Either may be a routing node left with a child to spare. left_right is locked, so unlink them now.
+    bool spliced = false;
+    if ((left_right_right == nullptr || right_height == 0) && !node->present.load())
+        spliced |= attemptUnlinkLocked(left_right, node);
+    if ((left_left_height == 0 || left_right_left_height == 0) && !left->present.load())
+        spliced |= attemptUnlinkLocked(left_right, left);
+    if (spliced) {
+        if (fixHeightLocked(left_right) == left_right) return left_right;
+        return fixHeightLocked(parent);
+    }
+
+    const int left_right_balance = left_height - node_height;
+    if (left_right_balance < -1 || left_right_balance > 1) return left_right;
+
+    return fixHeightLocked(parent);
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::Node* ConcurrentAVLTree<T>::rotateLeftOverRightLocked(
+        Node *parent, Node *node, Node *right, int left_height,
+        int right_right_height, Node *right_left, int right_left_right_height) noexcept {
+    /**
+     * The inner case of AVLTree::leftRotation, with parent, node, right and right_left locked.
+     *
+     *                  B  <- node
+     *                /   \
+     *               A     F  <- right
+     *                    / \
+     *  right_left ->    D   G
+     *                  / \
+     *                 C   E
+     *
+     * becomes
+     *
+     *                  D
+     *                /   \
+     *               B     F
+     *              / \   / \
+     *             A   C E   G
+     *
+     * Returns the deepest node left needing repair, or nullptr.
+     */
+    const uint64_t node_version = node->version.load();
+    const uint64_t right_version = right->version.load();
+    Node *parent_left = parent->left.load();
+    Node *right_left_right = right_left->right.load();
+    Node *right_left_left = right_left->left.load();
+    const int right_left_left_height = height(right_left_left);
+
+    // Both node and right lose values
+    node->version.store(beginShrink(node_version));
+    right->version.store(beginShrink(right_version));
+
+    right->left.store(right_left_right);
+    if (right_left_right != nullptr) right_left_right->parent.store(right);
+
+    node->right.store(right_left_left);
+    if (right_left_left != nullptr) right_left_left->parent.store(node);
+
+    right_left->left.store(node);
+    node->parent.store(right_left);
+    right_left->right.store(right);
+    right->parent.store(right_left);
+
+    (parent_left == node ? parent->left : parent->right).store(right_left);
+    right_left->parent.store(parent);
+
+    const int node_height = 1 + std::max(right_left_left_height, left_height);
+    node->height.store(node_height);
+    const int right_height = 1 + std::max(right_right_height, right_left_right_height);
+    right->height.store(right_height);
+    right_left->height.store(1 + std::max(right_height, node_height));
+
+    node->version.store(endShrink(node_version));
+    right->version.store(endShrink(right_version));
+
+    // The caller made sure right is balanced, so node is the deepest unbalanced node
+    const int node_balance = right_left_left_height - left_height;
+    if (node_balance < -1 || node_balance > 1) return node;
+
+    // Either may be a routing node left with a child to spare. right_left is locked, so unlink them now.
+    bool spliced = false;
+    if ((right_left_left == nullptr || left_height == 0) && !node->present.load())
+        spliced |= attemptUnlinkLocked(right_left, node);
+    if ((right_right_height == 0 || right_left_right_height == 0) && !right->present.load())
+        spliced |= attemptUnlinkLocked(right_left, right);
+    if (spliced) {
+        if (fixHeightLocked(right_left) == right_left) return right_left;
+        return fixHeightLocked(parent);
+    }
+
+    const int right_left_balance = right_height - node_height;
+    if (right_left_balance < -1 || right_left_balance > 1) return right_left;
+
+    return fixHeightLocked(parent);
+}
+
+template <class T>
+void ConcurrentAVLTree<T>::clearInternal(Node *node) noexcept {
+    if (node == nullptr) return;
+    clearInternal(node->left.load());
+    clearInternal(node->right.load());
+    delete node;
+}
+
+template <class T>
+void ConcurrentAVLTree<T>::clear() noexcept {
+    // Nothing else may be using the tree, so free directly. Unlinked nodes are already retired.
+    clearInternal(holder.right.load());
+    holder.right.store(nullptr);
+    holder.height.store(1);
+    count.store(0);
+}
+
+template <class T>
+bool ConcurrentAVLTree<T>::empty() const noexcept {
+    return count.load(std::memory_order_relaxed) == 0;
+}
+
+template <class T>
+size_t ConcurrentAVLTree<T>::size() const noexcept {
+    return count.load(std::memory_order_relaxed);
+}
+
+template <class T>
+size_t ConcurrentAVLTree<T>::getHeight() const noexcept {
+    return height(holder.right.load());
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::inorder_iterator ConcurrentAVLTree<T>::inorder_begin() const noexcept {
+    return inorder_iterator(holder.right.load());
+}
+
+template <class T>
+typename ConcurrentAVLTree<T>::inorder_iterator ConcurrentAVLTree<T>::inorder_end() const noexcept {
+    return inorder_iterator(nullptr);
+}
+#endif //CONCURRENTAVLTREE_CPP
@@ -0,0 +1,264 @@
+/*
+ * Implementation of a concurrent AVLTree, that ignores duplicate entries
+ *
+ * Follows Bronson, Casper, Chafi and Olukotun, "A Practical Concurrent Binary Search Tree" (PPoPP 2010).
+ * Readers take no locks. They walk down hand over hand, and validate each step against a version number on the
+ * node they came from, which changes whenever a rotation shrinks the range of values under that node.
+ * Writers lock only the nodes whose links they change, parent before child.
+ *
+ * The tree is partially external. Removing a value with two children below it only clears its presence, leaving
+ * a routing node that is unlinked once it has a child to spare. Heights are repaired and rotations made bottom up
+ * after each change, a node at a time, by whichever thread damaged the node.
+ * Rotations pick between the single and double cases by the same rule as AVLTree, the outer case when the outer
+ * grandchild is at least as tall.
+ *
+ * Unlinked nodes are freed through util/epoch_reclaimer.h, so readers never touch freed memory.
+ * contains(), insert() and remove() are safe to call from many threads at once. size() is exact once quiescent.
+ */
+#ifndef CONCURRENTAVLTREE_H
+#define CONCURRENTAVLTREE_H
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include "../binaryTree.h"
+#include "../util/epoch_reclaimer.h"
+
+template <class T>
+class ConcurrentAVLTree {
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+  protected:
+    struct Node {
+        const T value;
+
+        // False once value is removed, leaving a routing node
+        std::atomic<bool> present;
+        std::atomic<int> height;
+
+        /*
+         * Changed every time the range of values below the node shrinks, which only a rotation does.
+         * Odd once the node is unlinked, see the constants below.
+         */
+        std::atomic<uint64_t> version;
+
+        std::atomic<Node*> parent;
+        std::atomic<Node*> left;
+        std::atomic<Node*> right;
+
+        // Held by anyone changing the links out of the node
+        std::mutex lock;
+
+        Node(const T &value, Node *parent):
+            value(value), present(true), height(1), version(0), parent(parent), left(nullptr), right(nullptr) {}
+
+        // The child on the side of cmp, the result of comparing a value against this one
+        std::atomic<Node*>& child(int cmp) noexcept {return cmp < 0 ? left : right;}
+    };
+
+    static constexpr uint64_t unlinked = 1;
+    static constexpr uint64_t shrinking = 2;
+    static constexpr uint64_t shrink_increment = 4;
+
+    static bool isUnlinked(uint64_t version) noexcept {return version & unlinked;}
+    static bool isShrinkingOrUnlinked(uint64_t version) noexcept {return version & (unlinked | shrinking);}
+    static uint64_t beginShrink(uint64_t version) noexcept {return version | shrinking;}
+    static uint64_t endShrink(uint64_t version) noexcept {return (version | shrinking) + shrinking;}
+
+    // Spin, then block, until a rotation in progress at node is over
+    static void waitUntilNotShrinking(Node *node) noexcept;
+
+    static int height(const Node *node) noexcept {
+        return node == nullptr ? 0 : node->height.load(std::memory_order_acquire);
+    }
+
+    // Results of one optimistic attempt
+    enum Result {retry, failed, succeeded};
+
+    // What a node needs, if not a new height
+    static constexpr int unlink_required = -1;
+    static constexpr int rebalance_required = -2;
+    static constexpr int nothing_required = -3;
+
+    int (*compare)(const T &a, const T &b);
+
+    // Never removed. Its right child is the root, so the root has a parent to lock like every other node.
+    Node holder;
+    std::atomic<size_t> count;
+
+    static void destroyNode(void *node) noexcept;
+
+    Result attemptContains(const T &value, Node *node, int cmp, uint64_t version) const noexcept;
+
+    bool update(const T &value, bool insert);
+    Result attemptInsertIntoEmpty(const T &value);
+    Result attemptUpdate(const T &value, bool insert, Node *parent, Node *node, uint64_t version);
+    Result attemptNodeUpdate(bool insert, Node *parent, Node *node);
+
+    // Functions ending in Locked must hold the locks on the nodes they are given
+    static bool attemptUnlinkLocked(Node *parent, Node *node);
+
+    static int nodeCondition(Node *node) noexcept;
+    static Node* fixHeightLocked(Node *node) noexcept;
+    static void fixHeightAndRebalance(Node *node);
+
+    static Node* rebalanceLocked(Node *parent, Node *node);
+    static Node* rebalanceToRightLocked(Node *parent, Node *node, Node *left, int right_height);
+    static Node* rebalanceToLeftLocked(Node *parent, Node *node, Node *right, int left_height);
+    static Node* rotateRightLocked(Node *parent, Node *node, Node *left, int right_height,
+                                   int left_left_height, Node *left_right, int left_right_height) noexcept;
+    static Node* rotateLeftLocked(Node *parent, Node *node, Node *right, int left_height,
+                                  int right_right_height, Node *right_left, int right_left_height) noexcept;
+    static Node* rotateRightOverLeftLocked(Node *parent, Node *node, Node *left, int right_height,
+                                           int left_left_height, Node *left_right, int left_right_left_height) noexcept;
+    static Node* rotateLeftOverRightLocked(Node *parent, Node *node, Node *right, int left_height,
+                                           int right_right_height, Node *right_left, int right_left_right_height) noexcept;
+
+    static void clearInternal(Node *node) noexcept;
+
+  public:
+    explicit ConcurrentAVLTree(int (*compare)(const T &a, const T &b) = default_compare);
+
+    // Neither the copy, clear nor the destructor may run alongside other operations
+    ConcurrentAVLTree(const ConcurrentAVLTree &tree);
+    ConcurrentAVLTree& operator=(const ConcurrentAVLTree &tree);
+    ~ConcurrentAVLTree();
+
+    bool contains(const T &value) const noexcept;
+    bool insert(const T &value);
+    bool remove(const T &value);
+
+    void clear() noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    // Height of the tree, counting routing nodes
+    size_t getHeight() const noexcept;
+
+    /*
+     * Iteration is only for a quiescent tree, since a rotation can move values past an iterator.
+     * Routing nodes are skipped.
+     */
+    class inorder_iterator {
+        // Allow ConcurrentAVLTree to use the protected constructor
+        friend class ConcurrentAVLTree;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        inorder_iterator(const inorder_iterator &iter) = default;
+        inorder_iterator& operator=(const inorder_iterator &iter) = default;
+
+        // Prefix ++ overload
+        inorder_iterator& operator++() {
+            do {
+                step();
+            } while (!stack.empty() && !stack.back()->present.load(std::memory_order_relaxed));
+            return *this;
+        }
+
+        // Postfix ++ overload
+        inorder_iterator operator++(int) {
+            inorder_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const inorder_iterator &iter) const {
+            if (stack.empty() || iter.stack.empty()) return stack.empty() == iter.stack.empty();
+            return stack.back() == iter.stack.back();
+        }
+
+        bool operator!=(const inorder_iterator &iter) const {
+            return !operator==(iter);
+        }
+
+        T operator*() const {
+            if (stack.empty())
+                throw std::out_of_range("iterator has been exhausted");
+            return stack.back()->value;
+        }
+
+      protected:
+        explicit inorder_iterator(const Node *root) {
+            pushLeft(root);
+            if (!stack.empty() && !stack.back()->present.load(std::memory_order_relaxed)) ++*this;
+        }
+
+        void pushLeft(const Node *node) {
+            while (node != nullptr) {
+                stack.push_back(node);
+                node = node->left.load(std::memory_order_relaxed);
+            }
+        }
+
+        void step() {
+            const Node *node = stack.back();
+            stack.pop_back();
+            pushLeft(node->right.load(std::memory_order_relaxed));
+        }
+
+        // Path from the root to the current node, less the nodes already passed
+        std::vector<const Node*> stack;
+    };
+
+    inorder_iterator inorder_begin() const noexcept;
+    inorder_iterator inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong. The tree must be quiescent.
+    void sanityCheck() const {
+        const Node *root = holder.right.load();
+        if (root != nullptr && root->parent.load() != &holder)
+            throw std::logic_error("Root does not point back to the holder");
+
+        size_t sanity_count = 0;
+        sanityCheckInternal(root, nullptr, nullptr, sanity_count);
+        if (count.load() != sanity_count)
+            throw std::logic_error("ConcurrentAVLTree size does not match count of elements");
+    }
+
+  protected:
+    // Returns the height of node, checking it against its children
+    int sanityCheckInternal(const Node *node, const T *low, const T *high, size_t &sanity_count) const {
+        if (node == nullptr) return 0;
+
+        if (isShrinkingOrUnlinked(node->version.load()))
+            throw std::logic_error("Linked node is marked unlinked or shrinking");
+        if ((low != nullptr && compare(*low, node->value) >= 0) || (high != nullptr && compare(node->value, *high) >= 0))
+            throw std::logic_error("Values are not in order");
+
+        const Node *left = node->left.load(), *right = node->right.load();
+        if ((left != nullptr && left->parent.load() != node) || (right != nullptr && right->parent.load() != node))
+            throw std::logic_error("Child does not point back to its parent");
+
+        if (node->present.load()) {
+            sanity_count++;
+        } else if (left == nullptr || right == nullptr) {
+            throw std::logic_error("Routing node was not unlinked");
+        }
+
+        const int left_height = sanityCheckInternal(left, low, &node->value, sanity_count);
+        const int right_height = sanityCheckInternal(right, &node->value, high, sanity_count);
+        if (node->height.load() != 1 + std::max(left_height, right_height))
+            throw std::logic_error("Node has invalid height");
+        if (left_height - right_height > 1 || right_height - left_height > 1)
+            throw std::logic_error("Node is not balanced");
+        return node->height.load();
+    }
+#endif
+};
+
+#include "ConcurrentAVLTree.cpp"
+#endif //CONCURRENTAVLTREE_H
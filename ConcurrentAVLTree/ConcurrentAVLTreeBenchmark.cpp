@@ -0,0 +1,28 @@
+/*
+ * Performance Benchmark for ConcurrentAVLTree against AVLTree behind a mutex, and ConcurrentSkipList
+ * All threads share one tree, and make 20 lookups for every insert or remove.
+ *
+ * g++ ConcurrentAVLTreeBenchmark.cpp ../AVLTree/AVLTree.cpp ../binaryTree.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o ConcurrentAVLTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "ConcurrentAVLTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../ConcurrentSkipList/ConcurrentSkipList.h"
+#include "../util/tree_benchmark.h"
+
+BENCHMARK_TEMPLATE(BM_ReadMostly, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, ConcurrentSkipList<int>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, ConcurrentAVLTree<int>)->THREADED_TESTS;
+
+BENCHMARK_TEMPLATE(BM_Churn, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, ConcurrentSkipList<int>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, ConcurrentAVLTree<int>)->THREADED_TESTS;
+
+BENCHMARK_MAIN();
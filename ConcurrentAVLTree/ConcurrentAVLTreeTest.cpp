@@ -0,0 +1,70 @@
+/*
+ * Test cases for testing the sanity of the ConcurrentAVLTree
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "ConcurrentAVLTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "ConcurrentAVLTree Tests" << endl;
+    using Tree = ConcurrentAVLTree<int>;
+    cout << "Empty Check                : " << (check_empty<Tree>() ? "passed" : "failed") << endl;
+    cout << "Insert Remove Check        : " << (check_insert_remove<Tree>() ? "passed" : "failed") << endl;
+
+    bool passed = true;
+    {
+        Tree tree;
+        passed &= tree.getHeight() == 0;
+        for (int i : {5, 3, 8, 1, 4, 7, 9, 2, 6}) tree.insert(i);
+        passed &= tree.getHeight() == 4;
+
+        // 5 has two children, so stays as a routing node until reinserted
+        passed &= tree.remove(5) && !tree.remove(5) && tree.remove(1);
+        passed &= tree.size() == 7 && !tree.contains(5);
+        passed &= iteratorEquals(tree.inorder_begin(), tree.inorder_end(), {2, 3, 4, 6, 7, 8, 9});
+        tree.sanityCheck();
+        passed &= tree.insert(5) && tree.contains(5) && tree.remove(5);
+        tree.sanityCheck();
+    }
+    cout << "Routing Node Check         : " << (passed ? "passed" : "failed") << endl;
+    cout << "Churn Check                : " << (check_churn<Tree>() ? "passed" : "failed") << endl;
+
+    passed = check_concurrent_churn<Tree>();
+    {
+        Tree tree;
+        const int threads = 8, per_thread = 2000;
+        vector<thread> workers;
+        atomic<bool> failed(false);
+
+        // Many readers alongside a few writers, as contains takes no locks
+        for (int i = 0; i < threads * per_thread; i += 2) tree.insert(i);
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&tree, &failed, t]() {
+                for (int i = 0; i < 4 * per_thread; i++) {
+                    const int value = (i * 31 + t) % (threads * per_thread);
+                    if (t % 4 == 0) {
+                        // Only odd values change, even ones must always be found
+                        if (value % 2 != 0) {
+                            if (i % 2) tree.insert(value); else tree.remove(value);
+                        }
+                    } else if (value % 2 == 0 && !tree.contains(value)) {
+                        failed = true;
+                    }
+                }
+            });
+        }
+        for (thread &worker : workers) worker.join();
+        passed &= !failed;
+        tree.sanityCheck();
+    }
+    cout << "Concurrent Check           : " << (passed ? "passed" : "failed") << endl;
+}
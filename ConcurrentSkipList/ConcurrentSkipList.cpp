@@ -0,0 +1,305 @@
+#ifndef CONCURRENTSKIPLIST_CPP
+#define CONCURRENTSKIPLIST_CPP
+
+#include <new>
+#include "ConcurrentSkipList.h"
+
+template <class T>
+typename ConcurrentSkipList<T>::Node* ConcurrentSkipList<T>::createNode(const T &value, const unsigned height) {
+    void *memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+    Node *node = new (memory) Node(value, height);
+    for (unsigned level = 0; level < height; level++) {
+        new (&node->next()[level]) Link(0);
+    }
+    return node;
+}
+
+template <class T>
+void ConcurrentSkipList<T>::destroyNode(void *memory) noexcept {
+    // Links are trivially destructible
+    Node *node = static_cast<Node*>(memory);
+    node->~Node();
+    ::operator delete(memory);
+}
+
+template <class T>
+unsigned ConcurrentSkipList<T>::randomHeight() noexcept {
+    // xorshift, kept per thread so inserts do not contend on a generator
+    thread_local uint64_t state = 0x9e3779b97f4a7c15ULL ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    // Each trailing one bit is a coin toss won
+    return 1 + __builtin_ctzll(~state | (uint64_t(1) << (max_level - 1)));
+}
+
+template <class T>
+ConcurrentSkipList<T>::ConcurrentSkipList(int (*compare)(const T &a, const T &b)): compare(compare), count(0) {
+    for (Link &link : head) link.store(0, std::memory_order_relaxed);
+}
+
+template <class T>
+ConcurrentSkipList<T>::ConcurrentSkipList(const ConcurrentSkipList &list): ConcurrentSkipList(list.compare) {
+    *this = list;
+}
+
+template <class T>
+ConcurrentSkipList<T>& ConcurrentSkipList<T>::operator=(const ConcurrentSkipList &list) {
+    if (this == &list) return *this;
+
+    clear();
+    compare = list.compare;
+    for (auto it = list.inorder_begin(); it != list.inorder_end(); ++it) {
+        insert(*it);
+    }
+    return *this;
+}
+
+template <class T>
+ConcurrentSkipList<T>::~ConcurrentSkipList() {
+    // Nothing else may be using the list, so free directly. Removed nodes are already retired.
+    uintptr_t link = head[0].load(std::memory_order_acquire);
+    while (pointer(link) != nullptr) {
+        Node *node = pointer(link);
+        link = node->next()[0].load(std::memory_order_relaxed);
+        destroyNode(node);
+    }
+}
+
+template <class T>
+bool ConcurrentSkipList<T>::find(const T &value, Link *preds[], Node *succs[]) const noexcept {
+  retry:
+    Link *pred = const_cast<Link*>(head);
+    for (int level = max_level - 1; level >= 0; level--) {
+        Node *curr = pointer(pred[level].load(std::memory_order_acquire));
+        while (curr != nullptr) {
+            uintptr_t succ = curr->next()[level].load(std::memory_order_acquire);
+            while (marked(succ)) {
+                // curr is being removed, so unlink it here. If pred has changed, start over.
+                uintptr_t expected = makeLink(curr);
+                if (!pred[level].compare_exchange_strong(expected, makeLink(pointer(succ)), std::memory_order_acq_rel))
+                    goto retry;
+
+                curr = pointer(succ);
+                if (curr == nullptr) break;
+                succ = curr->next()[level].load(std::memory_order_acquire);
+            }
+
+            if (curr == nullptr || compare(curr->value, value) >= 0) break;
+            pred = curr->next();
+            curr = pointer(succ);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return succs[0] != nullptr && compare(succs[0]->value, value) == 0;
+}
+
+template <class T>
+bool ConcurrentSkipList<T>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the list.
+     *
+     * Steps over removed nodes rather than unlinking them, so it only ever reads.
+     */
+    EpochReclaimer::Guard guard;
+
+    const Link *pred = head;
+    const Node *curr = nullptr;
+    for (int level = max_level - 1; level >= 0; level--) {
+        curr = pointer(pred[level].load(std::memory_order_acquire));
+        while (curr != nullptr) {
+            uintptr_t succ = curr->next()[level].load(std::memory_order_acquire);
+            while (marked(succ)) {
+                curr = pointer(succ);
+                if (curr == nullptr) break;
+                succ = curr->next()[level].load(std::memory_order_acquire);
+            }
+
+            if (curr == nullptr || compare(curr->value, value) >= 0) break;
+            pred = curr->next();
+            curr = pointer(succ);
+        }
+    }
+    return curr != nullptr && compare(curr->value, value) == 0;
+}
+
+template <class T>
+bool ConcurrentSkipList<T>::insert(const T &value) {
+    EpochReclaimer::Guard guard;
+
+    Link *preds[max_level];
+    Node *succs[max_level];
+    Node *node = nullptr;
+
+    while (true) {
+        if (find(value, preds, succs)) {
+            // Never published, so nobody else can see it
+            if (node != nullptr) destroyNode(node);
+            return false;
+        }
+
+        if (node == nullptr) node = createNode(value, randomHeight());
+        for (unsigned level = 0; level < node->height; level++) {
+            node->next()[level].store(makeLink(succs[level]), std::memory_order_relaxed);
+        }
+
+        /*
+         * Linking the bottom level is what adds the value.
+         * Count it first, so a remover that follows can never take count below zero.
+         */
+        count.fetch_add(1, std::memory_order_relaxed);
+        uintptr_t expected = makeLink(succs[0]);
+        if (preds[0][0].compare_exchange_strong(expected, makeLink(node), std::memory_order_release))
+            break;
+        count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    for (unsigned level = 1; level < node->height; level++) {
+        while (true) {
+            // Stop linking if the node is already being removed
+            uintptr_t next = node->next()[level].load(std::memory_order_acquire);
+            if (marked(next)) goto linked;
+            if (pointer(next) != succs[level] &&
+                !node->next()[level].compare_exchange_strong(next, makeLink(succs[level]), std::memory_order_release))
+                continue;
+
+            uintptr_t expected = makeLink(succs[level]);
+            if (preds[level][level].compare_exchange_strong(expected, makeLink(node), std::memory_order_release))
+                break;
+
+            // Something changed around value, so look again
+            find(value, preds, succs);
+        }
+    }
+
+  linked:
+    // If a remover marked the node while it was being linked, the upper levels may need unlinking again
+    if (marked(node->next()[0].load(std::memory_order_acquire))) find(value, preds, succs);
+    release(node);
+    return true;
+}
+
+template <class T>
+bool ConcurrentSkipList<T>::markRemoved(Node *node) noexcept {
+    // Mark the upper levels first, so no thread links the node again above the bottom
+    for (unsigned level = node->height - 1; level > 0; level--) {
+        uintptr_t next = node->next()[level].load(std::memory_order_acquire);
+        while (!marked(next)) {
+            node->next()[level].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel);
+        }
+    }
+
+    // Whoever marks the bottom level removes the value
+    uintptr_t next = node->next()[0].load(std::memory_order_acquire);
+    while (!marked(next)) {
+        if (node->next()[0].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel))
+            return true;
+    }
+    return false;
+}
+
+template <class T>
+void ConcurrentSkipList<T>::release(Node *node) {
+    if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        EpochReclaimer::retire(node, &ConcurrentSkipList::destroyNode);
+}
+
+template <class T>
+bool ConcurrentSkipList<T>::remove(const T &value) {
+    EpochReclaimer::Guard guard;
+
+    Link *preds[max_level];
+    Node *succs[max_level];
+    if (!find(value, preds, succs)) return false;
+
+    Node *node = succs[0];
+    if (!markRemoved(node)) return false;
+    count.fetch_sub(1, std::memory_order_relaxed);
+
+    // Unlink it from every level
+    find(value, preds, succs);
+    release(node);
+    return true;
+}
+
+template <class T>
+const typename ConcurrentSkipList<T>::Node* ConcurrentSkipList<T>::first() const noexcept {
+    const Node *node = pointer(head[0].load(std::memory_order_acquire));
+    while (node != nullptr && marked(node->next()[0].load(std::memory_order_acquire))) {
+        node = pointer(node->next()[0].load(std::memory_order_acquire));
+    }
+    return node;
+}
+
+template <class T>
+T ConcurrentSkipList<T>::popMostLeft() {
+    EpochReclaimer::Guard guard;
+
+    while (true) {
+        Node *node = const_cast<Node*>(first());
+        if (node == nullptr) throw std::out_of_range("tree is empty");
+
+        // Another thread may take the same node first, then try the next
+        if (!markRemoved(node)) continue;
+        count.fetch_sub(1, std::memory_order_relaxed);
+
+        T value = node->value;
+        Link *preds[max_level];
+        Node *succs[max_level];
+        find(value, preds, succs);
+        release(node);
+        return value;
+    }
+}
+
+template <class T>
+T ConcurrentSkipList<T>::getMostLeft() const {
+    EpochReclaimer::Guard guard;
+
+    const Node *node = first();
+    if (node == nullptr) throw std::out_of_range("tree is empty");
+    return node->value;
+}
+
+template <class T>
+void ConcurrentSkipList<T>::clear() {
+    EpochReclaimer::Guard guard;
+
+    while (true) {
+        Node *node = const_cast<Node*>(first());
+        if (node == nullptr) return;
+        if (!markRemoved(node)) continue;
+        count.fetch_sub(1, std::memory_order_relaxed);
+
+        Link *preds[max_level];
+        Node *succs[max_level];
+        find(node->value, preds, succs);
+        release(node);
+    }
+}
+
+template <class T>
+bool ConcurrentSkipList<T>::empty() const noexcept {
+    EpochReclaimer::Guard guard;
+    return first() == nullptr;
+}
+
+template <class T>
+size_t ConcurrentSkipList<T>::size() const noexcept {
+    return count.load(std::memory_order_relaxed);
+}
+
+template <class T>
+typename ConcurrentSkipList<T>::inorder_iterator ConcurrentSkipList<T>::inorder_begin() const noexcept {
+    // Guard the first node until the iterator holds its own guard
+    EpochReclaimer::Guard guard;
+    return inorder_iterator(first());
+}
+
+template <class T>
+typename ConcurrentSkipList<T>::inorder_iterator ConcurrentSkipList<T>::inorder_end() const noexcept {
+    return inorder_iterator(nullptr);
+}
+#endif //CONCURRENTSKIPLIST_CPP
@@ -0,0 +1,212 @@
+/*
+ * Implementation of a lock-free skip list, that ignores duplicate entries
+ *
+ * Unlike the trees, every operation is safe to call from many threads at once.
+ * Nodes are unlinked with compare and swap only, following Herlihy and Shavit's LockFreeSkipList,
+ * in "The Art of Multiprocessor Programming" (2008), after Fraser, "Practical lock-freedom" (2004).
+ * A node is removed by marking its links, bottom level last. Marking the bottom level is what removes
+ * the value, and any thread that finds a marked node on its way helps unlink it.
+ * Unlinked nodes are freed through util/epoch_reclaimer.h, so readers never touch freed memory.
+ *
+ * contains() never writes, and never retries. size() is exact once the list is quiescent.
+ * Iteration is weakly consistent: it sees every value present throughout, and none absent throughout.
+ */
+#ifndef CONCURRENTSKIPLIST_H
+#define CONCURRENTSKIPLIST_H
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include "../binaryTree.h"
+#include "../util/epoch_reclaimer.h"
+
+template <class T>
+class ConcurrentSkipList {
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Enough levels for 2^32 values at a branching factor of 2
+    static constexpr unsigned max_level = 32;
+
+  protected:
+    // A pointer to the next node, with the lowest bit set once the node owning the link is being removed
+    using Link = std::atomic<uintptr_t>;
+
+    // Aligned so the links can follow it
+    struct alignas(Link) Node {
+        T value;
+        unsigned height;
+
+        /*
+         * The inserting thread and the removing thread each hold one, and whichever lets go last retires the node.
+         * The node may still be linking its upper levels when it is removed, so neither can retire it alone.
+         */
+        std::atomic<unsigned> owners;
+
+        // Links for each level, allocated just after the node
+        Link* next() noexcept {return reinterpret_cast<Link*>(this + 1);}
+        const Link* next() const noexcept {return reinterpret_cast<const Link*>(this + 1);}
+
+        Node(const T &value, unsigned height): value(value), height(height), owners(2) {}
+    };
+
+    static Node* pointer(uintptr_t link) noexcept {return reinterpret_cast<Node*>(link & ~uintptr_t(1));}
+    static bool marked(uintptr_t link) noexcept {return link & 1;}
+    static uintptr_t makeLink(const Node *node, bool mark = false) noexcept {
+        return reinterpret_cast<uintptr_t>(node) | mark;
+    }
+
+    static Node* createNode(const T &value, unsigned height);
+    static void destroyNode(void *node) noexcept;
+
+    // Random height, each level half as likely as the one below
+    static unsigned randomHeight() noexcept;
+
+    int (*compare)(const T &a, const T &b);
+
+    // Links out of the head, for every level
+    Link head[max_level];
+    std::atomic<size_t> count;
+
+    /**
+     * Find the links either side of value on every level, in preds and succs.
+     * preds holds the link arrays, either head or a node's next(). Unlinks any removed nodes passed on the way.
+     * Returns true if the node after value on the bottom level holds value.
+     */
+    bool find(const T &value, Link *preds[], Node *succs[]) const noexcept;
+
+    // Mark node removed. Returns false if another thread removed it first.
+    static bool markRemoved(Node *node) noexcept;
+
+    // Drop one owner of node, retiring it if that was the last
+    static void release(Node *node);
+
+    // First node on the bottom level that is not being removed
+    const Node* first() const noexcept;
+
+  public:
+    explicit ConcurrentSkipList(int (*compare)(const T &a, const T &b) = default_compare);
+
+    // Neither the copy nor the destructor may run alongside other operations
+    ConcurrentSkipList(const ConcurrentSkipList &list);
+    ConcurrentSkipList& operator=(const ConcurrentSkipList &list);
+    ~ConcurrentSkipList();
+
+    bool contains(const T &value) const noexcept;
+    bool insert(const T &value);
+    bool remove(const T &value);
+
+    // Remove and return the least value. Throws std::out_of_range if there is none.
+    T popMostLeft();
+    T getMostLeft() const;
+
+    // Removes every value, and is safe alongside other operations
+    void clear();
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    /*
+     * The iterator holds an epoch guard, so the node it is on cannot be freed under it.
+     * Like the guard, it must stay on the thread that made it.
+     */
+    class inorder_iterator {
+        // Allow ConcurrentSkipList to use the protected constructor
+        friend class ConcurrentSkipList;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        inorder_iterator(const inorder_iterator &iter) = default;
+        inorder_iterator& operator=(const inorder_iterator &iter) = default;
+
+        // Prefix ++ overload
+        inorder_iterator& operator++() {
+            if (node != nullptr) {
+                // Skip past nodes removed since
+                const Node *next = ConcurrentSkipList::pointer(node->next()[0].load(std::memory_order_acquire));
+                while (next != nullptr && marked(next->next()[0].load(std::memory_order_acquire)))
+                    next = ConcurrentSkipList::pointer(next->next()[0].load(std::memory_order_acquire));
+                node = next;
+            }
+            return *this;
+        }
+
+        // Postfix ++ overload
+        inorder_iterator operator++(int) {
+            inorder_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const inorder_iterator &iter) const {
+            return node == iter.node;
+        }
+
+        bool operator!=(const inorder_iterator &iter) const {
+            return !operator==(iter);
+        }
+
+        T operator*() const {
+            if (node == nullptr)
+                throw std::out_of_range("iterator has been exhausted");
+            return node->value;
+        }
+
+      protected:
+        explicit inorder_iterator(const Node *node): node(node) {}
+
+        EpochReclaimer::Guard guard;
+        const Node *node;
+    };
+
+    inorder_iterator inorder_begin() const noexcept;
+    inorder_iterator inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong. The list must be quiescent.
+    void sanityCheck() const {
+        size_t sanity_count = 0;
+        for (unsigned level = 0; level < max_level; level++) {
+            const Node *previous = nullptr;
+            for (uintptr_t link = head[level].load(); pointer(link) != nullptr;
+                 link = pointer(link)->next()[level].load()) {
+                const Node *node = pointer(link);
+                if (marked(node->next()[level].load()))
+                    throw std::logic_error("Removed node is still linked");
+                if (level >= node->height)
+                    throw std::logic_error("Node is linked above its height");
+                if (previous != nullptr && compare(previous->value, node->value) >= 0)
+                    throw std::logic_error("Values are not in increasing order");
+                if (level == 0) sanity_count++;
+                previous = node;
+            }
+        }
+
+        // Every node on a level must also be on the level below
+        for (unsigned level = 1; level < max_level; level++) {
+            uintptr_t below = head[level - 1].load();
+            for (uintptr_t link = head[level].load(); pointer(link) != nullptr;
+                 link = pointer(link)->next()[level].load()) {
+                while (pointer(below) != nullptr && pointer(below) != pointer(link))
+                    below = pointer(below)->next()[level - 1].load();
+                if (pointer(below) == nullptr)
+                    throw std::logic_error("Node is missing from a lower level");
+            }
+        }
+
+        if (count.load() != sanity_count)
+            throw std::logic_error("ConcurrentSkipList size does not match count of elements");
+    }
+#endif
+};
+
+#include "ConcurrentSkipList.cpp"
+#endif //CONCURRENTSKIPLIST_H
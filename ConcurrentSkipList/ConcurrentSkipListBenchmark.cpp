@@ -0,0 +1,25 @@
+/*
+ * Performance Benchmark for ConcurrentSkipList against AVLTree behind a mutex
+ * All threads share one list, with a read mostly mix and with pure churn.
+ *
+ * g++ ConcurrentSkipListBenchmark.cpp ../AVLTree/AVLTree.cpp ../binaryTree.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o ConcurrentSkipListBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "ConcurrentSkipList.h"
+#include "../AVLTree/AVLTree.h"
+#include "../util/tree_benchmark.h"
+
+BENCHMARK_TEMPLATE(BM_ReadMostly, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, ConcurrentSkipList<int>)->THREADED_TESTS;
+
+BENCHMARK_TEMPLATE(BM_Churn, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, ConcurrentSkipList<int>)->THREADED_TESTS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,45 @@
+/*
+ * Test cases for testing the sanity of the ConcurrentSkipList
+ */
+
+#include <iostream>
+#include <stdexcept>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "ConcurrentSkipList.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "ConcurrentSkipList Tests" << endl;
+    using List = ConcurrentSkipList<int>;
+    cout << "Empty Check                : " << (check_empty<List>() ? "passed" : "failed") << endl;
+    cout << "Insert Remove Check        : " << (check_insert_remove<List>() ? "passed" : "failed") << endl;
+
+    // Only the left end, the list has no way back
+    bool passed = true;
+    {
+        List list;
+        try {
+            list.popMostLeft();
+            passed = false;
+        } catch (std::out_of_range &) {}
+        try {
+            list.getMostLeft();
+            passed = false;
+        } catch (std::out_of_range &) {}
+
+        for (int i : {5, 3, 8, 1, 4, 7, 9, 2, 6}) list.insert(i);
+        passed &= list.getMostLeft() == 1;
+        for (int i = 1; i <= 9; i++) passed &= list.popMostLeft() == i;
+        passed &= list.empty();
+        list.sanityCheck();
+    }
+    cout << "Ends Check                 : " << (passed ? "passed" : "failed") << endl;
+    cout << "Churn Check                : " << (check_churn<List>() ? "passed" : "failed") << endl;
+
+    passed = check_concurrent_churn<List>() && check_concurrent_pops<List>();
+    cout << "Concurrent Check           : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,207 @@
+#ifndef FLATCOMBININGTREE_CPP
+#define FLATCOMBININGTREE_CPP
+
+#include <functional>
+#include "FlatCombiningTree.h"
+
+template <class Tree>
+FlatCombiningTree<Tree>::FlatCombiningTree(int (*compare)(const T &a, const T &b), size_t slots):
+    compare(compare), tree(compare), slots(std::max<size_t>(1, slots)) {
+    batch.reserve(this->slots.size());
+}
+
+template <class Tree>
+FlatCombiningTree<Tree>::FlatCombiningTree(const FlatCombiningTree &tree):
+    compare(tree.compare), tree(tree.tree), slots(tree.slots.size()) {
+    batch.reserve(slots.size());
+}
+
+template <class Tree>
+FlatCombiningTree<Tree>& FlatCombiningTree<Tree>::operator=(const FlatCombiningTree &tree) {
+    if (this == &tree) return *this;
+
+    compare = tree.compare;
+    this->tree = tree.tree;
+    return *this;
+}
+
+template <class Tree>
+typename FlatCombiningTree<Tree>::Slot* FlatCombiningTree<Tree>::claimSlot() {
+    const size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % slots.size();
+    while (true) {
+        for (size_t i = 0; i < slots.size(); i++) {
+            Slot &slot = slots[(start + i) % slots.size()];
+            int expected = unused;
+            if (slot.state.load(std::memory_order_relaxed) == unused &&
+                slot.state.compare_exchange_strong(expected, claimed, std::memory_order_acquire)) {
+                return &slot;
+            }
+        }
+        // More threads than slots, so let one finish
+        std::this_thread::yield();
+    }
+}
+
+template <class Tree>
+bool FlatCombiningTree<Tree>::apply(Operation operation, const T &value) {
+    Slot *slot = claimSlot();
+    slot->operation = operation;
+    slot->value = value;
+    slot->state.store(pending, std::memory_order_release);
+
+    while (slot->state.load(std::memory_order_acquire) != done) {
+        if (combining.try_lock()) {
+            // Our slot was posted before the lock was taken, so this answers it
+            combine();
+            combining.unlock();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    const bool result = slot->result;
+    slot->state.store(unused, std::memory_order_release);
+    return result;
+}
+
+template <class Tree>
+void FlatCombiningTree<Tree>::combine() {
+    batch.clear();
+    for (Slot &slot : slots) {
+        if (slot.state.load(std::memory_order_acquire) == pending) batch.push_back(&slot);
+    }
+
+    combine(HasApplyBatch<Tree>());
+}
+
+template <class Tree>
+void FlatCombiningTree<Tree>::combine(std::true_type) {
+    using BatchOperation = typename Tree::BatchOperation;
+
+    // applyBatch() sorts and gathers operations on the same value itself
+    std::vector<BatchOperation> operations(batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+        switch (batch[i]->operation) {
+            case contains_operation:
+                operations[i].operation = Tree::contains_operation;
+                break;
+            case insert_operation:
+                operations[i].operation = Tree::insert_operation;
+                break;
+            case remove_operation:
+                operations[i].operation = Tree::remove_operation;
+                break;
+        }
+        operations[i].value = batch[i]->value;
+    }
+
+    // A batch holds at most one operation per slot, far too few to be worth another thread
+    const std::vector<bool> results = tree.applyBatch(operations.data(), operations.size(), 1u);
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch[i]->result = results[i];
+        batch[i]->state.store(done, std::memory_order_release);
+    }
+}
+
+template <class Tree>
+void FlatCombiningTree<Tree>::combine(std::false_type) {
+    std::sort(batch.begin(), batch.end(), [this](const Slot *a, const Slot *b) {
+        return compare(a->value, b->value) < 0;
+    });
+
+    for (size_t i = 0; i < batch.size();) {
+        // Operations on the same value are next to each other. Walk the tree once for the first, and work out the
+        // rest from whether the value is present.
+        Slot *first = batch[i];
+        bool present = false;
+        switch (first->operation) {
+            case contains_operation:
+                first->result = tree.contains(first->value);
+                present = first->result;
+                break;
+            case insert_operation:
+                first->result = tree.insert(first->value);
+                present = true;
+                break;
+            case remove_operation:
+                first->result = tree.remove(first->value);
+                present = false;
+                break;
+        }
+
+        const bool in_tree = present;
+        size_t j = i + 1;
+        for (; j < batch.size() && compare(batch[j]->value, first->value) == 0; j++) {
+            Slot *slot = batch[j];
+            switch (slot->operation) {
+                case contains_operation:
+                    slot->result = present;
+                    break;
+                case insert_operation:
+                    slot->result = !present;
+                    present = true;
+                    break;
+                case remove_operation:
+                    slot->result = present;
+                    present = false;
+                    break;
+            }
+        }
+
+        // Only the last change to the value reaches the tree
+        if (present != in_tree) {
+            if (present) {
+                tree.insert(first->value);
+            } else {
+                tree.remove(first->value);
+            }
+        }
+
+        for (; i < j; i++) batch[i]->state.store(done, std::memory_order_release);
+    }
+}
+
+template <class Tree>
+bool FlatCombiningTree<Tree>::contains(const T &value) {
+    return apply(contains_operation, value);
+}
+
+template <class Tree>
+bool FlatCombiningTree<Tree>::insert(const T &value) {
+    return apply(insert_operation, value);
+}
+
+template <class Tree>
+bool FlatCombiningTree<Tree>::remove(const T &value) {
+    return apply(remove_operation, value);
+}
+
+template <class Tree>
+void FlatCombiningTree<Tree>::clear() {
+    std::lock_guard<std::mutex> lock(combining);
+    tree.clear();
+}
+
+template <class Tree>
+bool FlatCombiningTree<Tree>::empty() {
+    std::lock_guard<std::mutex> lock(combining);
+    return tree.empty();
+}
+
+template <class Tree>
+size_t FlatCombiningTree<Tree>::size() {
+    std::lock_guard<std::mutex> lock(combining);
+    return tree.size();
+}
+
+template <class Tree>
+typename Tree::inorder_iterator FlatCombiningTree<Tree>::inorder_begin() const noexcept {
+    return tree.inorder_begin();
+}
+
+template <class Tree>
+typename Tree::inorder_iterator FlatCombiningTree<Tree>::inorder_end() const noexcept {
+    return tree.inorder_end();
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * A tree shared between threads by flat combining, e.g. FlatCombiningTree<AVLTree<int>>
+ *
+ * Any tree with the BinaryTree interface works as the inner tree. Rather than every thread taking a lock and walking
+ * the tree itself, each thread posts its operation into a slot and one thread at a time, the combiner, applies every
+ * posted operation and hands back the results. The tree stays in the combiner's cache instead of moving between
+ * cores with the lock, which pays off when many threads contend for the same tree.
+ *
+ * The combiner sorts each batch by value, so the walks down the tree share their upper levels, and operations on the
+ * same value are answered with one walk. Every operation in a batch was posted before any of them returned, so any
+ * order among them is a valid one. When the inner tree has its own applyBatch(), as AVLTree does, the combiner hands
+ * it the whole batch in one call instead.
+ *
+ * Based on "Flat Combining and the Synchronization-Parallelism Tradeoff" by Hendler, Incze, Shavit and Tzafrir.
+ */
+#ifndef FLATCOMBININGTREE_H
+#define FLATCOMBININGTREE_H
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "../binaryTree.h"
+#include "../util/aligned_allocator.h"
+
+// Whether Tree can apply many operations in one call, found by whether AVLTree's applyBatch() compiles for it
+template <class Tree, class = void>
+struct HasApplyBatch: std::false_type {};
+
+template <class Tree>
+struct HasApplyBatch<Tree, decltype(void(std::declval<Tree&>().applyBatch(
+    std::declval<const typename Tree::BatchOperation*>(), size_t(), 1u)))>: std::true_type {};
+
+template <class Tree>
+class FlatCombiningTree {
+  public:
+    // Public reference to T for reference
+    using value_type = typename Tree::value_type;
+    using T = value_type;
+
+  protected:
+    enum Operation {contains_operation, insert_operation, remove_operation};
+
+    // The life of a slot, moved along by its owner except for pending to done
+    enum State {unused, claimed, pending, done};
+
+    // On its own cache line, so threads posting do not slow each other
+    struct alignas(64) Slot {
+        std::atomic<int> state;
+        Operation operation;
+        T value;
+        bool result;
+
+        Slot(): state(unused), operation(contains_operation), value(), result(false) {}
+    };
+
+    int (*compare)(const T &a, const T &b);
+    Tree tree;
+
+    // Every thread posts through one of these, so there is nothing to register
+    std::vector<Slot, aligned_allocator<Slot>> slots;
+
+    // Held by the combiner, and by anything else touching the tree directly
+    std::mutex combining;
+
+    // Reused between batches, only touched by the combiner
+    std::vector<Slot*> batch;
+
+    // Post an operation and wait for its result, combining if no one else is
+    bool apply(Operation operation, const T &value);
+
+    // Take a free slot, starting from one picked by the thread's id so threads rarely collide
+    Slot* claimSlot();
+
+    // Apply every pending operation to the tree. Must hold combining.
+    void combine();
+    // Hand the batch to the tree's applyBatch()
+    void combine(std::true_type batched);
+    // Or walk the tree once per value in the batch
+    void combine(std::false_type batched);
+
+  public:
+    // slots is how many operations can be waiting at once, by default four per core. More threads than slots is
+    // fine, they wait for a slot to be freed.
+    explicit FlatCombiningTree(int (*compare)(const T &a, const T &b) = default_compare,
+                               size_t slots = 4 * std::max(1u, std::thread::hardware_concurrency()));
+
+    // Neither the copy nor the destructor may run alongside other operations
+    FlatCombiningTree(const FlatCombiningTree &tree);
+    FlatCombiningTree& operator=(const FlatCombiningTree &tree);
+
+    bool contains(const T &value);
+    bool insert(const T &value);
+    bool remove(const T &value);
+
+    // Applied directly under the combiner's lock
+    void clear();
+    bool empty();
+    size_t size();
+
+    // The iterators of the inner tree. The tree must be quiescent.
+    typename Tree::inorder_iterator inorder_begin() const noexcept;
+    typename Tree::inorder_iterator inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong. The tree must be quiescent.
+    void sanityCheck() const {
+        for (const Slot &slot : slots) {
+            if (slot.state.load() != unused) throw std::logic_error("Slot is still in use");
+        }
+        tree.sanityCheck();
+    }
+#endif
+};
+
+#include "FlatCombiningTree.cpp"
+#endif //FLATCOMBININGTREE_H
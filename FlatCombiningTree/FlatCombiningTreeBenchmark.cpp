@@ -0,0 +1,25 @@
+/*
+ * Performance Benchmark for FlatCombiningTree against AVLTree behind a mutex
+ * All threads share one tree, over a small range where they fight for the same values and a large one.
+ *
+ * g++ FlatCombiningTreeBenchmark.cpp ../AVLTree/AVLTree.cpp ../binaryTree.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o FlatCombiningTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "FlatCombiningTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../util/tree_benchmark.h"
+
+BENCHMARK_TEMPLATE(BM_ReadMostly, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, FlatCombiningTree<AVLTree<int>>)->THREADED_TESTS;
+
+BENCHMARK_TEMPLATE(BM_Churn, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, FlatCombiningTree<AVLTree<int>>)->THREADED_TESTS;
+
+BENCHMARK_MAIN();
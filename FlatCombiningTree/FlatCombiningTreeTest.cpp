@@ -0,0 +1,142 @@
+/*
+ * Test cases for testing the sanity of the FlatCombiningTree
+ */
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "FlatCombiningTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../SplayTree/splayTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+// Counts the batches the combiner hands over whole
+struct CountingAVLTree: AVLTree<int> {
+    static atomic<int> batches;
+    static atomic<int> operations;
+
+    // BinaryTree is a virtual base, so it must be given compare here, not through AVLTree
+    explicit CountingAVLTree(int (*compare)(const int &a, const int &b)):
+        BinaryTree<int, AVLTreeNode<int>>(compare), AVLTree<int>(compare) {}
+
+    using AVLTree<int>::applyBatch;
+
+    vector<bool> applyBatch(const BatchOperation *batch, size_t length, unsigned threads) override {
+        batches++;
+        operations += length;
+        return AVLTree<int>::applyBatch(batch, length, threads);
+    }
+};
+atomic<int> CountingAVLTree::batches(0);
+atomic<int> CountingAVLTree::operations(0);
+
+int main() {
+    cout << "FlatCombiningTree Tests" << endl;
+    // One thread, so every batch holds a single operation
+    using Tree = FlatCombiningTree<AVLTree<int>>;
+    cout << "Empty Check                : " << (check_empty<Tree>() ? "passed" : "failed") << endl;
+    cout << "Insert Remove Check        : " << (check_insert_remove<Tree>() ? "passed" : "failed") << endl;
+    const bool churned = check_churn<Tree>() && check_churn<FlatCombiningTree<SplayTree<int>>>();
+    cout << "Churn Check                : " << (churned ? "passed" : "failed") << endl;
+
+    bool passed = true;
+    {
+        // Fewer slots than threads, so threads also wait for slots
+        FlatCombiningTree<AVLTree<int>> tree(default_compare, 4);
+        const int threads = 8, per_thread = 4000;
+        vector<thread> workers;
+        atomic<bool> failed(false);
+
+        // Each thread churns its own values, so every result is known
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&tree, &failed, t]() {
+                for (int round = 0; round < 4; round++) {
+                    for (int i = 0; i < per_thread; i++) {
+                        if (!tree.insert(i * threads + t)) failed = true;
+                    }
+                    for (int i = 0; i < per_thread; i++) {
+                        if (!tree.contains(i * threads + t)) failed = true;
+                        if (!tree.remove(i * threads + t)) failed = true;
+                        if (tree.contains(i * threads + t)) failed = true;
+                    }
+                }
+            });
+        }
+        for (thread &worker : workers) worker.join();
+        passed &= !failed && tree.empty();
+        tree.sanityCheck();
+
+        // Every thread fights over the same few values, so batches hold several operations on each. Each value ends
+        // present exactly when it was inserted once more than it was removed.
+        vector<vector<int>> balance(threads, vector<int>(16));
+        workers.clear();
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&tree, &balance, t]() {
+                minstd_rand generator(t + 1);
+                for (int i = 0; i < 20000; i++) {
+                    const int value = generator() % 16;
+                    if (generator() % 2) {
+                        balance[t][value] += tree.insert(value);
+                    } else {
+                        balance[t][value] -= tree.remove(value);
+                    }
+                }
+            });
+        }
+        for (thread &worker : workers) worker.join();
+
+        for (int value = 0; value < 16; value++) {
+            int total = 0;
+            for (int t = 0; t < threads; t++) total += balance[t][value];
+            passed &= total == (tree.contains(value) ? 1 : 0);
+        }
+        tree.sanityCheck();
+    }
+    cout << "Concurrent Check           : " << (passed ? "passed" : "failed") << endl;
+
+    passed = HasApplyBatch<AVLTree<int>>::value && !HasApplyBatch<SplayTree<int>>::value;
+    {
+        // The combiner hands every operation to applyBatch(), and the results come back as if applied one at a time
+        FlatCombiningTree<CountingAVLTree> tree;
+        const int threads = 8, per_thread = 20000;
+        vector<thread> workers;
+        vector<vector<int>> balance(threads, vector<int>(64));
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&tree, &balance, t]() {
+                minstd_rand generator(t + 1);
+                for (int i = 0; i < per_thread; i++) {
+                    const int value = generator() % 64;
+                    switch (generator() % 3) {
+                        case 0:
+                            balance[t][value] += tree.insert(value);
+                            break;
+                        case 1:
+                            balance[t][value] -= tree.remove(value);
+                            break;
+                        default:
+                            tree.contains(value);
+                            break;
+                    }
+                }
+            });
+        }
+        for (thread &worker : workers) worker.join();
+
+        for (int value = 0; value < 64; value++) {
+            int total = 0;
+            for (int t = 0; t < threads; t++) total += balance[t][value];
+            passed &= total == (tree.contains(value) ? 1 : 0);
+        }
+        passed &= CountingAVLTree::operations == threads * per_thread + 64;
+        passed &= CountingAVLTree::batches > 0;
+        tree.sanityCheck();
+    }
+    cout << "Batch Check                : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,236 @@
+#ifndef FROZENKARYTREE_CPP
+#define FROZENKARYTREE_CPP
+
+#include "FrozenKaryTree.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FROZENKARYTREE_X86
+#endif
+
+#ifdef FROZENKARYTREE_X86
+/*
+ * Number of keys in the node at keys that are less than value.
+ *
+ * Each compare sets every byte of the keys less than value, so the popcount of the byte mask
+ * is sizeof(T) times the count. The nodes are cache line aligned, so the loads are too.
+ */
+
+__attribute__((target("sse2")))
+inline size_t frozen_kary_rank_sse2(const int *keys, int value) noexcept {
+    const __m128i v = _mm_set1_epi32(value);
+    const __m128i *node = reinterpret_cast<const __m128i*>(keys);
+    const uint64_t mask = (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi32(v, _mm_load_si128(node)))
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi32(v, _mm_load_si128(node + 1))) << 16
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi32(v, _mm_load_si128(node + 2))) << 32
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi32(v, _mm_load_si128(node + 3))) << 48;
+    return __builtin_popcountll(mask) / sizeof(int);
+}
+
+__attribute__((target("sse2")))
+inline size_t frozen_kary_rank_sse2(const short *keys, short value) noexcept {
+    const __m128i v = _mm_set1_epi16(value);
+    const __m128i *node = reinterpret_cast<const __m128i*>(keys);
+    const uint64_t mask = (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi16(v, _mm_load_si128(node)))
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi16(v, _mm_load_si128(node + 1))) << 16
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi16(v, _mm_load_si128(node + 2))) << 32
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi16(v, _mm_load_si128(node + 3))) << 48;
+    return __builtin_popcountll(mask) / sizeof(short);
+}
+
+__attribute__((target("sse2")))
+inline size_t frozen_kary_rank_sse2(const char *keys, char value) noexcept {
+    const __m128i v = _mm_set1_epi8(value);
+    const __m128i *node = reinterpret_cast<const __m128i*>(keys);
+    const uint64_t mask = (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_load_si128(node)))
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_load_si128(node + 1))) << 16
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_load_si128(node + 2))) << 32
+                        | (uint64_t) _mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_load_si128(node + 3))) << 48;
+    return __builtin_popcountll(mask);
+}
+
+__attribute__((target("avx2")))
+inline size_t frozen_kary_rank_avx2(const int *keys, int value) noexcept {
+    const __m256i v = _mm256_set1_epi32(value);
+    const __m256i *node = reinterpret_cast<const __m256i*>(keys);
+    const uint64_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi32(v, _mm256_load_si256(node)))
+                        | (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi32(v, _mm256_load_si256(node + 1))) << 32;
+    return __builtin_popcountll(mask) / sizeof(int);
+}
+
+__attribute__((target("avx2")))
+inline size_t frozen_kary_rank_avx2(const short *keys, short value) noexcept {
+    const __m256i v = _mm256_set1_epi16(value);
+    const __m256i *node = reinterpret_cast<const __m256i*>(keys);
+    const uint64_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi16(v, _mm256_load_si256(node)))
+                        | (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi16(v, _mm256_load_si256(node + 1))) << 32;
+    return __builtin_popcountll(mask) / sizeof(short);
+}
+
+__attribute__((target("avx2")))
+inline size_t frozen_kary_rank_avx2(const char *keys, char value) noexcept {
+    const __m256i v = _mm256_set1_epi8(value);
+    const __m256i *node = reinterpret_cast<const __m256i*>(keys);
+    const uint64_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi8(v, _mm256_load_si256(node)))
+                        | (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi8(v, _mm256_load_si256(node + 1))) << 32;
+    return __builtin_popcountll(mask);
+}
+
+/*
+ * The search loops are repeated for each instruction set, so the node compares are inlined into them.
+ * A function can only inline code compiled for the same or a smaller instruction set.
+ */
+
+template <class T>
+__attribute__((target("sse2")))
+size_t frozen_kary_lower_bound_sse2(const T *keys, const std::vector<size_t> &layer_start, const T value) noexcept {
+    constexpr size_t node_keys = FrozenKaryTree<T>::node_keys;
+    size_t node = 0;
+    for (size_t layer = layer_start.size() - 1; layer > 0; layer--) {
+        node = node * (node_keys + 1) + frozen_kary_rank_sse2(keys + layer_start[layer] + node * node_keys, value);
+    }
+    return node * node_keys + frozen_kary_rank_sse2(keys + node * node_keys, value);
+}
+
+template <class T>
+__attribute__((target("avx2")))
+size_t frozen_kary_lower_bound_avx2(const T *keys, const std::vector<size_t> &layer_start, const T value) noexcept {
+    constexpr size_t node_keys = FrozenKaryTree<T>::node_keys;
+    size_t node = 0;
+    for (size_t layer = layer_start.size() - 1; layer > 0; layer--) {
+        node = node * (node_keys + 1) + frozen_kary_rank_avx2(keys + layer_start[layer] + node * node_keys, value);
+    }
+    return node * node_keys + frozen_kary_rank_avx2(keys + node * node_keys, value);
+}
+#endif
+
+template <class T>
+template <class InputIt>
+FrozenKaryTree<T>::FrozenKaryTree(InputIt first, const size_t size): count(size) {
+    // Padding sorts after every value, so searches never go past it
+    const T padding = std::numeric_limits<T>::max();
+
+    if (count != 0) {
+        // Bottom layer, the values themselves
+        size_t nodes = (count + node_keys - 1) / node_keys;
+        layer_start.push_back(0);
+        keys.resize(nodes * node_keys, padding);
+        for (size_t i = 0; i < count; i++, ++first) keys[i] = *first;
+
+        // Bottom layer nodes under each child of the layer being built
+        size_t child_span = 1;
+
+        // Add layers until a single node covers everything
+        while (nodes > 1) {
+            nodes = (nodes + node_keys) / (node_keys + 1);
+            const size_t start = keys.size();
+            layer_start.push_back(start);
+            keys.resize(start + nodes * node_keys, padding);
+
+            for (size_t node = 0; node < nodes; node++) {
+                for (size_t key = 0; key < node_keys; key++) {
+                    // Key j separates child j from child j + 1, it is the smallest value under child j + 1
+                    const size_t child = node * (node_keys + 1) + key + 1;
+                    const size_t smallest = child * child_span * node_keys;
+                    if (smallest < count) keys[start + node * node_keys + key] = keys[smallest];
+                }
+            }
+            child_span *= node_keys + 1;
+        }
+    }
+
+    if (!useIsa(Isa::avx2) && !useIsa(Isa::sse2)) useIsa(Isa::scalar);
+}
+
+template <class T>
+bool FrozenKaryTree<T>::useIsa(const Isa isa) noexcept {
+    switch (isa) {
+        case Isa::scalar:
+            search = &FrozenKaryTree::lowerBoundScalar;
+            break;
+#ifdef FROZENKARYTREE_X86
+        case Isa::sse2:
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("sse2")) return false;
+            search = &FrozenKaryTree::lowerBoundSse2;
+            break;
+        case Isa::avx2:
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("avx2")) return false;
+            search = &FrozenKaryTree::lowerBoundAvx2;
+            break;
+#endif
+        default:
+            return false;
+    }
+    this->isa = isa;
+    return true;
+}
+
+template <class T>
+typename FrozenKaryTree<T>::Isa FrozenKaryTree<T>::getIsa() const noexcept {
+    return isa;
+}
+
+template <class T>
+size_t FrozenKaryTree<T>::lowerBoundScalar(const T value) const noexcept {
+    const auto rank = [value](const T *node) {
+        size_t less = 0;
+        for (size_t i = 0; i < node_keys; i++) less += node[i] < value;
+        return less;
+    };
+
+    size_t node = 0;
+    for (size_t layer = layer_start.size() - 1; layer > 0; layer--) {
+        node = node * (node_keys + 1) + rank(keys.data() + layer_start[layer] + node * node_keys);
+    }
+    return node * node_keys + rank(keys.data() + node * node_keys);
+}
+
+template <class T>
+size_t FrozenKaryTree<T>::lowerBoundSse2(const T value) const noexcept {
+#ifdef FROZENKARYTREE_X86
+    return frozen_kary_lower_bound_sse2(keys.data(), layer_start, value);
+#else
+    return lowerBoundScalar(value);
+#endif
+}
+
+template <class T>
+size_t FrozenKaryTree<T>::lowerBoundAvx2(const T value) const noexcept {
+#ifdef FROZENKARYTREE_X86
+    return frozen_kary_lower_bound_avx2(keys.data(), layer_start, value);
+#else
+    return lowerBoundScalar(value);
+#endif
+}
+
+template <class T>
+size_t FrozenKaryTree<T>::lowerBound(const T value) const noexcept {
+    if (empty()) return 0;
+    return (this->*search)(value);
+}
+
+template <class T>
+bool FrozenKaryTree<T>::contains(const T value) const noexcept {
+    const size_t rank = lowerBound(value);
+    return rank < count && keys[rank] == value;
+}
+
+template <class T>
+size_t FrozenKaryTree<T>::find(const T value) const noexcept {
+    const size_t rank = lowerBound(value);
+    return rank < count && keys[rank] == value ? rank : count;
+}
+
+template <class T>
+bool FrozenKaryTree<T>::empty() const noexcept {
+    return count == 0;
+}
+
+template <class T>
+size_t FrozenKaryTree<T>::size() const noexcept {
+    return count;
+}
+
+#endif //FROZENKARYTREE_CPP
@@ -0,0 +1,103 @@
+/*
+ * A read only search tree for small integer keys, searched with SIMD compares.
+ *
+ * Every node is one cache line of keys, 16 ints, 32 shorts or 64 chars, and has one more child than keys.
+ * A whole node is compared against the value in a couple of instructions (AVX2, or SSE2 as a fallback),
+ * and the number of keys less than the value picks the child. A million ints take five nodes to search.
+ *
+ * The bottom layer is the sorted values themselves, padded to whole nodes.
+ * Each layer above holds, for every node, the smallest value under each child but the first.
+ * So the search ends on the position of the lower bound in the bottom layer, which is its inorder rank.
+ *
+ * Keys are compared with <, so this only matches trees using the natural order, like default_compare.
+ * The instruction set is picked at runtime; a scalar search is used on other CPUs.
+ */
+#ifndef FROZENKARYTREE_H
+#define FROZENKARYTREE_H
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "../util/aligned_allocator.h"
+
+template <class T>
+class FrozenKaryTree {
+    static_assert(std::is_same<T, int>::value || std::is_same<T, short>::value || std::is_same<T, char>::value,
+                  "FrozenKaryTree only supports int, short and char keys");
+
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Keys in a node, filling a cache line
+    static constexpr size_t node_keys = 64 / sizeof(T);
+
+    enum class Isa { scalar, sse2, avx2 };
+
+  protected:
+    // Layers from the bottom up, each a whole number of nodes. The bottom layer is the sorted values.
+    std::vector<T, aligned_allocator<T, 64>> keys;
+    // Index of the first key of each layer
+    std::vector<size_t> layer_start;
+    size_t count;
+
+    // Search with the chosen instruction set
+    size_t (FrozenKaryTree::*search)(T value) const noexcept;
+    Isa isa;
+
+    // Position of the first value in the bottom layer not less than value
+    size_t lowerBoundScalar(T value) const noexcept;
+    size_t lowerBoundSse2(T value) const noexcept;
+    size_t lowerBoundAvx2(T value) const noexcept;
+
+  public:
+    /**
+     * Build from size values in increasing order, read from first.
+     */
+    template <class InputIt>
+    FrozenKaryTree(InputIt first, size_t size);
+
+    bool contains(T value) const noexcept;
+
+    // Rank of value, or size() if it is not in the tree
+    size_t find(T value) const noexcept;
+
+    // Rank of the first value not less than value, or size() if there is none
+    size_t lowerBound(T value) const noexcept;
+
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    // The instruction set used for searching
+    Isa getIsa() const noexcept;
+
+    // Search with isa instead, if this CPU supports it. Returns false if it does not.
+    bool useIsa(Isa isa) noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong
+    void sanityCheck() const {
+        for (size_t i = 1; i < count; i++) {
+            if (keys[i - 1] >= keys[i])
+                throw std::logic_error("Bottom layer is not increasing");
+        }
+
+        // Every search path must agree with the bottom layer
+        for (Isa check : {Isa::scalar, Isa::sse2, Isa::avx2}) {
+            FrozenKaryTree copy = *this;
+            if (!copy.useIsa(check)) continue;
+
+            for (size_t i = 0; i < count; i++) {
+                if (copy.lowerBound(keys[i]) != i)
+                    throw std::logic_error("Search does not find a value at its rank");
+            }
+        }
+    }
+#endif
+};
+
+#include "FrozenKaryTree.cpp"
+#endif //FROZENKARYTREE_H
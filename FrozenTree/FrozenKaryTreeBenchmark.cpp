@@ -0,0 +1,71 @@
+/*
+ * Performance Benchmark for FrozenKaryTree, against AVLTree and std::lower_bound
+ *
+ * g++ FrozenKaryTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o FrozenKaryTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+// Read only lookups, so each tree is only built once
+#define TESTS RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Complexity()
+
+#include <vector>
+#include <algorithm>
+#include "FrozenKaryTree.h"
+#include "../AVLTree/AVLTree.h"
+
+inline int RandomNumber() {
+    return rand();
+}
+
+template <class Tree>
+inline void ConstructRandomTree(Tree &tree, size_t size) {
+    while (tree.size() < size)
+        tree.insert(RandomNumber());
+}
+
+static void BM_AVLTreeContains(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.contains(RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AVLTreeContains)->TESTS;
+
+static void BM_StdLowerBound(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    const std::vector<int> values(tree.inorder_begin(), tree.inorder_end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lower_bound(values.begin(), values.end(), RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_StdLowerBound)->TESTS;
+
+template <FrozenKaryTree<int>::Isa isa>
+static void BM_FrozenKaryTreeContains(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    FrozenKaryTree<int> frozen(tree.inorder_begin(), tree.size());
+    if (!frozen.useIsa(isa)) {
+        state.SkipWithError("Instruction set not supported");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frozen.contains(RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_FrozenKaryTreeContains, FrozenKaryTree<int>::Isa::scalar)->TESTS;
+BENCHMARK_TEMPLATE(BM_FrozenKaryTreeContains, FrozenKaryTree<int>::Isa::sse2)->TESTS;
+BENCHMARK_TEMPLATE(BM_FrozenKaryTreeContains, FrozenKaryTree<int>::Isa::avx2)->TESTS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+#ifndef FROZENTREE_CPP
+#define FROZENTREE_CPP
+
+#include "FrozenTree.h"
+
+template <class T>
+template <class InputIt>
+FrozenTree<T>::FrozenTree(InputIt first, const size_t size, int (*compare)(const T &a, const T &b)):
+    compare(compare), keys(size + 1), count(size) {
+    if (count == 0) return;
+
+    // Fill the indexes in inorder, so the values are read in the order they are given
+    size_t index = 1;
+    while (index * 2 <= count) index *= 2;
+
+    for (size_t i = 0; i < count; i++, ++first) {
+        keys[index] = *first;
+        index = nextInorder(index);
+    }
+}
+
+template <class T>
+template <class Node>
+FrozenTree<T>::FrozenTree(const BinaryTree<T, Node> &tree):
+    FrozenTree(tree.inorder_begin(), tree.size(), tree.getCompare()) {}
+
+template <class T>
+size_t FrozenTree<T>::nextInorder(size_t index) const noexcept {
+    if (index * 2 + 1 <= count) {
+        // Most left of the right subtree
+        index = index * 2 + 1;
+        while (index * 2 <= count) index *= 2;
+        return index;
+    }
+
+    // Climb out of right subtrees. Right children have odd indexes.
+    // Climbing out of the root reaches 0, the end.
+    while (index & 1) index >>= 1;
+    return index >> 1;
+}
+
+template <class T>
+size_t FrozenTree<T>::getRank(const size_t index) const noexcept {
+    /**
+     * Computed in O(1) from the index.
+     *
+     * If the bottom level were full, the rank of a node at depth d, (index - 2^d) along its level,
+     * would be ((2 * (index - 2^d) + 1) << (levels - 1 - d)) - 1.
+     * In that full tree the bottom level sits at every even rank.
+     * Subtract the bottom level nodes that would come before, but are past the end of the array.
+     */
+    const size_t levels = 64 - __builtin_clzll(count);
+    const size_t depth = 63 - __builtin_clzll(index);
+
+    const size_t full_rank = ((2 * (index - (size_t(1) << depth)) + 1) << (levels - 1 - depth)) - 1;
+
+    const size_t bottom_present = count - (size_t(1) << (levels - 1)) + 1;
+    const size_t bottom_before = (full_rank + 1) / 2;
+    const size_t missing = bottom_before > bottom_present ? bottom_before - bottom_present : 0;
+
+    return full_rank - missing;
+}
+
+template <class T>
+size_t FrozenTree<T>::lowerBoundIndex(const T &value) const noexcept {
+    /**
+     * Go left when the key is not less than value, right otherwise, until falling off the bottom.
+     * The bits of index record the turns, a one for each right.
+     *
+     * The answer is the last node a left turn was taken from.
+     * Dropping the trailing ones and the zero before them gets back to it.
+     * If every turn was right, that leaves 0.
+     */
+    const T *base = keys.data();
+    size_t index = 1;
+
+    while (index <= count) {
+        // Only a hint, addresses past the end are never read
+        __builtin_prefetch(base + index * prefetch_stride);
+        index = 2 * index + (compare(base[index], value) < 0);
+    }
+
+    return index >> __builtin_ffsll(static_cast<long long>(~index));
+}
+
+template <class T>
+bool FrozenTree<T>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the tree.
+     *
+     * Return true if value is contained. False otherwise.
+     */
+    const size_t index = lowerBoundIndex(value);
+    return index != 0 && compare(keys[index], value) == 0;
+}
+
+template <class T>
+size_t FrozenTree<T>::find(const T &value) const noexcept {
+    const size_t index = lowerBoundIndex(value);
+    return index != 0 && compare(keys[index], value) == 0 ? getRank(index) : count;
+}
+
+template <class T>
+size_t FrozenTree<T>::lowerBound(const T &value) const noexcept {
+    const size_t index = lowerBoundIndex(value);
+    return index != 0 ? getRank(index) : count;
+}
+
+template <class T>
+bool FrozenTree<T>::empty() const noexcept {
+    return count == 0;
+}
+
+template <class T>
+size_t FrozenTree<T>::size() const noexcept {
+    return count;
+}
+
+#endif //FROZENTREE_CPP
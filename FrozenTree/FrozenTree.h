@@ -0,0 +1,98 @@
+/*
+ * A read only search tree, built once from the values of another tree.
+ *
+ * The values are stored in one array in Eytzinger (BFS) order: the root at index 1,
+ * and the children of index i at 2i and 2i + 1. Index 0 is unused.
+ * Every level of the search is the same simple step, with no branch on the comparison,
+ * and the nodes a few levels below are adjacent, so they are prefetched long before they are reached.
+ *
+ * Lookups answer with the inorder rank of the value, its position in sorted order.
+ *
+ * Build one from a BinaryTree, or from any increasing sequence of values.
+ */
+#ifndef FROZENTREE_H
+#define FROZENTREE_H
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include "../binaryTree.h"
+
+template <class T>
+class FrozenTree {
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Distance between an index and its descendants as many levels below as fit in a cache line.
+    // Their keys are adjacent, starting at index * prefetch_stride.
+    static constexpr size_t prefetch_stride = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+  protected:
+    // Comparison function
+    int (*compare)(const T &a, const T &b);
+
+    std::vector<T> keys;
+    size_t count;
+
+    // Index of the first value not less than value, or 0 if there is none
+    size_t lowerBoundIndex(const T &value) const noexcept;
+
+    // Position of the value at index in sorted order
+    size_t getRank(size_t index) const noexcept;
+
+    // Next index in inorder, or 0 after the last
+    size_t nextInorder(size_t index) const noexcept;
+
+  public:
+    /**
+     * Build from size values in increasing order, read from first.
+     */
+    template <class InputIt>
+    FrozenTree(InputIt first, size_t size, int (*compare)(const T &a, const T &b) = default_compare);
+
+    /**
+     * Copy the values of tree, ordered by the same compare function.
+     * Later changes to tree are not reflected in this.
+     */
+    template <class Node>
+    explicit FrozenTree(const BinaryTree<T, Node> &tree);
+
+    bool contains(const T &value) const noexcept;
+
+    // Rank of value, or size() if it is not in the tree
+    size_t find(const T &value) const noexcept;
+
+    // Rank of the first value not less than value, or size() if there is none
+    size_t lowerBound(const T &value) const noexcept;
+
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong
+    void sanityCheck() const {
+        if (keys.size() != count + 1)
+            throw std::logic_error("Array does not match count of elements");
+
+        size_t index = 1;
+        while (index * 2 <= count) index *= 2;
+
+        for (size_t rank = 0; rank < count; rank++) {
+            if (index == 0)
+                throw std::logic_error("Inorder traversal ended early");
+            if (getRank(index) != rank)
+                throw std::logic_error("Rank does not match inorder position");
+
+            const size_t next = nextInorder(index);
+            if (next != 0 && compare(keys[index], keys[next]) >= 0)
+                throw std::logic_error("Inorder traversal is not increasing");
+            index = next;
+        }
+    }
+#endif
+};
+
+#include "FrozenTree.cpp"
+#endif //FROZENTREE_H
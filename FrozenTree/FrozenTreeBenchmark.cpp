@@ -0,0 +1,74 @@
+/*
+ * Performance Benchmark for FrozenTree
+ *
+ * g++ FrozenTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o FrozenTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+// Read only lookups, so each tree is only built once
+#define TESTS RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Complexity()
+
+#include <vector>
+#include "FrozenTree.h"
+#include "../AVLTree/AVLTree.h"
+
+inline int RandomNumber() {
+    return rand();
+}
+
+template <class Tree>
+inline void ConstructRandomTree(Tree &tree, size_t size) {
+    while (tree.size() < size)
+        tree.insert(RandomNumber());
+}
+
+static void BM_AVLTreeContains(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.contains(RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AVLTreeContains)->TESTS;
+
+static void BM_FrozenTreeContains(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    const FrozenTree<int> frozen(tree);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frozen.contains(RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FrozenTreeContains)->TESTS;
+
+static void BM_FrozenTreeFind(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    const FrozenTree<int> frozen(tree);
+    const std::vector<int> values(tree.inorder_begin(), tree.inorder_end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frozen.find(values[RandomNumber() % values.size()]));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FrozenTreeFind)->TESTS;
+
+static void BM_FrozenTreeFreeze(benchmark::State &state) {
+    AVLTree<int> tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FrozenTree<int>(tree));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FrozenTreeFreeze)->TESTS;
+
+BENCHMARK_MAIN();
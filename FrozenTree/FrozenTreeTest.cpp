@@ -0,0 +1,137 @@
+/*
+ * Test cases for testing the sanity of the FrozenTree
+ */
+
+#include <set>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "FrozenTree.h"
+#include "FrozenKaryTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../SplayTree/splayTree.h"
+#include "../AVLTreeFlat/AVLTreeFlat.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "FrozenTree Tests" << endl;
+
+    bool passed = true;
+    {
+        vector<int> values;
+        FrozenTree<int> frozen(values.begin(), 0, compare);
+        frozen.sanityCheck();
+        passed &= frozen.empty() && frozen.size() == 0;
+        passed &= !frozen.contains(0);
+        passed &= frozen.find(0) == 0 && frozen.lowerBound(0) == 0;
+    }
+    cout << "Empty Check                : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        AVLTree<int> tree(compare);
+        for (int i : {50, 20, 80, 10, 30, 70, 90, 60}) tree.insert(i);
+
+        FrozenTree<int> frozen(tree);
+        frozen.sanityCheck();
+        passed &= frozen.size() == 8;
+
+        // Ranks follow the inorder traversal
+        passed &= frozen.find(10) == 0 && frozen.find(50) == 3 && frozen.find(90) == 7;
+        passed &= frozen.find(55) == 8 && !frozen.contains(55);
+        passed &= frozen.lowerBound(55) == 4 && frozen.lowerBound(0) == 0 && frozen.lowerBound(100) == 8;
+
+        // Changes to the tree do not reach the frozen copy
+        tree.remove(50);
+        passed &= frozen.contains(50);
+
+        // Any tree with an inorder traversal can be frozen
+        SplayTree<int> splay(compare);
+        AVLTreeFlat<int> flat(compare);
+        for (int i = 0; i < 100; i++) {
+            splay.insert(i * 2);
+            flat.insert(i * 2);
+        }
+        FrozenTree<int> frozen_splay(splay);
+        FrozenTree<int> frozen_flat(flat.inorder_begin(), flat.size(), compare);
+        passed &= frozen_splay.find(42) == 21 && frozen_flat.find(42) == 21;
+        passed &= frozen_splay.lowerBound(43) == 22 && frozen_flat.lowerBound(43) == 22;
+    }
+    cout << "Rank Check                 : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Every size, up to a few levels, against a sorted vector
+        srand(0);
+        for (size_t size = 1; size < 300; size++) {
+            set<int> values;
+            while (values.size() < size) values.insert(rand() % (int) (4 * size));
+            const vector<int> sorted(values.begin(), values.end());
+
+            FrozenTree<int> frozen(sorted.begin(), sorted.size(), compare);
+            frozen.sanityCheck();
+
+            for (int value = -1; value <= (int) (4 * size); value++) {
+                const size_t rank = lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin();
+                const bool found = values.count(value) != 0;
+                passed &= frozen.lowerBound(value) == rank;
+                passed &= frozen.contains(value) == found;
+                passed &= frozen.find(value) == (found ? rank : sorted.size());
+            }
+        }
+    }
+    cout << "Lookup Check               : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Every instruction set this CPU has, against a sorted vector
+        using Isa = FrozenKaryTree<int>::Isa;
+
+        vector<int> empty;
+        FrozenKaryTree<int> frozen_empty(empty.begin(), 0);
+        passed &= frozen_empty.empty() && !frozen_empty.contains(0) && frozen_empty.lowerBound(0) == 0;
+
+        srand(0);
+        for (size_t size : {1, 15, 16, 17, 100, 271, 272, 273, 5000, 20000}) {
+            set<int> values;
+            while (values.size() < size) values.insert(rand() % (int) (4 * size) - (int) (2 * size));
+            const vector<int> sorted(values.begin(), values.end());
+
+            FrozenKaryTree<int> frozen(sorted.begin(), sorted.size());
+            frozen.sanityCheck();
+
+            for (Isa isa : {Isa::scalar, Isa::sse2, Isa::avx2}) {
+                if (!frozen.useIsa(isa)) continue;
+
+                for (int value = -2 * (int) size - 1; value <= 2 * (int) size; value++) {
+                    const size_t rank = lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin();
+                    const bool found = values.count(value) != 0;
+                    passed &= frozen.lowerBound(value) == rank;
+                    passed &= frozen.contains(value) == found;
+                    passed &= frozen.find(value) == (found ? rank : sorted.size());
+                }
+            }
+        }
+
+        // Extremes of the key type
+        const vector<short> shorts = {-32768, -1, 0, 32767};
+        FrozenKaryTree<short> frozen_shorts(shorts.begin(), shorts.size());
+        frozen_shorts.sanityCheck();
+        passed &= frozen_shorts.find(-32768) == 0 && frozen_shorts.find(32767) == 3;
+        passed &= frozen_shorts.lowerBound(1) == 3 && !frozen_shorts.contains(1);
+
+        vector<char> chars;
+        for (int c = -128; c < 128; c += 3) chars.push_back((char) c);
+        FrozenKaryTree<char> frozen_chars(chars.begin(), chars.size());
+        frozen_chars.sanityCheck();
+        passed &= frozen_chars.find(-128) == 0 && frozen_chars.find(127) == chars.size() - 1;
+        passed &= frozen_chars.lowerBound(-127) == 1;
+    }
+    cout << "K-ary Lookup Check         : " << (passed ? "passed" : "failed") << endl;
+}
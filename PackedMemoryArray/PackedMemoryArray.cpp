@@ -0,0 +1,387 @@
+#ifndef PACKEDMEMORYARRAY_CPP
+#define PACKEDMEMORYARRAY_CPP
+
+#include <utility>
+#include <algorithm>
+#include "PackedMemoryArray.h"
+
+template <class T>
+size_t PackedMemoryArray<T>::getSegments() const noexcept {
+    return segment_count.size();
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::getLevels() const noexcept {
+    // The number of segments is a power of two
+    size_t levels = 0;
+    while ((size_t(2) << levels) <= getSegments()) levels++;
+    return levels;
+}
+
+template <class T>
+double PackedMemoryArray<T>::getUpper(const size_t level) const noexcept {
+    const size_t levels = getLevels();
+    if (levels == 0) return upper_leaf;
+    return upper_leaf - (upper_leaf - upper_root) * level / levels;
+}
+
+template <class T>
+double PackedMemoryArray<T>::getLower(const size_t level) const noexcept {
+    const size_t levels = getLevels();
+    if (levels == 0) return lower_leaf;
+    return lower_leaf + (lower_root - lower_leaf) * level / levels;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::getSegmentSize(const size_t capacity) noexcept {
+    // The smallest power of two not less than log2(capacity)
+    size_t log = 0;
+    while ((size_t(2) << log) <= capacity) log++;
+
+    size_t segment_size = min_segment_size;
+    while (segment_size < log) segment_size *= 2;
+    return segment_size;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::findSegment(const T &value) const noexcept {
+    /**
+     * Binary search over the first value of each segment,
+     * for the last segment starting with a value not greater than value.
+     * Values less than everything belong in the first segment.
+     */
+    size_t low = 0;
+    size_t high = getSegments();
+
+    while (high - low > 1) {
+        const size_t middle = low + (high - low) / 2;
+        if (compare(value, slots[middle * segment_size]) < 0) {
+            high = middle;
+        } else {
+            low = middle;
+        }
+    }
+    return low;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::findInSegment(const size_t segment, const T &value) const noexcept {
+    const auto first = slots.begin() + segment * segment_size;
+    const auto last = first + segment_count[segment];
+    return std::lower_bound(first, last, value, [this](const T &a, const T &b) {
+        return compare(a, b) < 0;
+    }) - first;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::find(const T &value) const noexcept {
+    if (empty()) return end_index;
+
+    const size_t segment = findSegment(value);
+    const size_t position = findInSegment(segment, value);
+
+    if (position < segment_count[segment] && compare(slots[segment * segment_size + position], value) == 0)
+        return segment * segment_size + position;
+    return end_index;
+}
+
+template <class T>
+bool PackedMemoryArray<T>::contains(const T &value) const noexcept {
+    /**
+     * Check if value is present in the array.
+     *
+     * Return true if value is contained. False otherwise.
+     */
+    return find(value) != end_index;
+}
+
+template <class T>
+void PackedMemoryArray<T>::gather(const size_t first, const size_t segments) {
+    buffer.clear();
+    for (size_t segment = first; segment < first + segments; segment++) {
+        const auto start = slots.begin() + segment * segment_size;
+        std::move(start, start + segment_count[segment], std::back_inserter(buffer));
+    }
+}
+
+template <class T>
+void PackedMemoryArray<T>::scatter(const size_t first, const size_t segments) {
+    // Segment i takes the values from i * n / segments up to (i + 1) * n / segments,
+    // so the counts differ by at most one and every segment gets at least n / segments values.
+    const size_t n = buffer.size();
+    for (size_t i = 0; i < segments; i++) {
+        const size_t from = i * n / segments;
+        const size_t to = (i + 1) * n / segments;
+        std::move(buffer.begin() + from, buffer.begin() + to, slots.begin() + (first + i) * segment_size);
+        segment_count[first + i] = to - from;
+    }
+    buffer.clear();
+}
+
+template <class T>
+void PackedMemoryArray<T>::spread(const size_t first, const size_t segments) {
+    gather(first, segments);
+    scatter(first, segments);
+}
+
+template <class T>
+void PackedMemoryArray<T>::resize(const size_t capacity) {
+    gather(0, getSegments());
+
+    // Assign fresh vectors, so shrinking gives the memory back
+    slots = std::vector<T>(capacity);
+    segment_size = getSegmentSize(capacity);
+    segment_count = std::vector<uint32_t>(capacity / segment_size, 0);
+
+    scatter(0, getSegments());
+}
+
+template <class T>
+void PackedMemoryArray<T>::makeSpace(const size_t segment) {
+    /**
+     * Find the smallest window around the full segment that can take another value.
+     * After spreading, every segment of that window has a free slot.
+     */
+    const size_t levels = getLevels();
+
+    for (size_t level = 1; level <= levels; level++) {
+        const size_t window = size_t(1) << level;
+        const size_t first = segment & ~(window - 1);
+
+        size_t values = 0;
+        for (size_t i = first; i < first + window; i++) values += segment_count[i];
+
+        // The threshold alone does not guarantee a gap in every segment of a small window
+        if (values + 1 <= getUpper(level) * window * segment_size && values <= window * (segment_size - 1)) {
+            spread(first, window);
+            return;
+        }
+    }
+
+    // The whole array is too dense
+    resize(capacity() * 2);
+}
+
+template <class T>
+void PackedMemoryArray<T>::refill(const size_t segment) {
+    /**
+     * Find the smallest window around the sparse segment that is dense enough, and spread it.
+     * The lower thresholds leave at least one value for every segment.
+     */
+    if (empty()) {
+        clear();
+        return;
+    }
+
+    const size_t levels = getLevels();
+
+    for (size_t level = 1; level <= levels; level++) {
+        const size_t window = size_t(1) << level;
+        const size_t first = segment & ~(window - 1);
+
+        size_t values = 0;
+        for (size_t i = first; i < first + window; i++) values += segment_count[i];
+
+        if (values >= getLower(level) * window * segment_size) {
+            spread(first, window);
+            return;
+        }
+    }
+
+    // The whole array is too sparse. A single segment may hold any number of values.
+    if (levels == 0) return;
+
+    size_t capacity = this->capacity() / 2;
+    while (capacity > min_segment_size && count < capacity / getSegmentSize(capacity)) capacity /= 2;
+    resize(capacity);
+}
+
+template <class T>
+bool PackedMemoryArray<T>::insert(const T &value) noexcept {
+    /**
+     * Insert a new value into the array.
+     *
+     * Return if successfully inserted
+     * true if the value was not present
+     * false if it was
+     */
+    if (slots.empty()) resize(min_segment_size);
+
+    size_t segment = findSegment(value);
+    size_t position = findInSegment(segment, value);
+
+    if (position < segment_count[segment] && compare(slots[segment * segment_size + position], value) == 0) {
+        // value exists in the array
+        // do not modify, nothing inserted
+        return false;
+    }
+
+    if (segment_count[segment] == segment_size) {
+        makeSpace(segment);
+        segment = findSegment(value);
+        position = findInSegment(segment, value);
+    }
+
+    // Shift the rest of the segment up into its first gap
+    const auto start = slots.begin() + segment * segment_size;
+    std::move_backward(start + position, start + segment_count[segment], start + segment_count[segment] + 1);
+    start[position] = value;
+
+    segment_count[segment]++;
+    count++;
+    return true;
+}
+
+template <class T>
+void PackedMemoryArray<T>::eraseSlot(const size_t slot) {
+    const size_t segment = slot / segment_size;
+    const auto start = slots.begin() + segment * segment_size;
+
+    std::move(slots.begin() + slot + 1, start + segment_count[segment], slots.begin() + slot);
+    segment_count[segment]--;
+    count--;
+
+    if (segment_count[segment] < lower_leaf * segment_size) refill(segment);
+}
+
+template <class T>
+bool PackedMemoryArray<T>::remove(const T &value) noexcept {
+    const size_t slot = find(value);
+    if (slot == end_index) return false;
+
+    eraseSlot(slot);
+    return true;
+}
+
+template <class T>
+T PackedMemoryArray<T>::popMostLeft() {
+    if (empty()) {
+        // There are no values, so nothing valid to return
+        throw std::out_of_range("array is empty");
+    }
+
+    T result = std::move(slots[0]);
+    eraseSlot(0);
+    return result;
+}
+
+template <class T>
+T PackedMemoryArray<T>::popMostRight() {
+    if (empty()) {
+        // There are no values, so nothing valid to return
+        throw std::out_of_range("array is empty");
+    }
+
+    const size_t slot = lastSlot();
+    T result = std::move(slots[slot]);
+    eraseSlot(slot);
+    return result;
+}
+
+template <class T>
+void PackedMemoryArray<T>::clear() noexcept {
+    std::vector<T>().swap(slots);
+    std::vector<uint32_t>().swap(segment_count);
+    std::vector<T>().swap(buffer);
+    segment_size = min_segment_size;
+    count = 0;
+}
+
+template <class T>
+bool PackedMemoryArray<T>::empty() const noexcept {
+    return count == 0;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::size() const noexcept {
+    return count;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::capacity() const noexcept {
+    return slots.size();
+}
+
+template <class T>
+T PackedMemoryArray<T>::getMostLeft() const {
+    if (!empty()) {
+        return slots[0];
+    } else {
+        // There are no values, so nothing valid to return
+        // Raise out of bounds error
+        throw std::out_of_range("array is empty");
+    }
+}
+
+template <class T>
+T PackedMemoryArray<T>::getMostRight() const {
+    if (!empty()) {
+        return slots[lastSlot()];
+    } else {
+        // There are no values, so nothing valid to return
+        // Raise out of bounds error
+        throw std::out_of_range("array is empty");
+    }
+}
+
+template <class T>
+bool PackedMemoryArray<T>::operator==(const PackedMemoryArray &array) const noexcept {
+    // Size must match first
+    if (count != array.count) return false;
+
+    // Gaps may differ, so compare the values in order
+    return std::equal(inorder_begin(), inorder_end(), array.inorder_begin(), array.inorder_end());
+}
+
+template <class T>
+bool PackedMemoryArray<T>::operator!=(const PackedMemoryArray &array) const noexcept {
+    return !operator==(array);
+}
+
+// Traversals
+
+template <class T>
+size_t PackedMemoryArray<T>::nextSlot(const size_t slot) const noexcept {
+    const size_t segment = slot / segment_size;
+    if (slot + 1 < segment * segment_size + segment_count[segment]) return slot + 1;
+    if (segment + 1 < getSegments()) return (segment + 1) * segment_size;
+    return end_index;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::previousSlot(const size_t slot) const noexcept {
+    const size_t segment = slot / segment_size;
+    if (slot > segment * segment_size) return slot - 1;
+    if (segment == 0) return end_index;
+    return (segment - 1) * segment_size + segment_count[segment - 1] - 1;
+}
+
+template <class T>
+size_t PackedMemoryArray<T>::lastSlot() const noexcept {
+    const size_t segment = getSegments() - 1;
+    return segment * segment_size + segment_count[segment] - 1;
+}
+
+// begin() and end() functions for iterators
+
+template <class T>
+typename PackedMemoryArray<T>::inorder_iterator PackedMemoryArray<T>::inorder_begin() const noexcept {
+    return inorder_iterator(this, empty() ? end_index : 0);
+}
+
+template <class T>
+typename PackedMemoryArray<T>::inorder_iterator PackedMemoryArray<T>::inorder_end() const noexcept {
+    return inorder_iterator(this, end_index);
+}
+
+template <class T>
+typename PackedMemoryArray<T>::reverse_inorder_iterator PackedMemoryArray<T>::reverse_inorder_begin() const noexcept {
+    return reverse_inorder_iterator(this, empty() ? end_index : lastSlot());
+}
+
+template <class T>
+typename PackedMemoryArray<T>::reverse_inorder_iterator PackedMemoryArray<T>::reverse_inorder_end() const noexcept {
+    return reverse_inorder_iterator(this, end_index);
+}
+
+#endif //PACKEDMEMORYARRAY_CPP
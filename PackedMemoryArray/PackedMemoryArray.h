@@ -0,0 +1,223 @@
+/*
+ * Implementation of a packed memory array that ignores duplicate entries
+ *
+ * Values are kept in sorted order in one array, with gaps left between them so that
+ * inserting only has to shift a few neighbours.
+ *
+ * The array is split into segments of Θ(log n) slots. Each segment keeps its values packed at its start.
+ * Segments are grouped into windows, pairs of segments, pairs of pairs, and so on up to the whole array.
+ * Every window has density thresholds, looser for small windows and tighter for large ones.
+ * When a segment overflows or runs dry, the smallest enclosing window that is within its thresholds
+ * has its values spread evenly over it. If no window is, the array doubles or halves.
+ * This moves an amortized O(log² n) values per insert or remove.
+ *
+ * Unlike AVLTreeFlat, no operation has to move a large block of the array at once,
+ * and the values stay contiguous and in order under any amount of churn.
+ */
+#ifndef PACKEDMEMORYARRAY_H
+#define PACKEDMEMORYARRAY_H
+
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include "../binaryTree.h"
+
+template <class T>
+class PackedMemoryArray {
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Smallest number of slots in a segment. Also the smallest capacity.
+    static constexpr size_t min_segment_size = 8;
+
+    // Density thresholds of a single segment (the leaves) and the whole array (the root).
+    // The thresholds of the windows in between are interpolated.
+    static constexpr double upper_leaf = 1.0;
+    static constexpr double upper_root = 0.75;
+    static constexpr double lower_leaf = 0.125;
+    static constexpr double lower_root = 0.25;
+
+  protected:
+    // Index past the end of any traversal
+    static constexpr size_t end_index = SIZE_MAX;
+
+    // Comparison function
+    int (*compare)(const T &a, const T &b);
+
+    std::vector<T> slots;
+    // Number of values at the start of each segment
+    std::vector<uint32_t> segment_count;
+    size_t segment_size;
+    size_t count;
+
+    // Reused while spreading a window
+    std::vector<T> buffer;
+
+    size_t getSegments() const noexcept;
+    // Number of window levels above a single segment
+    size_t getLevels() const noexcept;
+    // Density thresholds of a window at level, where level 0 is a single segment
+    double getUpper(size_t level) const noexcept;
+    double getLower(size_t level) const noexcept;
+
+    // Segment the value belongs in. Every segment is non-empty while the array is.
+    size_t findSegment(const T &value) const noexcept;
+    // Position of the first value in segment not less than value
+    size_t findInSegment(size_t segment, const T &value) const noexcept;
+    // Slot holding value, or end_index
+    size_t find(const T &value) const noexcept;
+
+    // Number of slots in each segment, for an array of capacity slots
+    static size_t getSegmentSize(size_t capacity) noexcept;
+
+    // Move the values of segments, starting from first, into buffer
+    void gather(size_t first, size_t segments);
+    // Spread the values in buffer evenly over segments, starting from first
+    void scatter(size_t first, size_t segments);
+    void spread(size_t first, size_t segments);
+
+    // Move every value into an array of a new capacity
+    void resize(size_t capacity);
+
+    // Make space for one more value in segment
+    void makeSpace(size_t segment);
+    // Refill segment after a value is removed from it
+    void refill(size_t segment);
+
+    // Remove the value in slot, shifting the rest of the segment down
+    void eraseSlot(size_t slot);
+
+    // Traversal used by the iterators
+    size_t nextSlot(size_t slot) const noexcept;
+    size_t previousSlot(size_t slot) const noexcept;
+    size_t lastSlot() const noexcept;
+
+  public:
+    explicit PackedMemoryArray(int (*compare)(const T &a, const T &b) = default_compare):
+        compare(compare), segment_size(min_segment_size), count(0) {}
+
+    bool operator==(const PackedMemoryArray &array) const noexcept;
+    bool operator!=(const PackedMemoryArray &array) const noexcept;
+
+    bool contains(const T &value) const noexcept;
+    bool insert(const T &value) noexcept;
+    bool remove(const T &value) noexcept;
+
+    T popMostLeft();
+    T popMostRight();
+
+    void clear() noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    // Number of slots, including gaps
+    size_t capacity() const noexcept;
+
+    T getMostLeft() const;
+    T getMostRight() const;
+
+    /*
+     * Iterators only need the current slot.
+     * Segments are never empty, so the next value is either in the same segment or at the start of the next.
+     */
+    template <bool Reverse>
+    class slot_iterator {
+        // Allow PackedMemoryArray to use the protected constructor
+        friend class PackedMemoryArray;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        slot_iterator(const slot_iterator &iter) = default;
+        slot_iterator& operator=(const slot_iterator &iter) = default;
+
+        // Prefix ++ overload
+        slot_iterator& operator++() {
+            if (slot != end_index)
+                slot = Reverse ? array->previousSlot(slot) : array->nextSlot(slot);
+            return *this;
+        }
+
+        // Postfix ++ overload
+        slot_iterator operator++(int) {
+            slot_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const slot_iterator &iter) const {
+            return slot == iter.slot;
+        }
+
+        bool operator!=(const slot_iterator &iter) const {
+            return slot != iter.slot;
+        }
+
+        T operator*() const {
+            if (slot == end_index)
+                throw std::out_of_range("iterator has been exhausted");
+            return array->slots[slot];
+        }
+
+      protected:
+        slot_iterator(const PackedMemoryArray *array, size_t slot): array(array), slot(slot) {}
+
+        const PackedMemoryArray *array;
+        size_t slot;
+    };
+
+    using inorder_iterator = slot_iterator<false>;
+    using reverse_inorder_iterator = slot_iterator<true>;
+
+    inorder_iterator inorder_begin() const noexcept;
+    inorder_iterator inorder_end() const noexcept;
+
+    reverse_inorder_iterator reverse_inorder_begin() const noexcept;
+    reverse_inorder_iterator reverse_inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong
+    void sanityCheck() const {
+        if (segment_count.size() * segment_size != slots.size())
+            throw std::logic_error("Segments do not cover the array");
+        if ((getSegments() & (getSegments() - 1)) != 0)
+            throw std::logic_error("Number of segments is not a power of two");
+
+        size_t sanity_count = 0;
+        for (size_t segment = 0; segment < getSegments(); segment++) {
+            if (segment_count[segment] > segment_size)
+                throw std::logic_error("Segment holds more values than slots");
+            if (segment_count[segment] == 0)
+                throw std::logic_error("Segment is empty");
+            sanity_count += segment_count[segment];
+        }
+
+        if (count != sanity_count)
+            throw std::logic_error("PackedMemoryArray size does not match count of elements");
+
+        if (count == 0 && !slots.empty())
+            throw std::logic_error("Empty array still holds slots");
+
+        auto it = inorder_begin();
+        if (it != inorder_end()) {
+            T last = *it;
+            for (++it; it != inorder_end(); ++it) {
+                if (compare(last, *it) >= 0)
+                    throw std::logic_error("Values are not increasing");
+                last = *it;
+            }
+        }
+    }
+#endif
+};
+
+#include "PackedMemoryArray.cpp"
+#endif //PACKEDMEMORYARRAY_H
@@ -0,0 +1,81 @@
+/*
+ * Performance Benchmark for PackedMemoryArray
+ *
+ * g++ PackedMemoryArrayBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o PackedMemoryArrayBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+// Default test parameters
+#define TESTS Ranges({{1 << 10, 8 << 10}, {128, 512}})->Complexity()->Threads(1)->ThreadPerCpu()
+
+#include "PackedMemoryArray.h"
+
+inline int RandomNumber() {
+    return rand();
+}
+
+template <class Array>
+inline void ConstructRandomArray(Array &array, size_t size) {
+#ifdef BINARYTREE_SANITY_CHECK
+    array.sanityCheck();
+#endif
+    Array new_array;
+    for (size_t i = 0; i < size; i++)
+        new_array.insert(RandomNumber());
+    array = new_array;
+#ifdef BINARYTREE_SANITY_CHECK
+    array.sanityCheck();
+#endif
+}
+
+static void BM_PackedMemoryArrayInsert(benchmark::State &state) {
+    PackedMemoryArray<int> array;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomArray(array, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            array.insert(RandomNumber());
+        benchmark::DoNotOptimize(array);
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PackedMemoryArrayInsert)->TESTS;
+
+static void BM_PackedMemoryArrayRemove(benchmark::State &state) {
+    PackedMemoryArray<int> array;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomArray(array, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            array.remove(RandomNumber());
+        benchmark::DoNotOptimize(array);
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PackedMemoryArrayRemove)->TESTS;
+
+static void BM_PackedMemoryArrayContains(benchmark::State &state) {
+    PackedMemoryArray<int> array;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomArray(array, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            array.contains(RandomNumber());
+        benchmark::DoNotOptimize(array);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PackedMemoryArrayContains)->TESTS;
+
+BENCHMARK_MAIN();
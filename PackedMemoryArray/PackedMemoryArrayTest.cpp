@@ -0,0 +1,47 @@
+/*
+ * Test cases for testing the sanity of the PackedMemoryArray
+ */
+
+#include <iostream>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "PackedMemoryArray.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "PackedMemoryArray Tests" << endl;
+    test_set<PackedMemoryArray<int>>(compare);
+
+    bool passed = true;
+    {
+        // Nothing is allocated until the first insert
+        PackedMemoryArray<int> array(compare);
+        passed &= array.capacity() == 0;
+
+        // Sequential inserts always land in the same segment, the worst case for spreading
+        for (int i = 0; i < 10000; i++) array.insert(i);
+        for (int i = -1; i >= -10000; i--) array.insert(i);
+        array.sanityCheck();
+        passed &= array.size() == 20000;
+        passed &= array.capacity() <= 4 * array.size();
+
+        // Removing most values gives the space back
+        for (int i = -10000; i < 9990; i++) array.remove(i);
+        array.sanityCheck();
+        passed &= array.size() == 10;
+        passed &= array.capacity() <= 64;
+
+        while (!array.empty()) array.popMostRight();
+        passed &= array.capacity() == 0;
+        array.sanityCheck();
+
+        // So does clearing
+        array.insert(1);
+        array.clear();
+        passed &= array.capacity() == 0;
+    }
+    cout << "Density Check              : " << (passed ? "passed" : "failed") << endl;
+}
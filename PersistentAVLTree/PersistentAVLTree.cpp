@@ -0,0 +1,215 @@
+#ifndef PERSISTENTAVLTREE_CPP
+#define PERSISTENTAVLTREE_CPP
+
+#include "PersistentAVLTree.h"
+
+template <class T>
+void PersistentAVLTree<T>::releaseVersion(void *memory) noexcept {
+    // The last holder frees the version, which lets go of the nodes no other version holds
+    Version *version = static_cast<Version*>(memory);
+    if (version->references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete version;
+}
+
+template <class T>
+PersistentAVLTree<T>::PersistentAVLTree(int (*compare)(const T &a, const T &b)):
+    current(nullptr), tree(compare) {
+    current.store(new Version(tree), std::memory_order_relaxed);
+}
+
+template <class T>
+PersistentAVLTree<T>::PersistentAVLTree(const PersistentAVLTree &tree): current(nullptr) {
+    // Take over the snapshot's reference, and write from the version it holds
+    Snapshot view = tree.snapshot();
+    this->tree = *view.version;
+    current.store(view.version, std::memory_order_release);
+    view.version = nullptr;
+}
+
+template <class T>
+PersistentAVLTree<T>& PersistentAVLTree<T>::operator=(const PersistentAVLTree &tree) {
+    if (this == &tree) return *this;
+
+    Snapshot view = tree.snapshot();
+    std::lock_guard<std::mutex> lock(writing);
+    this->tree = *view.version;
+    Version *old = current.exchange(view.version, std::memory_order_acq_rel);
+    view.version = nullptr;
+    EpochReclaimer::retire(old, releaseVersion);
+    return *this;
+}
+
+template <class T>
+PersistentAVLTree<T>::~PersistentAVLTree() {
+    // Snapshots still holding the version keep it alive
+    releaseVersion(current.load());
+}
+
+template <class T>
+void PersistentAVLTree<T>::publish() {
+    // Readers may still be on the old version, so the tree's reference to it is dropped once they are done
+    Version *old = current.exchange(new Version(tree), std::memory_order_acq_rel);
+    EpochReclaimer::retire(old, releaseVersion);
+}
+
+template <class T>
+typename PersistentAVLTree<T>::Snapshot PersistentAVLTree<T>::snapshot() const {
+    // The tree's own reference is only dropped once no guarded thread can see the version, so it is safe to add one
+    EpochReclaimer::Guard guard;
+    Version *version = current.load(std::memory_order_acquire);
+    version->references.fetch_add(1, std::memory_order_relaxed);
+    return Snapshot(version);
+}
+
+template <class T>
+bool PersistentAVLTree<T>::contains(const T &value) const {
+    EpochReclaimer::Guard guard;
+    return current.load(std::memory_order_acquire)->contains(value);
+}
+
+template <class T>
+bool PersistentAVLTree<T>::insert(const T &value) {
+    std::lock_guard<std::mutex> lock(writing);
+    if (!tree.insert(value)) return false;
+    publish();
+    return true;
+}
+
+template <class T>
+bool PersistentAVLTree<T>::remove(const T &value) {
+    std::lock_guard<std::mutex> lock(writing);
+    if (!tree.remove(value)) return false;
+    publish();
+    return true;
+}
+
+template <class T>
+T PersistentAVLTree<T>::popMostLeft() {
+    std::lock_guard<std::mutex> lock(writing);
+    const T value = tree.popMostLeft();
+    publish();
+    return value;
+}
+
+template <class T>
+T PersistentAVLTree<T>::popMostRight() {
+    std::lock_guard<std::mutex> lock(writing);
+    const T value = tree.popMostRight();
+    publish();
+    return value;
+}
+
+template <class T>
+T PersistentAVLTree<T>::getMostLeft() const {
+    EpochReclaimer::Guard guard;
+    return current.load(std::memory_order_acquire)->getMostLeft();
+}
+
+template <class T>
+T PersistentAVLTree<T>::getMostRight() const {
+    EpochReclaimer::Guard guard;
+    return current.load(std::memory_order_acquire)->getMostRight();
+}
+
+template <class T>
+void PersistentAVLTree<T>::clear() {
+    std::lock_guard<std::mutex> lock(writing);
+    tree.clear();
+    publish();
+}
+
+template <class T>
+bool PersistentAVLTree<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+template <class T>
+size_t PersistentAVLTree<T>::size() const noexcept {
+    EpochReclaimer::Guard guard;
+    return current.load(std::memory_order_acquire)->size();
+}
+
+template <class T>
+size_t PersistentAVLTree<T>::getHeight() const noexcept {
+    EpochReclaimer::Guard guard;
+    return current.load(std::memory_order_acquire)->getHeight();
+}
+
+template <class T>
+PersistentAVLTree<T>::Snapshot::Snapshot(Version *version) noexcept: version(version) {}
+
+template <class T>
+PersistentAVLTree<T>::Snapshot::Snapshot(const Snapshot &snapshot) noexcept: version(snapshot.version) {
+    version->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <class T>
+typename PersistentAVLTree<T>::Snapshot& PersistentAVLTree<T>::Snapshot::operator=(const Snapshot &snapshot) noexcept {
+    if (this == &snapshot) return *this;
+
+    snapshot.version->references.fetch_add(1, std::memory_order_relaxed);
+    releaseVersion(version);
+    version = snapshot.version;
+    return *this;
+}
+
+template <class T>
+PersistentAVLTree<T>::Snapshot::~Snapshot() {
+    // nullptr once handed over to a tree
+    if (version != nullptr) releaseVersion(version);
+}
+
+template <class T>
+bool PersistentAVLTree<T>::Snapshot::contains(const T &value) const {
+    return version->contains(value);
+}
+
+template <class T>
+T PersistentAVLTree<T>::Snapshot::getMostLeft() const {
+    return version->getMostLeft();
+}
+
+template <class T>
+T PersistentAVLTree<T>::Snapshot::getMostRight() const {
+    return version->getMostRight();
+}
+
+template <class T>
+bool PersistentAVLTree<T>::Snapshot::empty() const noexcept {
+    return version->empty();
+}
+
+template <class T>
+size_t PersistentAVLTree<T>::Snapshot::size() const noexcept {
+    return version->size();
+}
+
+template <class T>
+typename PersistentAVLTree<T>::inorder_iterator PersistentAVLTree<T>::Snapshot::inorder_begin() const {
+    inorder_iterator iter;
+    for (const Node *node = version->root; node != nullptr; node = node->left) iter.path.push_back(node);
+    return iter;
+}
+
+template <class T>
+typename PersistentAVLTree<T>::inorder_iterator PersistentAVLTree<T>::Snapshot::inorder_end() const noexcept {
+    return inorder_iterator();
+}
+
+template <class T>
+typename PersistentAVLTree<T>::inorder_iterator PersistentAVLTree<T>::Snapshot::inorder_from(const T &value) const {
+    // Keep the nodes where the search turned left, the last of them is the first value to visit
+    int (*compare)(const T &a, const T &b) = version->compare;
+    inorder_iterator iter;
+    const Node *node = version->root;
+    while (node != nullptr) {
+        if (compare(node->value, value) >= 0) {
+            iter.path.push_back(node);
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    return iter;
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Implementation of a persistent AVLTree, that ignores duplicate entries
+ *
+ * Every version of the tree is a copy-on-write AVLTree<T, SharedAVLTreeNode<T>>, see util/shared_node.h. Writers
+ * change a tree of their own, which copies the O(log n) nodes on the path to the change and shares every other node
+ * with the version before, then publish a copy of it, sharing its root, with one atomic store. Nodes never change
+ * once a published version can reach them.
+ * snapshot() takes a reference to the current version in O(1), and a snapshot keeps seeing exactly the values it
+ * was taken with while writes carry on, so scanning one gives a consistent range scan during heavy ingest.
+ *
+ * Versions are reference counted by the snapshots holding them. The reference the tree itself holds on a replaced
+ * version is dropped through util/epoch_reclaimer.h, so a reader can always take a reference on the version it
+ * loaded. Reads on the tree and on snapshots take no locks and never wait for writers. Writers are serialised by a
+ * mutex.
+ */
+#ifndef PERSISTENTAVLTREE_H
+#define PERSISTENTAVLTREE_H
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <iterator>
+#include <stdexcept>
+#include "../AVLTree/AVLTree.h"
+#include "../util/epoch_reclaimer.h"
+
+template <class T>
+class PersistentAVLTree {
+  public:
+    // Public reference to T for reference
+    using value_type = T;
+
+    // Every version is one of these, sharing its nodes with the versions around it
+    using Tree = AVLTree<T, SharedAVLTreeNode<T>>;
+
+  protected:
+    using Node = SharedAVLTreeNode<T>;
+
+    // A whole tree as it was after one write, never changed once published
+    struct Version: public Tree {
+        // Snapshots holding the version, and the tree while it is current
+        std::atomic<size_t> references;
+
+        // Shares every node of tree, in O(1)
+        explicit Version(const Tree &tree): BinaryTree<T, Node>(tree), Tree(tree), references(1) {}
+
+        // Snapshots walk the nodes themselves, to start a scan anywhere
+        using Tree::root;
+        using Tree::compare;
+    };
+
+    static void releaseVersion(void *version) noexcept;
+
+    std::atomic<Version*> current;
+
+    // Where writes are made, sharing every node it has not changed since with current. Only touched under writing.
+    Tree tree;
+
+    // Held by writers, which make one version at a time
+    std::mutex writing;
+
+    // Make tree the current version. Must hold writing.
+    void publish();
+
+  public:
+    class Snapshot;
+
+    explicit PersistentAVLTree(int (*compare)(const T &a, const T &b) = default_compare);
+
+    // O(1), the copy shares every node with tree. The copy may run alongside writes to tree.
+    PersistentAVLTree(const PersistentAVLTree &tree);
+    PersistentAVLTree& operator=(const PersistentAVLTree &tree);
+    ~PersistentAVLTree();
+
+    // The current version, O(1)
+    Snapshot snapshot() const;
+
+    bool contains(const T &value) const;
+    bool insert(const T &value);
+    bool remove(const T &value);
+
+    // Remove and return the least value, or greatest. Throws std::out_of_range if there is none.
+    T popMostLeft();
+    T popMostRight();
+    T getMostLeft() const;
+    T getMostRight() const;
+
+    void clear();
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+    size_t getHeight() const noexcept;
+
+    class inorder_iterator {
+        // Allow Snapshot to use the protected constructor
+        friend class Snapshot;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        inorder_iterator(const inorder_iterator &iter) = default;
+        inorder_iterator& operator=(const inorder_iterator &iter) = default;
+
+        // Prefix ++ overload
+        inorder_iterator& operator++() {
+            const Node *node = path.back();
+            path.pop_back();
+            for (node = node->right; node != nullptr; node = node->left) path.push_back(node);
+            return *this;
+        }
+
+        // Postfix ++ overload
+        inorder_iterator operator++(int) {
+            inorder_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const inorder_iterator &iter) const {
+            if (path.empty() || iter.path.empty()) return path.empty() == iter.path.empty();
+            return path.back() == iter.path.back();
+        }
+
+        bool operator!=(const inorder_iterator &iter) const {
+            return !operator==(iter);
+        }
+
+        const T& operator*() const {
+            if (path.empty())
+                throw std::out_of_range("iterator has been exhausted");
+            return path.back()->value;
+        }
+
+      protected:
+        inorder_iterator() = default;
+
+        // Nodes whose values are still to come, the next on top
+        std::vector<const Node*> path;
+    };
+
+    /**
+     * One version of the tree, which never changes. Taking, copying and dropping a snapshot are O(1), and it may be
+     * read, and passed between threads, alongside writes to the tree. Its iterators last as long as it does.
+     */
+    class Snapshot {
+        // Allow PersistentAVLTree to use the protected constructor
+        friend class PersistentAVLTree;
+      public:
+        Snapshot(const Snapshot &snapshot) noexcept;
+        Snapshot& operator=(const Snapshot &snapshot) noexcept;
+        ~Snapshot();
+
+        bool contains(const T &value) const;
+        T getMostLeft() const;
+        T getMostRight() const;
+        bool empty() const noexcept;
+        size_t size() const noexcept;
+
+        inorder_iterator inorder_begin() const;
+        inorder_iterator inorder_end() const noexcept;
+
+        // From the least value not less than value, for range scans
+        inorder_iterator inorder_from(const T &value) const;
+
+      protected:
+        // Takes over a reference to version
+        explicit Snapshot(Version *version) noexcept;
+
+        Version *version;
+    };
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong. Safe alongside writes, it checks one snapshot.
+    void sanityCheck() const {
+        const Snapshot view = snapshot();
+        view.version->sanityCheck();
+    }
+#endif
+};
+
+#include "PersistentAVLTree.cpp"
+#endif //PERSISTENTAVLTREE_H
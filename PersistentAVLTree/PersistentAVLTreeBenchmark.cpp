@@ -0,0 +1,103 @@
+/*
+ * Performance Benchmark for PersistentAVLTree against AVLTree
+ * The cost of copying the path on every write, and range scans alongside a writer against a mutex.
+ *
+ * g++ PersistentAVLTreeBenchmark.cpp ../AVLTree/AVLTree.cpp ../binaryTree.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o PersistentAVLTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <random>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#define TESTS Arg(1 << 16)
+#define SCAN_LENGTH 64
+
+#include "PersistentAVLTree.h"
+#include "../AVLTree/AVLTree.h"
+
+template <class Tree>
+static void BM_Churn(benchmark::State &state) {
+    Tree tree;
+    const int range = state.range(0);
+    for (int i = 0; i < range; i += 2) tree.insert(i);
+
+    std::minstd_rand generator(1);
+    for (auto _ : state) {
+        tree.insert(generator() % range);
+        tree.remove(generator() % range);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Churn, AVLTree<int>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, PersistentAVLTree<int>)->TESTS;
+
+static void BM_Snapshot(benchmark::State &state) {
+    PersistentAVLTree<int> tree;
+    for (int i = 0; i < state.range(0); i++) tree.insert(i);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.snapshot().size());
+    }
+}
+BENCHMARK(BM_Snapshot)->TESTS;
+
+// The first thread writes, every other thread scans the least values, under the lock for the whole scan
+static void BM_ScanDuringIngest_Locked(benchmark::State &state) {
+    static AVLTree<int> *tree;
+    static std::mutex mutex;
+    const int range = state.range(0);
+    if (state.thread_index() == 0) {
+        tree = new AVLTree<int>();
+        for (int i = 0; i < range; i += 2) tree->insert(i);
+    }
+
+    std::minstd_rand generator(state.thread_index() + 1);
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (state.thread_index() == 0) {
+            tree->insert(generator() % range);
+            tree->remove(generator() % range);
+        } else {
+            int seen = 0;
+            for (auto it = tree->inorder_begin(); it != tree->inorder_end() && seen < SCAN_LENGTH; ++it) {
+                benchmark::DoNotOptimize(seen++);
+            }
+        }
+    }
+
+    if (state.thread_index() == 0) delete tree;
+}
+BENCHMARK(BM_ScanDuringIngest_Locked)->TESTS->ThreadRange(2, 16)->UseRealTime();
+
+static void BM_ScanDuringIngest_Persistent(benchmark::State &state) {
+    static PersistentAVLTree<int> *tree;
+    const int range = state.range(0);
+    if (state.thread_index() == 0) {
+        tree = new PersistentAVLTree<int>();
+        for (int i = 0; i < range; i += 2) tree->insert(i);
+    }
+
+    std::minstd_rand generator(state.thread_index() + 1);
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            tree->insert(generator() % range);
+            tree->remove(generator() % range);
+        } else {
+            const PersistentAVLTree<int>::Snapshot snapshot = tree->snapshot();
+            int seen = 0;
+            for (auto it = snapshot.inorder_begin(); it != snapshot.inorder_end() && seen < SCAN_LENGTH; ++it) {
+                benchmark::DoNotOptimize(seen++);
+            }
+        }
+    }
+
+    if (state.thread_index() == 0) delete tree;
+}
+BENCHMARK(BM_ScanDuringIngest_Persistent)->TESTS->ThreadRange(2, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,175 @@
+/*
+ * Test cases for testing the sanity of the PersistentAVLTree
+ */
+
+#include <set>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "PersistentAVLTree.h"
+
+using namespace std;
+
+int main() {
+    cout << "PersistentAVLTree Tests" << endl;
+
+    bool passed = true;
+    {
+        PersistentAVLTree<int> tree;
+        passed &= tree.empty() && tree.size() == 0 && tree.getHeight() == 0;
+        passed &= !tree.contains(0) && !tree.remove(0);
+
+        PersistentAVLTree<int>::Snapshot snapshot = tree.snapshot();
+        passed &= snapshot.empty() && snapshot.inorder_begin() == snapshot.inorder_end();
+        passed &= snapshot.inorder_from(0) == snapshot.inorder_end();
+
+        try {
+            tree.popMostLeft();
+            passed = false;
+        } catch (std::out_of_range &) {}
+        try {
+            snapshot.getMostRight();
+            passed = false;
+        } catch (std::out_of_range &) {}
+        tree.sanityCheck();
+    }
+    cout << "Empty Check                : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        PersistentAVLTree<int> tree;
+        for (int i : {5, 3, 8, 1, 4, 7, 9, 2, 6}) passed &= tree.insert(i);
+        passed &= !tree.insert(5);
+        passed &= tree.size() == 9 && tree.getHeight() == 4;
+        passed &= tree.contains(1) && tree.contains(9) && !tree.contains(0) && !tree.contains(10);
+        passed &= tree.getMostLeft() == 1 && tree.getMostRight() == 9;
+        tree.sanityCheck();
+
+        // A snapshot keeps what it was taken with
+        PersistentAVLTree<int>::Snapshot before = tree.snapshot();
+        passed &= tree.remove(5) && !tree.remove(5);
+        passed &= tree.popMostLeft() == 1 && tree.popMostRight() == 9;
+        passed &= tree.size() == 6 && !tree.contains(5);
+        tree.sanityCheck();
+
+        const int expected[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        passed &= before.size() == 9 && before.contains(5);
+        passed &= equal(before.inorder_begin(), before.inorder_end(), begin(expected), end(expected));
+        passed &= equal(before.inorder_from(4), before.inorder_end(), begin(expected) + 3, end(expected));
+
+        const int after[] = {2, 3, 4, 6, 7, 8};
+        PersistentAVLTree<int>::Snapshot snapshot = tree.snapshot();
+        passed &= equal(snapshot.inorder_begin(), snapshot.inorder_end(), begin(after), end(after));
+        passed &= equal(snapshot.inorder_from(5), snapshot.inorder_end(), begin(after) + 3, end(after));
+        passed &= snapshot.inorder_from(9) == snapshot.inorder_end();
+
+        // The copy shares every node, and neither sees the other's writes
+        PersistentAVLTree<int> copy = tree;
+        passed &= copy.insert(10) && !tree.contains(10);
+        passed &= tree.insert(0) && !copy.contains(0);
+        copy.sanityCheck();
+
+        // A snapshot outlives its tree
+        const PersistentAVLTree<int>::Snapshot kept = PersistentAVLTree<int>(copy).snapshot();
+        passed &= kept.size() == 7 && kept.contains(10) && kept.getMostRight() == 10;
+
+        tree.clear();
+        passed &= tree.empty() && copy.size() == 7 && snapshot.size() == 6;
+        tree.sanityCheck();
+    }
+    cout << "Insert Remove Check        : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Random churn against std::set, keeping old snapshots alongside to check they never change
+        PersistentAVLTree<int> tree;
+        set<int> reference;
+        vector<pair<PersistentAVLTree<int>::Snapshot, set<int>>> snapshots;
+        srand(0);
+        for (int i = 0; i < 100000; i++) {
+            const int value = rand() % 5000;
+            switch (rand() % 3) {
+                case 0:
+                    passed &= tree.contains(value) == (reference.count(value) != 0);
+                    break;
+                case 1:
+                    passed &= tree.insert(value) == reference.insert(value).second;
+                    break;
+                default:
+                    passed &= tree.remove(value) == (reference.erase(value) != 0);
+                    break;
+            }
+
+            if (i % 1000 == 0) {
+                tree.sanityCheck();
+                snapshots.emplace_back(tree.snapshot(), reference);
+                if (snapshots.size() > 16) snapshots.erase(snapshots.begin());
+            }
+            if (i % 5000 == 0) {
+                for (auto &snapshot : snapshots) {
+                    const int from = rand() % 5000;
+                    passed &= snapshot.first.size() == snapshot.second.size();
+                    passed &= equal(snapshot.first.inorder_begin(), snapshot.first.inorder_end(),
+                                    snapshot.second.begin(), snapshot.second.end());
+                    passed &= equal(snapshot.first.inorder_from(from), snapshot.first.inorder_end(),
+                                    snapshot.second.lower_bound(from), snapshot.second.end());
+                }
+            }
+        }
+        passed &= tree.size() == reference.size();
+
+        // Drain from both ends
+        while (!reference.empty()) {
+            passed &= tree.popMostLeft() == *reference.begin();
+            reference.erase(reference.begin());
+            if (reference.empty()) break;
+            passed &= tree.popMostRight() == *reference.rbegin();
+            reference.erase(prev(reference.end()));
+        }
+        passed &= tree.empty();
+        tree.sanityCheck();
+    }
+    cout << "Churn Check                : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // One writer ingests 0, 1, 2, ... and then pops from the front while readers scan snapshots, so every
+        // snapshot must hold a run of consecutive values
+        PersistentAVLTree<int> tree;
+        const int values = 50000, readers = 4;
+        atomic<bool> done(false), failed(false);
+        vector<thread> workers;
+
+        for (int t = 0; t < readers; t++) {
+            workers.emplace_back([&tree, &done, &failed]() {
+                while (!done) {
+                    const PersistentAVLTree<int>::Snapshot snapshot = tree.snapshot();
+                    const int first = snapshot.empty() ? 0 : snapshot.getMostLeft();
+                    int expected = first;
+                    for (auto it = snapshot.inorder_begin(); it != snapshot.inorder_end(); ++it) {
+                        if (*it != expected++) failed = true;
+                    }
+                    if (size_t(expected - first) != snapshot.size()) failed = true;
+                    if (!snapshot.empty() && !tree.contains(snapshot.getMostRight())) failed = true;
+                }
+            });
+        }
+
+        for (int i = 0; i < values; i++) passed &= tree.insert(i);
+        for (int i = 0; i < values / 2; i++) passed &= tree.popMostLeft() == i;
+        done = true;
+        for (thread &worker : workers) worker.join();
+
+        passed &= !failed && tree.size() == size_t(values - values / 2);
+        tree.sanityCheck();
+    }
+    cout << "Concurrent Check           : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,320 @@
+#ifndef REDBLACKTREE_CPP
+#define REDBLACKTREE_CPP
+
+#include <cassert>
+#include "RedBlackTree.h"
+
+template <class T, class Node>
+bool RedBlackTree<T, Node>::contains(const T &value) noexcept {
+    /**
+     * Check if value is present in the tree.
+     */
+    const Node *node = root;
+    while (node != nullptr) {
+        auto cmp = compare(value, node->value);
+        if (cmp == 0) return true;
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return false;
+}
+
+template <class T, class Node>
+void RedBlackTree<T, Node>::leftRotation(Node *&node) {
+    /**
+     * Rotate the tree left about the given node. Colours are left to the caller.
+     *
+     *        B                D
+     *       / \              / \
+     *      A   D     ->     B   E
+     *         / \          / \
+     *        C   E        A   C
+     */
+    assert(node != nullptr && node->right != nullptr);
+
+    Node *temp = node->right;
+    node->right = temp->left;
+    temp->left = node;
+    node = temp;
+}
+
+template <class T, class Node>
+void RedBlackTree<T, Node>::rightRotation(Node *&node) {
+    /**
+     * Rotate the tree right about the given node. Colours are left to the caller.
+     *
+     *        D                B
+     *       / \              / \
+     *      B   E     ->     A   D
+     *     / \                  / \
+     *    A   C                C   E
+     */
+    assert(node != nullptr && node->left != nullptr);
+
+    Node *temp = node->left;
+    node->left = temp->right;
+    temp->right = node;
+    node = temp;
+}
+
+template <class T, class Node>
+bool RedBlackTree<T, Node>::insert(const T &value) noexcept {
+    bool result = BinaryTree<T, Node>::insert(value);
+
+    // Recolouring may pass a red all the way up. The root is always black.
+    if (root != nullptr) root->red = false;
+    return result;
+}
+
+/**
+ * An internal insert command that inserts a new value recursively.
+ *
+ * Returns true if the value is inserted.
+ * Returns false if the value is found in the tree, and the tree is not modified.
+ */
+template <class T, class Node>
+bool RedBlackTree<T, Node>::insertInternal(Node *&node, const T &value) {
+    // Handle if node does not exist
+    if (node == nullptr) {
+        node = new Node(value);
+        return true;
+    }
+
+    auto cmp = compare(value, node->value);
+
+    if (cmp == 0) {
+        // value exists in the tree
+        // do not modify, nothing inserted
+        return false;
+    }
+
+    Node *&child = cmp < 0 ? node->left : node->right;
+    if (!insertInternal(child, value))
+        return false;
+
+    // A red child with a red child can only be fixed from here, its parent
+    if (child->red && (isRed(child->left) || isRed(child->right)))
+        fixRedChild(node);
+
+    return true;
+}
+
+template <class T, class Node>
+void RedBlackTree<T, Node>::fixRedChild(Node *&node) {
+    // node must be black, a red child of a red node was never allowed
+    assert(!node->red);
+
+    if (isRed(node->left) && isRed(node->right)) {
+        /**
+         * Both children are red. Push the black down a level instead of rotating.
+         * node may now be a red child of a red node, which its grandparent will fix.
+         */
+        node->red = true;
+        node->left->red = false;
+        node->right->red = false;
+        return;
+    }
+
+    /**
+     * Only one child is red. Rotate its red child up to take node's place, and colour it black.
+     * The subtree's black height is unchanged, so nothing above needs fixing.
+     */
+    if (isRed(node->left)) {
+        // Inner case, rotate it to the outside first
+        if (isRed(node->left->right)) leftRotation(node->left);
+        rightRotation(node);
+    } else {
+        if (isRed(node->right->left)) rightRotation(node->right);
+        leftRotation(node);
+    }
+    node->red = false;
+    node->left->red = true;
+    node->right->red = true;
+}
+
+template <class T, class Node>
+bool RedBlackTree<T, Node>::fixLeftShorter(Node *&node) {
+    /**
+     * The left subtree has one less black node on its paths than the right.
+     * Since it is at least one, the right sibling must exist.
+     */
+    Node *sibling = node->right;
+    assert(sibling != nullptr);
+
+    if (sibling->red) {
+        // Rotate so the black child of the sibling becomes the sibling. node is red below that,
+        // and a red node always fixes it without passing anything up.
+        leftRotation(node);
+        node->red = false;
+        node->left->red = true;
+        bool shorter = fixLeftShorter(node->left);
+        assert(!shorter);
+        return shorter;
+    }
+
+    if (!isRed(sibling->left) && !isRed(sibling->right)) {
+        // Remove a black from the sibling's side too. If node is red, making it black makes up for both.
+        sibling->red = true;
+        if (node->red) {
+            node->red = false;
+            return false;
+        }
+        return true;
+    }
+
+    // The sibling has a red child. Move it to the outside, then rotate the sibling up.
+    if (!isRed(sibling->right)) {
+        rightRotation(node->right);
+        node->right->red = false;
+        node->right->right->red = true;
+    }
+    leftRotation(node);
+    node->red = node->left->red;
+    node->left->red = false;
+    node->right->red = false;
+    return false;
+}
+
+template <class T, class Node>
+bool RedBlackTree<T, Node>::fixRightShorter(Node *&node) {
+    // Mirror of fixLeftShorter
+    Node *sibling = node->left;
+    assert(sibling != nullptr);
+
+    if (sibling->red) {
+        rightRotation(node);
+        node->red = false;
+        node->right->red = true;
+        bool shorter = fixRightShorter(node->right);
+        assert(!shorter);
+        return shorter;
+    }
+
+    if (!isRed(sibling->left) && !isRed(sibling->right)) {
+        sibling->red = true;
+        if (node->red) {
+            node->red = false;
+            return false;
+        }
+        return true;
+    }
+
+    if (!isRed(sibling->left)) {
+        leftRotation(node->left);
+        node->left->red = false;
+        node->left->left->red = true;
+    }
+    rightRotation(node);
+    node->red = node->right->red;
+    node->left->red = false;
+    node->right->red = false;
+    return false;
+}
+
+template <class T, class Node>
+Node* RedBlackTree<T, Node>::popMostLeftInternal(Node *&node) {
+    bool shorter;
+    return popMostLeftInternal(node, shorter);
+}
+
+template <class T, class Node>
+Node* RedBlackTree<T, Node>::popMostLeftInternal(Node *&node, bool &shorter) {
+    Node *temp;
+    if (node->left != nullptr) {
+        temp = popMostLeftInternal(node->left, shorter);
+        if (shorter) shorter = fixLeftShorter(node);
+    } else {
+        // Return node, but remove from tree.
+        temp = node;
+        node = node->right;
+
+        // A lone child must be a red leaf. Made black, it takes the place of the black removed.
+        if (node != nullptr) {
+            node->red = false;
+            shorter = false;
+        } else {
+            shorter = !temp->red;
+        }
+    }
+    return temp;
+}
+
+template <class T, class Node>
+Node* RedBlackTree<T, Node>::popMostRightInternal(Node *&node) {
+    bool shorter;
+    return popMostRightInternal(node, shorter);
+}
+
+template <class T, class Node>
+Node* RedBlackTree<T, Node>::popMostRightInternal(Node *&node, bool &shorter) {
+    Node *temp;
+    if (node->right != nullptr) {
+        temp = popMostRightInternal(node->right, shorter);
+        if (shorter) shorter = fixRightShorter(node);
+    } else {
+        temp = node;
+        node = node->left;
+
+        if (node != nullptr) {
+            node->red = false;
+            shorter = false;
+        } else {
+            shorter = !temp->red;
+        }
+    }
+    return temp;
+}
+
+template <class T, class Node>
+bool RedBlackTree<T, Node>::removeInternal(Node *&node, const T &value) {
+    bool shorter;
+    return removeInternal(node, value, shorter);
+}
+
+template <class T, class Node>
+bool RedBlackTree<T, Node>::removeInternal(Node *&node, const T &value, bool &shorter) {
+    // If the stack has a nullptr on top, then failed to find node.
+    if (node == nullptr) return false;
+
+    auto cmp = compare(value, node->value);
+
+    if (cmp == 0) {
+        if (node->left != nullptr && node->right != nullptr) {
+            // Replace this node with the most left value of its right branch.
+            Node *temp = popMostLeftInternal(node->right, shorter);
+
+            // Move temp into the place of node, taking its colour
+            temp->left = node->left;
+            temp->right = node->right;
+            temp->red = node->red;
+
+            this->destroyNode(node);
+            node = temp;
+            if (shorter) shorter = fixRightShorter(node);
+        } else {
+            // At most one child, which must be a red leaf
+            Node *temp = node->left != nullptr ? node->left : node->right;
+
+            if (temp != nullptr) {
+                temp->red = false;
+                shorter = false;
+            } else {
+                shorter = !node->red;
+            }
+
+            this->destroyNode(node);
+            node = temp;
+        }
+        return true;
+    }
+
+    // Otherwise, handle recursion
+    if (cmp < 0) {
+        if (!removeInternal(node->left, value, shorter)) return false;
+        if (shorter) shorter = fixLeftShorter(node);
+    } else {
+        if (!removeInternal(node->right, value, shorter)) return false;
+        if (shorter) shorter = fixRightShorter(node);
+    }
+    return true;
+}
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Implementation of the RedBlackTree that ignores duplicate entries
+ *
+ * Red-black trees may be up to twice as deep as the shortest path, so lookups can visit more nodes than an AVLTree.
+ * In exchange an insert makes at most two rotations, and a remove at most three.
+ * Anything further up the tree is fixed by recolouring only, so churn writes fewer pointers.
+ */
+#ifndef REDBLACKTREE_H
+#define REDBLACKTREE_H
+
+#include <cstdint>
+#include "../binaryTree.h"
+
+#ifdef BINARYTREE_SANITY_CHECK
+#include <stdexcept> // For sanity error handling
+#endif
+
+template <class T>
+struct RedBlackTreeNode {
+    // Public reference to T for reference
+    using value_type = T;
+
+    // New nodes are red, so inserting them never changes a black height
+    explicit RedBlackTreeNode(const T &value): left(nullptr), right(nullptr), red(true), value(value) {}
+
+    // Copy constructor
+    RedBlackTreeNode(const RedBlackTreeNode &tree) = default;
+
+    RedBlackTreeNode *left;
+    RedBlackTreeNode *right;
+
+    bool red;
+
+    T value;
+};
+
+template <class T, class Node = RedBlackTreeNode<T>>
+class RedBlackTree: virtual public BinaryTree<T, Node> {
+  public:
+    using value_type = T;
+
+  protected:
+    using BinaryTree<T, Node>::root;
+    using BinaryTree<T, Node>::compare;
+
+    static bool isRed(const Node *node) noexcept {return node != nullptr && node->red;}
+
+    bool insertInternal(Node *&node, const T &value);
+    // Fix a red child of node that has a red child of its own. node is black.
+    void fixRedChild(Node *&node);
+
+    void leftRotation(Node *&node);
+    void rightRotation(Node *&node);
+
+    /**
+     * Removals set shorter if the black height of node's subtree dropped by one.
+     * The parent then fixes it, or passes it up.
+     */
+    bool removeInternal(Node *&node, const T &value);
+    bool removeInternal(Node *&node, const T &value, bool &shorter);
+    Node* popMostLeftInternal(Node *&node);
+    Node* popMostLeftInternal(Node *&node, bool &shorter);
+    Node* popMostRightInternal(Node *&node);
+    Node* popMostRightInternal(Node *&node, bool &shorter);
+
+    // Fix node after its left or right subtree lost a black level. Returns true if node's own subtree is shorter.
+    bool fixLeftShorter(Node *&node);
+    bool fixRightShorter(Node *&node);
+
+  public:
+    using BinaryTree<T, Node>::empty;
+
+    explicit RedBlackTree(int (*compare)(const T &a, const T &b) = default_compare): BinaryTree<T, Node>(compare) {}
+
+    // Copy constructor
+    RedBlackTree(const RedBlackTree &tree): BinaryTree<T, Node>(tree) {};
+
+    bool contains(const T &value) noexcept override;
+
+    bool insert(const T &value) noexcept override;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    void sanityCheck() const override {
+        BinaryTree<T, Node>::sanityCheck();
+
+        if (isRed(root)) throw std::logic_error("Root is red");
+    }
+
+  protected:
+    // Black nodes along the left edge. Only the same as every other path once the subtree is known valid.
+    static size_t sanityBlackHeight(const Node *node) {
+        size_t height = 0;
+        for (; node != nullptr; node = node->left) height += !node->red;
+        return height;
+    }
+
+    void sanityCheckInternal(const Node* const &node) const override {
+        // Checks the children first, so their left edges give their black heights
+        BinaryTree<T, Node>::sanityCheckInternal(node);
+
+        if (node->red && (isRed(node->left) || isRed(node->right)))
+            throw std::logic_error("Red node has a red child");
+
+        if (sanityBlackHeight(node->left) != sanityBlackHeight(node->right))
+            throw std::logic_error("Left and right have different black heights");
+    }
+#endif
+};
+#include "RedBlackTree.cpp"
+#endif
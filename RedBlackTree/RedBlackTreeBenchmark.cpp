@@ -0,0 +1,25 @@
+/*
+ * Performance Benchmark for RedBlackTree
+ *
+ * g++ RedBlackTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o RedBlackTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "RedBlackTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../util/tree_benchmark.h"
+
+BENCHMARK_TEMPLATE(BM_Insert, RedBlackTree<int>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Remove, RedBlackTree<int>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Contains, RedBlackTree<int>)->TESTS;
+
+BENCHMARK_TEMPLATE(BM_Replace, AVLTree<int>)->CHURN_TESTS;
+BENCHMARK_TEMPLATE(BM_Replace, RedBlackTree<int>)->CHURN_TESTS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,23 @@
+/*
+ * Test cases for testing the sanity of the RedBlackTree
+ */
+
+#include <cmath>
+#include <iostream>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "RedBlackTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "RedBlackTree Tests" << endl;
+    test_set<RedBlackTree<int>>(compare);
+
+    // No path is more than twice as long as any other, bounding the height by 2 log2(n + 1)
+    const bool passed = check_bounded_height<RedBlackTree<int>>(
+        [](size_t size) { return 2 * size_t(ceil(log2(size + 1))); }, compare);
+    cout << "Height Check               : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,208 @@
+#ifndef SCAPEGOATTREE_CPP
+#define SCAPEGOATTREE_CPP
+
+#include <algorithm>
+#include "ScapegoatTree.h"
+
+template <class T, class Node>
+bool ScapegoatTree<T, Node>::contains(const T &value) noexcept {
+    /**
+     * Check if value is present in the tree.
+     */
+    const Node *node = root;
+    while (node != nullptr) {
+        auto cmp = compare(value, node->value);
+        if (cmp == 0) return true;
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return false;
+}
+
+template <class T, class Node>
+size_t ScapegoatTree<T, Node>::countNodes(const Node *node) noexcept {
+    size_t nodes = 0;
+    // Count down the right edge, recursing to the left
+    for (; node != nullptr; node = node->right) {
+        nodes += 1 + countNodes(node->left);
+    }
+    return nodes;
+}
+
+template <class T, class Node>
+Node* ScapegoatTree<T, Node>::flatten(Node *node, Node *tail) noexcept {
+    // Work up the right edge from the bottom, so each node links to the list of everything after it
+    while (node != nullptr) {
+        node->right = flatten(node->right, tail);
+        tail = node;
+        node = node->left;
+    }
+    return tail;
+}
+
+template <class T, class Node>
+Node* ScapegoatTree<T, Node>::build(const size_t size, Node *&list) noexcept {
+    if (size == 0) return nullptr;
+
+    // Build the left half first, the next node in the list is then the middle
+    const size_t left_size = (size - 1) / 2;
+    Node *left = build(left_size, list);
+
+    Node *node = list;
+    list = list->right;
+
+    node->left = left;
+    node->right = build(size - 1 - left_size, list);
+    return node;
+}
+
+template <class T, class Node>
+void ScapegoatTree<T, Node>::rebuild(Node *&node, const size_t size) noexcept {
+    Node *list = flatten(node, nullptr);
+    node = build(size, list);
+}
+
+template <class T, class Node>
+bool ScapegoatTree<T, Node>::insert(const T &value) noexcept {
+    bool result = BinaryTree<T, Node>::insert(value);
+    max_count = std::max(max_count, count);
+    return result;
+}
+
+template <class T, class Node>
+bool ScapegoatTree<T, Node>::insertInternal(Node *&node, const T &value) {
+    size_t size;
+    return insertInternal(node, value, 0, size);
+}
+
+/**
+ * An internal insert command that inserts a new value recursively.
+ *
+ * Returns true if the value is inserted.
+ * Returns false if the value is found in the tree, and the tree is not modified.
+ */
+template <class T, class Node>
+bool ScapegoatTree<T, Node>::insertInternal(Node *&node, const T &value, const size_t depth, size_t &size) {
+    // Handle if node does not exist
+    if (node == nullptr) {
+        node = new Node(value);
+        // count is only updated after the insert, so the tree will hold count + 1
+        size = depth > maxDepth(count + 1) ? 1 : 0;
+        return true;
+    }
+
+    auto cmp = compare(value, node->value);
+
+    if (cmp == 0) {
+        // value exists in the tree
+        // do not modify, nothing inserted
+        return false;
+    }
+
+    Node *child = nullptr;
+    if (cmp < 0) {
+        if (!insertInternal(node->left, value, depth + 1, size)) return false;
+        child = node->right;
+    } else {
+        if (!insertInternal(node->right, value, depth + 1, size)) return false;
+        child = node->left;
+    }
+
+    // Nothing to do unless the new node is too deep
+    if (size == 0) return true;
+
+    // size holds the side the value went down. Count the other side to get the whole.
+    const size_t child_size = size;
+    size = child_size + 1 + countNodes(child);
+
+    if (child_size * alpha_denominator > size * alpha_numerator) {
+        // node is the scapegoat
+        rebuild(node, size);
+        size = 0;
+    }
+
+    return true;
+}
+
+template <class T, class Node>
+void ScapegoatTree<T, Node>::shrink() noexcept {
+    if (count * alpha_denominator < max_count * alpha_numerator) {
+        rebuild(root, count);
+        max_count = count;
+    }
+}
+
+template <class T, class Node>
+bool ScapegoatTree<T, Node>::remove(const T &value) noexcept {
+    bool result = BinaryTree<T, Node>::remove(value);
+    if (result) shrink();
+    return result;
+}
+
+template <class T, class Node>
+T ScapegoatTree<T, Node>::popMostLeft() {
+    T result = BinaryTree<T, Node>::popMostLeft();
+    shrink();
+    return result;
+}
+
+template <class T, class Node>
+T ScapegoatTree<T, Node>::popMostRight() {
+    T result = BinaryTree<T, Node>::popMostRight();
+    shrink();
+    return result;
+}
+
+template <class T, class Node>
+void ScapegoatTree<T, Node>::clear() noexcept {
+    BinaryTree<T, Node>::clear();
+    max_count = 0;
+}
+
+template <class T, class Node>
+Node* ScapegoatTree<T, Node>::popMostLeftInternal(Node *&node) {
+    Node **slot = &node;
+    while ((*slot)->left != nullptr) slot = &(*slot)->left;
+
+    // Return node, but remove from tree.
+    Node *temp = *slot;
+    *slot = temp->right;
+    return temp;
+}
+
+template <class T, class Node>
+Node* ScapegoatTree<T, Node>::popMostRightInternal(Node *&node) {
+    Node **slot = &node;
+    while ((*slot)->right != nullptr) slot = &(*slot)->right;
+
+    // Return node, but remove from tree.
+    Node *temp = *slot;
+    *slot = temp->left;
+    return temp;
+}
+
+template <class T, class Node>
+bool ScapegoatTree<T, Node>::removeInternal(Node *&node, const T &value) {
+    // Removing never makes a node deeper, so balance is only restored by shrink()
+    Node **slot = &node;
+    while (*slot != nullptr) {
+        auto cmp = compare(value, (*slot)->value);
+
+        if (cmp == 0) {
+            Node *temp = *slot;
+            if (temp->left != nullptr && temp->right != nullptr) {
+                // Replace with the most left value of its right branch
+                Node *next = popMostLeftInternal(temp->right);
+                next->left = temp->left;
+                next->right = temp->right;
+                *slot = next;
+            } else {
+                *slot = temp->left != nullptr ? temp->left : temp->right;
+            }
+            this->destroyNode(temp);
+            return true;
+        }
+        slot = cmp < 0 ? &(*slot)->left : &(*slot)->right;
+    }
+    return false;
+}
+#endif //SCAPEGOATTREE_CPP
@@ -0,0 +1,124 @@
+/*
+ * Implementation of a Scapegoat tree that ignores duplicate entries
+ *
+ * Nodes hold nothing but their children and value, so no balance data is padded into every node.
+ * Instead an insert that lands too deep walks back up to the first ancestor whose subtree is
+ * out of weight balance, the scapegoat, and rebuilds that subtree perfectly balanced in linear time.
+ * Removes rebuild the whole tree once it has shrunk by a fraction since its last rebuild.
+ * Both are amortized O(log n), and lookups are O(log n) in the worst case.
+ */
+#ifndef SCAPEGOATTREE_H
+#define SCAPEGOATTREE_H
+
+#include <cmath>
+#include <cstdint>
+#include "../binaryTree.h"
+
+#ifdef BINARYTREE_SANITY_CHECK
+#include <stdexcept> // For sanity error handling
+#endif
+
+template <class T>
+struct ScapegoatTreeNode {
+    // Public reference to T for reference
+    using value_type = T;
+
+    explicit ScapegoatTreeNode(const T &value): left(nullptr), right(nullptr), value(value) {}
+
+    // Copy constructor
+    ScapegoatTreeNode(const ScapegoatTreeNode &tree) = default;
+
+    ScapegoatTreeNode *left;
+    ScapegoatTreeNode *right;
+
+    T value;
+};
+
+template <class T, class Node = ScapegoatTreeNode<T>>
+class ScapegoatTree: virtual public BinaryTree<T, Node> {
+  public:
+    using value_type = T;
+
+    /*
+     * Weight balance factor alpha, as a fraction. A child may hold at most alpha of its parent's subtree.
+     * Closer to 1/2 gives shallower trees and more rebuilds.
+     */
+    static constexpr size_t alpha_numerator = 2;
+    static constexpr size_t alpha_denominator = 3;
+
+  protected:
+    using BinaryTree<T, Node>::root;
+    using BinaryTree<T, Node>::count;
+    using BinaryTree<T, Node>::compare;
+
+    // Largest count since the whole tree was last rebuilt
+    size_t max_count;
+
+    // Deepest a node may be in a tree of size nodes, log base 1 / alpha of size
+    static size_t maxDepth(size_t size) noexcept {
+        static const double log_inverse_alpha = std::log((double) alpha_denominator / alpha_numerator);
+        return (size_t) (std::log((double) size) / log_inverse_alpha);
+    }
+
+    // Nodes in the subtree at node
+    static size_t countNodes(const Node *node) noexcept;
+
+    // Link the subtree at node into a list through the right pointers, in order, followed by tail
+    static Node* flatten(Node *node, Node *tail) noexcept;
+    // Build a perfectly balanced tree from the next size nodes of list, moving list past them
+    static Node* build(size_t size, Node *&list) noexcept;
+    // Rebuild the subtree at node, which holds size nodes, perfectly balanced
+    static void rebuild(Node *&node, size_t size) noexcept;
+
+    bool insertInternal(Node *&node, const T &value);
+    /**
+     * Insert value under node, at the given depth.
+     *
+     * If the new node is too deep, size is set to the size of node's subtree, until a scapegoat is rebuilt.
+     * Otherwise it is zero.
+     */
+    bool insertInternal(Node *&node, const T &value, size_t depth, size_t &size);
+
+    bool removeInternal(Node *&node, const T &value);
+    Node* popMostLeftInternal(Node *&node);
+    Node* popMostRightInternal(Node *&node);
+
+    // Rebuild the whole tree if removes have shrunk it past alpha of max_count
+    void shrink() noexcept;
+
+  public:
+    using BinaryTree<T, Node>::empty;
+
+    explicit ScapegoatTree(int (*compare)(const T &a, const T &b) = default_compare):
+        BinaryTree<T, Node>(compare), max_count(0) {}
+
+    // Copy constructor
+    ScapegoatTree(const ScapegoatTree &tree): BinaryTree<T, Node>(tree), max_count(tree.max_count) {};
+
+    bool contains(const T &value) noexcept override;
+
+    bool insert(const T &value) noexcept override;
+    bool remove(const T &value) noexcept override;
+
+    T popMostLeft() override;
+    T popMostRight() override;
+
+    void clear() noexcept override;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    void sanityCheck() const override {
+        BinaryTree<T, Node>::sanityCheck();
+
+        if (count > max_count)
+            throw std::logic_error("Tree holds more than its largest count");
+        if (count * alpha_denominator < max_count * alpha_numerator)
+            throw std::logic_error("Tree has shrunk too far without a rebuild");
+
+        // Loosely alpha height balanced, a removal may have happened since the tree was last this size
+        if (root != nullptr && this->getHeight() > maxDepth(max_count) + 1)
+            throw std::logic_error("Tree is too deep");
+    }
+#endif
+};
+#include "ScapegoatTree.cpp"
+#endif //SCAPEGOATTREE_H
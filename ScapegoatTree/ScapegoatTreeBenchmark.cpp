@@ -0,0 +1,94 @@
+/*
+ * Performance Benchmark for ScapegoatTree, next to AVLTree
+ *
+ * g++ ScapegoatTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o ScapegoatTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+// Each tree is only built once
+#define TESTS RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Complexity()
+
+#include <vector>
+#include "ScapegoatTree.h"
+#include "../AVLTree/AVLTree.h"
+
+/*
+ * Keys are 8 bytes, where the AVL height byte costs a whole padded word per node.
+ * With 4 byte keys or smaller both nodes pad out to the same 24 bytes.
+ */
+using Key = long;
+
+inline Key RandomNumber() {
+    return rand();
+}
+
+template <class Tree>
+inline void ConstructRandomTree(Tree &tree, size_t size) {
+    while (tree.size() < size)
+        tree.insert(RandomNumber());
+}
+
+template <class Tree, class Node>
+static void BM_Insert(benchmark::State &state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree;
+        state.ResumeTiming();
+        ConstructRandomTree(tree, state.range(0));
+        benchmark::DoNotOptimize(tree);
+        state.PauseTiming();
+        tree.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["node_bytes"] = sizeof(Node);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Insert, AVLTree<Key>, AVLTreeNode<Key>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Insert, ScapegoatTree<Key>, ScapegoatTreeNode<Key>)->TESTS;
+
+template <class Tree, class Node>
+static void BM_Contains(benchmark::State &state) {
+    Tree tree;
+    ConstructRandomTree(tree, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.contains(RandomNumber()));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["node_bytes"] = sizeof(Node);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Contains, AVLTree<Key>, AVLTreeNode<Key>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Contains, ScapegoatTree<Key>, ScapegoatTreeNode<Key>)->TESTS;
+
+// Replace the oldest value with a new one, so every remove finds its value
+template <class Tree, class Node>
+static void BM_Churn(benchmark::State &state) {
+    Tree tree;
+    std::vector<Key> values;
+    while (tree.size() < (size_t) state.range(0)) {
+        const Key value = RandomNumber();
+        if (tree.insert(value)) values.push_back(value);
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        tree.remove(values[next]);
+        do {
+            values[next] = RandomNumber();
+        } while (!tree.insert(values[next]));
+        next = (next + 1) % values.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["node_bytes"] = sizeof(Node);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Churn, AVLTree<Key>, AVLTreeNode<Key>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, ScapegoatTree<Key>, ScapegoatTreeNode<Key>)->TESTS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+/*
+ * Test cases for testing the sanity of the ScapegoatTree
+ */
+
+#include <cmath>
+#include <iostream>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "ScapegoatTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "ScapegoatTree Tests" << endl;
+    test_set<ScapegoatTree<int>>(compare);
+
+    // Nothing is deeper than log base 3/2 of the size, plus the root
+    bool passed = check_bounded_height<ScapegoatTree<int>>(
+        [](size_t size) { return size_t(log(size) / log(1.5)) + 1; }, compare);
+    cout << "Height Check               : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Removing most values rebuilds the whole tree, perfectly balanced
+        ScapegoatTree<int> tree(compare);
+        for (int i = 0; i < 10000; i++) tree.insert(i);
+        for (int i = 0; i < 9990; i++) tree.remove(i);
+        passed &= tree.size() == 10 && tree.getHeight() == 4;
+        tree.sanityCheck();
+    }
+    cout << "Rebuild Check              : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,389 @@
+#ifndef SHARDEDTREE_CPP
+#define SHARDEDTREE_CPP
+
+#include <new>
+#include "ShardedTree.h"
+
+template <class Tree>
+constexpr size_t ShardedTree<Tree>::min_shard_size;
+
+template <class Tree>
+typename ShardedTree<Tree>::Shard* ShardedTree<Tree>::createShard(int (*compare)(const T &a, const T &b)) {
+    return new (aligned_allocator<Shard>().allocate(1)) Shard(compare);
+}
+
+template <class Tree>
+void ShardedTree<Tree>::destroyShard(void *memory) noexcept {
+    Shard *shard = static_cast<Shard*>(memory);
+    shard->~Shard();
+    aligned_allocator<Shard>().deallocate(shard, 1);
+}
+
+template <class Tree>
+ShardedTree<Tree>::ShardedTree(int (*compare)(const T &a, const T &b), size_t target_shards):
+    compare(compare), target_shards(std::max<size_t>(1, target_shards)), layout(new Layout()) {
+    // Start with one shard for everything, and split it as values arrive
+    Layout *current = layout.load();
+    current->shards.push_back(createShard(compare));
+    current->split_size = min_shard_size;
+    current->merge_size = 0;
+}
+
+template <class Tree>
+ShardedTree<Tree>::ShardedTree(const ShardedTree &tree): ShardedTree(tree.compare, tree.target_shards) {
+    *this = tree;
+}
+
+template <class Tree>
+ShardedTree<Tree>& ShardedTree<Tree>::operator=(const ShardedTree &tree) {
+    if (this == &tree) return *this;
+
+    clear();
+    for (auto it = tree.inorder_begin(); it != tree.inorder_end(); ++it) {
+        insert(*it);
+    }
+    return *this;
+}
+
+template <class Tree>
+ShardedTree<Tree>::~ShardedTree() {
+    // Nothing else may be using the tree, so free directly. Merged and cleared shards are already retired.
+    Layout *current = layout.load();
+    for (Shard *shard : current->shards) destroyShard(shard);
+    delete current;
+}
+
+template <class Tree>
+bool ShardedTree<Tree>::holds(const Shard *shard, const T &value) const {
+    return (!shard->has_lower || compare(value, shard->lower) >= 0) &&
+           (!shard->has_upper || compare(value, shard->upper) < 0);
+}
+
+template <class Tree>
+typename ShardedTree<Tree>::Shard* ShardedTree<Tree>::lockShard(const T &value) const {
+    while (true) {
+        const Layout *current = layout.load(std::memory_order_acquire);
+
+        // The last shard whose lower bound is not above value. The first has none.
+        size_t low = 1, high = current->shards.size();
+        while (low < high) {
+            const size_t middle = (low + high) / 2;
+            if (compare(value, current->shards[middle]->lower) < 0) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+
+        Shard *shard = current->shards[low - 1];
+        shard->lock.lock();
+        // Split or merged since the layout was read, so look again in the new one
+        if (shard->alive && holds(shard, value)) return shard;
+        shard->lock.unlock();
+    }
+}
+
+template <class Tree>
+bool ShardedTree<Tree>::contains(const T &value) const {
+    /**
+     * Check if value is present in the tree.
+     */
+    EpochReclaimer::Guard guard;
+    Shard *shard = lockShard(value);
+    std::lock_guard<std::mutex> lock(shard->lock, std::adopt_lock);
+    return shard->tree.contains(value);
+}
+
+template <class Tree>
+bool ShardedTree<Tree>::insert(const T &value) {
+    EpochReclaimer::Guard guard;
+    Shard *shard = lockShard(value);
+    size_t size;
+    {
+        std::lock_guard<std::mutex> lock(shard->lock, std::adopt_lock);
+        if (!shard->tree.insert(value)) return false;
+        size = shard->tree.size();
+        shard->size.store(size, std::memory_order_relaxed);
+    }
+
+    if (size > layout.load(std::memory_order_acquire)->split_size) split(shard);
+    return true;
+}
+
+template <class Tree>
+bool ShardedTree<Tree>::remove(const T &value) {
+    EpochReclaimer::Guard guard;
+    Shard *shard = lockShard(value);
+    size_t size;
+    {
+        std::lock_guard<std::mutex> lock(shard->lock, std::adopt_lock);
+        if (!shard->tree.remove(value)) return false;
+        size = shard->tree.size();
+        shard->size.store(size, std::memory_order_relaxed);
+    }
+
+    if (size < layout.load(std::memory_order_acquire)->merge_size) merge(shard);
+    return true;
+}
+
+template <class Tree>
+void ShardedTree<Tree>::publish(Layout *next) {
+    /**
+     * Make next the layout, with fair shares from the current sizes.
+     * Must be called holding rebalancing, and the locks of any shard whose range changed.
+     */
+    size_t total = 0;
+    for (const Shard *shard : next->shards) total += shard->size.load(std::memory_order_relaxed);
+
+    const size_t fair_share = total / target_shards;
+    next->split_size = std::max(min_shard_size, 2 * fair_share);
+    next->merge_size = fair_share / 2;
+
+    // Threads may still be searching the old layout
+    Layout *previous = layout.exchange(next, std::memory_order_acq_rel);
+    EpochReclaimer::retire(previous);
+}
+
+template <class Tree>
+void ShardedTree<Tree>::split(Shard *shard) {
+    /**
+     * Move the upper half of shard into a new shard after it.
+     */
+    // Someone else is rebalancing, and shard is checked again on its next insert
+    std::unique_lock<std::mutex> rebalance_lock(rebalancing, std::try_to_lock);
+    if (!rebalance_lock.owns_lock()) return;
+
+    const Layout *current = layout.load(std::memory_order_acquire);
+    std::lock_guard<std::mutex> lock(shard->lock);
+    if (!shard->alive || shard->tree.size() <= current->split_size) return;
+
+    // Not yet in a layout, so no other thread can reach it
+    Shard *upper = createShard(compare);
+    const size_t keep = shard->tree.size() / 2;
+    while (shard->tree.size() > keep) {
+        upper->tree.insert(shard->tree.popMostRight());
+    }
+    upper->size.store(upper->tree.size(), std::memory_order_relaxed);
+    shard->size.store(shard->tree.size(), std::memory_order_relaxed);
+
+    upper->lower = upper->tree.getMostLeft();
+    upper->has_lower = true;
+    upper->upper = shard->upper;
+    upper->has_upper = shard->has_upper;
+    shard->upper = upper->lower;
+    shard->has_upper = true;
+
+    Layout *next = new Layout(*current);
+    next->shards.insert(std::find(next->shards.begin(), next->shards.end(), shard) + 1, upper);
+    publish(next);
+}
+
+template <class Tree>
+void ShardedTree<Tree>::merge(Shard *shard) {
+    /**
+     * Move every value of shard, or the neighbour it is merged with, into the shard before.
+     */
+    std::unique_lock<std::mutex> rebalance_lock(rebalancing, std::try_to_lock);
+    if (!rebalance_lock.owns_lock()) return;
+
+    const Layout *current = layout.load(std::memory_order_acquire);
+    const std::vector<Shard*> &shards = current->shards;
+    if (shards.size() == 1) return;
+
+    auto position = std::find(shards.begin(), shards.end(), shard);
+    // Already merged away
+    if (position == shards.end()) return;
+
+    // Merge with the smaller neighbour
+    if (position == shards.begin() ||
+        (position + 1 != shards.end() &&
+         (*(position + 1))->size.load(std::memory_order_relaxed) < (*(position - 1))->size.load(std::memory_order_relaxed)))
+        ++position;
+    Shard *left = *(position - 1);
+    Shard *right = *position;
+
+    // Always lock in order of range, so rebalancing cannot deadlock with itself
+    std::lock_guard<std::mutex> left_lock(left->lock);
+    std::lock_guard<std::mutex> right_lock(right->lock);
+    if (shard->tree.size() >= current->merge_size) return;
+    // Merging would only split again
+    if (left->tree.size() + right->tree.size() > current->split_size) return;
+
+    while (!right->tree.empty()) {
+        left->tree.insert(right->tree.popMostLeft());
+    }
+    left->size.store(left->tree.size(), std::memory_order_relaxed);
+    right->size.store(0, std::memory_order_relaxed);
+
+    left->upper = right->upper;
+    left->has_upper = right->has_upper;
+    right->alive = false;
+
+    Layout *next = new Layout(*current);
+    next->shards.erase(next->shards.begin() + (position - shards.begin()));
+    publish(next);
+
+    // Threads may be waiting on its lock, and will look again once they have it
+    EpochReclaimer::retire(right, &ShardedTree::destroyShard);
+}
+
+template <class Tree>
+typename ShardedTree<Tree>::T ShardedTree<Tree>::popMostLeft() {
+    EpochReclaimer::Guard guard;
+
+  retry:
+    const Layout *current = layout.load(std::memory_order_acquire);
+    for (Shard *shard : current->shards) {
+        std::unique_lock<std::mutex> lock(shard->lock);
+        if (!shard->alive) goto retry;
+        if (shard->tree.empty()) continue;
+
+        T value = shard->tree.popMostLeft();
+        const size_t size = shard->tree.size();
+        shard->size.store(size, std::memory_order_relaxed);
+        lock.unlock();
+
+        if (size < current->merge_size) merge(shard);
+        return value;
+    }
+    throw std::out_of_range("tree is empty");
+}
+
+template <class Tree>
+typename ShardedTree<Tree>::T ShardedTree<Tree>::popMostRight() {
+    EpochReclaimer::Guard guard;
+
+  retry:
+    const Layout *current = layout.load(std::memory_order_acquire);
+    for (auto it = current->shards.rbegin(); it != current->shards.rend(); ++it) {
+        Shard *shard = *it;
+        std::unique_lock<std::mutex> lock(shard->lock);
+        if (!shard->alive) goto retry;
+        if (shard->tree.empty()) continue;
+
+        T value = shard->tree.popMostRight();
+        const size_t size = shard->tree.size();
+        shard->size.store(size, std::memory_order_relaxed);
+        lock.unlock();
+
+        if (size < current->merge_size) merge(shard);
+        return value;
+    }
+    throw std::out_of_range("tree is empty");
+}
+
+template <class Tree>
+typename ShardedTree<Tree>::T ShardedTree<Tree>::getMostLeft() const {
+    EpochReclaimer::Guard guard;
+
+  retry:
+    const Layout *current = layout.load(std::memory_order_acquire);
+    for (Shard *shard : current->shards) {
+        std::lock_guard<std::mutex> lock(shard->lock);
+        if (!shard->alive) goto retry;
+        if (!shard->tree.empty()) return shard->tree.getMostLeft();
+    }
+    throw std::out_of_range("tree is empty");
+}
+
+template <class Tree>
+typename ShardedTree<Tree>::T ShardedTree<Tree>::getMostRight() const {
+    EpochReclaimer::Guard guard;
+
+  retry:
+    const Layout *current = layout.load(std::memory_order_acquire);
+    for (auto it = current->shards.rbegin(); it != current->shards.rend(); ++it) {
+        std::lock_guard<std::mutex> lock((*it)->lock);
+        if (!(*it)->alive) goto retry;
+        if (!(*it)->tree.empty()) return (*it)->tree.getMostRight();
+    }
+    throw std::out_of_range("tree is empty");
+}
+
+template <class Tree>
+void ShardedTree<Tree>::clear() {
+    /**
+     * Replace every shard by a single empty one, as a new tree starts with.
+     */
+    EpochReclaimer::Guard guard;
+    // Waits for any split or merge, and holds off others, so the layout read is the one replaced
+    std::lock_guard<std::mutex> rebalance_lock(rebalancing);
+    const Layout *current = layout.load(std::memory_order_acquire);
+
+    // Locked in order of range, as merge does, so operations on the old shards finish first
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(current->shards.size());
+    for (Shard *shard : current->shards) {
+        locks.emplace_back(shard->lock);
+        shard->alive = false;
+    }
+
+    Layout *next = new Layout();
+    next->shards.push_back(createShard(compare));
+    publish(next);
+
+    // Threads waiting on their locks will look again in the new layout. The guard keeps current until we are done.
+    locks.clear();
+    for (Shard *shard : current->shards) EpochReclaimer::retire(shard, &ShardedTree::destroyShard);
+}
+
+template <class Tree>
+bool ShardedTree<Tree>::empty() const {
+    return size() == 0;
+}
+
+template <class Tree>
+size_t ShardedTree<Tree>::size() const {
+    // Exact once quiescent
+    EpochReclaimer::Guard guard;
+    size_t total = 0;
+    for (const Shard *shard : layout.load(std::memory_order_acquire)->shards) {
+        total += shard->size.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+template <class Tree>
+size_t ShardedTree<Tree>::shardCount() const noexcept {
+    EpochReclaimer::Guard guard;
+    return layout.load(std::memory_order_acquire)->shards.size();
+}
+
+template <class Tree>
+void ShardedTree<Tree>::snapshot(const T *from, std::vector<T> &values, T &next, bool &has_next) const {
+    EpochReclaimer::Guard guard;
+    Shard *shard;
+    if (from != nullptr) {
+        shard = lockShard(*from);
+    } else {
+        // The first shard never merges away, it only absorbs the one after it, but clear() replaces it
+        while (true) {
+            shard = layout.load(std::memory_order_acquire)->shards.front();
+            shard->lock.lock();
+            if (shard->alive) break;
+            shard->lock.unlock();
+        }
+    }
+    std::lock_guard<std::mutex> lock(shard->lock, std::adopt_lock);
+
+    values.clear();
+    values.reserve(shard->tree.size());
+    for (auto it = shard->tree.inorder_begin(); it != shard->tree.inorder_end(); ++it) {
+        // A merge may have brought in values already passed
+        if (from == nullptr || compare(*it, *from) >= 0) values.push_back(*it);
+    }
+
+    has_next = shard->has_upper;
+    if (has_next) next = shard->upper;
+}
+
+template <class Tree>
+typename ShardedTree<Tree>::inorder_iterator ShardedTree<Tree>::inorder_begin() const {
+    return inorder_iterator(this);
+}
+
+template <class Tree>
+typename ShardedTree<Tree>::inorder_iterator ShardedTree<Tree>::inorder_end() const noexcept {
+    return inorder_iterator(nullptr);
+}
+#endif //SHARDEDTREE_CPP
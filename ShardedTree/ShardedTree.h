@@ -0,0 +1,240 @@
+/*
+ * An ordered set split by range over many inner trees, each behind its own lock
+ *
+ * Any tree with the BinaryTree interface works as the inner tree, e.g. ShardedTree<AVLTree<int>>.
+ * Each shard holds the values in a range, and threads working in different ranges never share a lock or a cache
+ * line, so writes scale with cores when keys are spread evenly. No new concurrent algorithm is needed.
+ *
+ * The shards are found through a layout, an array of the shards in order that is replaced whole whenever it changes.
+ * A shard that grows past twice its fair share of the values is split at its median, and one that shrinks
+ * below half its fair share is merged into a neighbour. Old layouts, and shards merged or cleared, are freed through
+ * util/epoch_reclaimer.h, and a thread that finds its shard no longer holds the value looks again.
+ *
+ * Because the shards hold disjoint ranges, merging them in order is just visiting them in turn. Iteration copies a
+ * shard at a time under its lock, so it is weakly consistent: it sees every value present throughout, none absent
+ * throughout, and never the same value twice.
+ */
+#ifndef SHARDEDTREE_H
+#define SHARDEDTREE_H
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include "../binaryTree.h"
+#include "../util/aligned_allocator.h"
+#include "../util/epoch_reclaimer.h"
+
+template <class Tree>
+class ShardedTree {
+  public:
+    // Public reference to T for reference
+    using value_type = typename Tree::value_type;
+    using T = value_type;
+
+    // Shards are not split smaller than this, as locking would cost more than it saves
+    static constexpr size_t min_shard_size = 64;
+
+  protected:
+    // On its own cache lines, so threads on neighbouring shards do not slow each other
+    struct alignas(64) Shard {
+        std::mutex lock;
+        Tree tree;
+
+        // Mirrors tree.size(), so it can be read without the lock
+        std::atomic<size_t> size;
+
+        /*
+         * The range of values held, lower inclusive and upper exclusive. The first shard has no lower bound,
+         * the last no upper bound. lower never changes once the shard is in a layout, upper only under the lock.
+         */
+        T lower;
+        T upper;
+        bool has_lower;
+        bool has_upper;
+
+        // False once merged into a neighbour, or cleared
+        bool alive;
+
+        explicit Shard(int (*compare)(const T &a, const T &b)):
+            tree(compare), size(0), lower(), upper(), has_lower(false), has_upper(false), alive(true) {}
+    };
+
+    struct Layout {
+        std::vector<Shard*> shards;
+
+        // Fair shares of the values when the layout was made
+        size_t split_size;
+        size_t merge_size;
+    };
+
+    int (*compare)(const T &a, const T &b);
+    size_t target_shards;
+
+    std::atomic<Layout*> layout;
+
+    // Held while splitting or merging, so only one layout change is made at a time
+    std::mutex rebalancing;
+
+    static Shard* createShard(int (*compare)(const T &a, const T &b));
+    static void destroyShard(void *shard) noexcept;
+
+    bool holds(const Shard *shard, const T &value) const;
+
+    // The shard whose range holds value, locked. The caller must hold an epoch guard.
+    Shard* lockShard(const T &value) const;
+
+    // Replace the layout with next, recomputing the fair shares
+    void publish(Layout *next);
+
+    void split(Shard *shard);
+    void merge(Shard *shard);
+
+    /**
+     * Copy the values of the shard holding from that are not less than it, or of the first shard if from is nullptr.
+     * Sets has_next and next to the lower bound of the shard after it, if any.
+     */
+    void snapshot(const T *from, std::vector<T> &values, T &next, bool &has_next) const;
+
+  public:
+    // target_shards is how many shards to aim for, by default four per core
+    explicit ShardedTree(int (*compare)(const T &a, const T &b) = default_compare,
+                         size_t target_shards = 4 * std::max(1u, std::thread::hardware_concurrency()));
+
+    // Neither the copy nor the destructor may run alongside other operations
+    ShardedTree(const ShardedTree &tree);
+    ShardedTree& operator=(const ShardedTree &tree);
+    ~ShardedTree();
+
+    bool contains(const T &value) const;
+    bool insert(const T &value);
+    bool remove(const T &value);
+
+    // Remove and return the least value, or greatest. Throws std::out_of_range if there is none.
+    T popMostLeft();
+    T popMostRight();
+    T getMostLeft() const;
+    T getMostRight() const;
+
+    // Removes every value, leaving a single shard, and is safe alongside other operations
+    void clear();
+    bool empty() const;
+    size_t size() const;
+
+    // Number of shards the values are spread over
+    size_t shardCount() const noexcept;
+
+    class inorder_iterator {
+        // Allow ShardedTree to use the protected constructor
+        friend class ShardedTree;
+      public:
+        // Iterator traits
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        inorder_iterator(const inorder_iterator &iter) = default;
+        inorder_iterator& operator=(const inorder_iterator &iter) = default;
+
+        // Prefix ++ overload
+        inorder_iterator& operator++() {
+            if (sharded_tree != nullptr && ++position == values.size()) load();
+            return *this;
+        }
+
+        // Postfix ++ overload
+        inorder_iterator operator++(int) {
+            inorder_iterator iter = *this;
+            ++*this;
+            return iter;
+        }
+
+        bool operator==(const inorder_iterator &iter) const {
+            if (sharded_tree == nullptr || iter.sharded_tree == nullptr) return sharded_tree == iter.sharded_tree;
+            return sharded_tree->compare(values[position], iter.values[iter.position]) == 0;
+        }
+
+        bool operator!=(const inorder_iterator &iter) const {
+            return !operator==(iter);
+        }
+
+        T operator*() const {
+            if (sharded_tree == nullptr)
+                throw std::out_of_range("iterator has been exhausted");
+            return values[position];
+        }
+
+      protected:
+        explicit inorder_iterator(const ShardedTree *sharded_tree): sharded_tree(sharded_tree), position(0), next(),
+                                                                    has_next(false) {
+            if (sharded_tree != nullptr) {
+                sharded_tree->snapshot(nullptr, values, next, has_next);
+                if (values.empty()) load();
+            }
+        }
+
+        // Copy the next shard with any values, or finish
+        void load() {
+            position = 0;
+            values.clear();
+            while (values.empty()) {
+                if (!has_next) {
+                    sharded_tree = nullptr;
+                    return;
+                }
+                const T from = next;
+                sharded_tree->snapshot(&from, values, next, has_next);
+            }
+        }
+
+        // nullptr once exhausted
+        const ShardedTree *sharded_tree;
+
+        // Copy of the current shard, from the current value on
+        std::vector<T> values;
+        size_t position;
+
+        // Where the next shard starts
+        T next;
+        bool has_next;
+    };
+
+    inorder_iterator inorder_begin() const;
+    inorder_iterator inorder_end() const noexcept;
+
+#ifdef BINARYTREE_SANITY_CHECK
+    // Only define sanity check if compile flag is specified.
+    // Throws errors if anything is wrong. The tree must be quiescent.
+    void sanityCheck() const {
+        const Layout *current = layout.load();
+        if (current->shards.empty()) throw std::logic_error("Layout has no shards");
+        if (current->shards.front()->has_lower) throw std::logic_error("First shard has a lower bound");
+        if (current->shards.back()->has_upper) throw std::logic_error("Last shard has an upper bound");
+
+        for (size_t i = 0; i < current->shards.size(); i++) {
+            const Shard *shard = current->shards[i];
+            shard->tree.sanityCheck();
+
+            if (!shard->alive) throw std::logic_error("Merged shard is still in the layout");
+            if (shard->size.load() != shard->tree.size()) throw std::logic_error("Shard size does not match its tree");
+            if (i + 1 < current->shards.size()) {
+                const Shard *next = current->shards[i + 1];
+                if (!shard->has_upper || !next->has_lower || compare(shard->upper, next->lower) != 0)
+                    throw std::logic_error("Shard ranges are not contiguous");
+            }
+            for (auto it = shard->tree.inorder_begin(); it != shard->tree.inorder_end(); ++it) {
+                if (!holds(shard, *it)) throw std::logic_error("Value is outside its shard's range");
+            }
+        }
+    }
+#endif
+};
+
+#include "ShardedTree.cpp"
+#endif //SHARDEDTREE_H
@@ -0,0 +1,28 @@
+/*
+ * Performance Benchmark for ShardedTree against AVLTree behind a mutex
+ * All threads share one tree, with keys spread evenly over the range.
+ *
+ * g++ ShardedTreeBenchmark.cpp ../AVLTree/AVLTree.cpp ../SplayTree/splayTree.cpp ../binaryTree.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o ShardedTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "ShardedTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../SplayTree/splayTree.h"
+#include "../util/tree_benchmark.h"
+
+BENCHMARK_TEMPLATE(BM_ReadMostly, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, ShardedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_ReadMostly, ShardedTree<SplayTree<int>>)->THREADED_TESTS;
+
+BENCHMARK_TEMPLATE(BM_Churn, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, ShardedTree<AVLTree<int>>)->THREADED_TESTS;
+BENCHMARK_TEMPLATE(BM_Churn, ShardedTree<SplayTree<int>>)->THREADED_TESTS;
+
+BENCHMARK_MAIN();
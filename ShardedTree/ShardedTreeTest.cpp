@@ -0,0 +1,157 @@
+/*
+ * Test cases for testing the sanity of the ShardedTree
+ */
+
+#include <set>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "ShardedTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../SplayTree/splayTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+template <class Tree>
+bool churnCheck() {
+    // Random churn against std::set, through enough splits and merges to move every boundary
+    ShardedTree<Tree> tree(default_compare, 8);
+    set<int> reference;
+    bool passed = true;
+    srand(0);
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 20000; i++) {
+            const int value = rand() % 10000;
+            passed &= tree.insert(value) == reference.insert(value).second;
+            if (i % 3 == 0) passed &= tree.contains(value / 2) == (reference.count(value / 2) != 0);
+            if (i % 1000 == 0) tree.sanityCheck();
+        }
+        passed &= tree.shardCount() > 1;
+
+        for (int i = 0; i < 20000; i++) {
+            const int value = rand() % 10000;
+            passed &= tree.remove(value) == (reference.erase(value) != 0);
+            if (i % 1000 == 0) tree.sanityCheck();
+        }
+        tree.sanityCheck();
+        passed &= tree.size() == reference.size();
+        passed &= equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end());
+    }
+
+    // Drain from both ends
+    while (!reference.empty()) {
+        passed &= tree.popMostLeft() == *reference.begin();
+        reference.erase(reference.begin());
+        if (reference.empty()) break;
+        passed &= tree.popMostRight() == *reference.rbegin();
+        reference.erase(prev(reference.end()));
+    }
+    passed &= tree.empty();
+    tree.sanityCheck();
+    return passed;
+}
+
+int main() {
+    cout << "ShardedTree Tests" << endl;
+    using Tree = ShardedTree<AVLTree<int>>;
+    const bool empty = check_empty<Tree>() && Tree().shardCount() == 1;
+    cout << "Empty Check                : " << (empty ? "passed" : "failed") << endl;
+    cout << "Insert Remove Check        : " << (check_insert_remove<Tree>() ? "passed" : "failed") << endl;
+    cout << "Ends Check                 : " << (check_ends<Tree>() ? "passed" : "failed") << endl;
+
+    bool passed = churnCheck<AVLTree<int>>() && churnCheck<SplayTree<int>>();
+    cout << "Churn Check                : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Clearing goes back to the single shard of a new tree
+        Tree tree(default_compare, 8);
+        for (int i = 0; i < 10000; i++) tree.insert(i);
+        passed &= tree.shardCount() > 1;
+        tree.clear();
+        passed &= tree.empty() && tree.shardCount() == 1 && tree.inorder_begin() == tree.inorder_end();
+        tree.sanityCheck();
+
+        for (int i = 0; i < 10000; i++) passed &= tree.insert(i);
+        passed &= tree.size() == 10000 && tree.shardCount() > 1;
+        tree.sanityCheck();
+
+        // Writers and readers alongside clears only ever see whole shards, before or after each clear
+        const int threads = 4;
+        vector<thread> workers;
+        atomic<bool> stop(false);
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&tree, &stop, t]() {
+                for (int i = 0; !stop; i++) {
+                    const int value = (i % 5000) * threads + t;
+                    tree.insert(value);
+                    tree.contains(value / 2);
+                    if (i % 3 == 0) tree.remove(value - threads);
+                }
+            });
+        }
+        for (int i = 0; i < 200; i++) {
+            this_thread::yield();
+            tree.clear();
+        }
+        stop = true;
+        for (thread &worker : workers) worker.join();
+        tree.sanityCheck();
+
+        tree.clear();
+        passed &= tree.empty() && tree.shardCount() == 1;
+        tree.sanityCheck();
+    }
+    cout << "Clear Check                : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        // Each thread churns its own values, so shards split and merge under the other threads
+        ShardedTree<AVLTree<int>> tree(default_compare, 8);
+        const int threads = 8, per_thread = 4000;
+        vector<thread> workers;
+        atomic<bool> failed(false);
+
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&tree, &failed, t]() {
+                for (int round = 0; round < 4; round++) {
+                    for (int i = 0; i < per_thread; i++) {
+                        if (!tree.insert(i * threads + t)) failed = true;
+                    }
+                    for (int i = 0; i < per_thread; i++) {
+                        if (!tree.contains(i * threads + t)) failed = true;
+                        if (i % 4 != 0 && !tree.remove(i * threads + t)) failed = true;
+                    }
+                    for (int i = 0; i < per_thread; i += 4) {
+                        if (!tree.remove(i * threads + t)) failed = true;
+                    }
+                }
+            });
+        }
+
+        // Iterate alongside, every value seen must be in order
+        bool ordered = true;
+        for (int i = 0; i < 20; i++) {
+            auto it = tree.inorder_begin();
+            if (it == tree.inorder_end()) continue;
+            int previous = *it;
+            for (++it; it != tree.inorder_end(); ++it) {
+                ordered &= previous < *it;
+                previous = *it;
+            }
+        }
+
+        for (thread &worker : workers) worker.join();
+        passed &= !failed && ordered && tree.empty();
+        tree.sanityCheck();
+    }
+    passed &= check_concurrent_pops<Tree>(compare, 8);
+    cout << "Concurrent Check           : " << (passed ? "passed" : "failed") << endl;
+}
@@ -0,0 +1,95 @@
+/**
+ * Policies deciding when SplayTree::contains() restructures the tree.
+ *
+ * Splaying on every read makes every lookup write to the top of the tree.
+ * For uniform traffic that is pure cost, so these policies trade some of the
+ * adaptivity of a splay tree for fewer writes.
+ *
+ * A policy has the following members:
+ *
+ *   static constexpr bool eager
+ *   If true, contains() splays during the search itself, and shouldSplay() is never called.
+ *
+ *   static constexpr bool semi
+ *   If true, a node that is splayed is only semi-splayed, roughly halving its depth
+ *   instead of bringing it to the root.
+ *
+ *   bool shouldSplay(size_t depth)
+ *   Called after a successful read only search, with the depth of the node found.
+ *   (The root has a depth of zero.) Return true to restructure the tree.
+ *
+ * Insertions and removals always splay, as both rely on the value being at the root.
+ */
+#ifndef SPLAYPOLICY_H
+#define SPLAYPOLICY_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Splay every node accessed. The classic splay tree.
+struct FullSplayPolicy {
+    static constexpr bool eager = true;
+    static constexpr bool semi = false;
+
+    bool shouldSplay(size_t) noexcept {return true;}
+};
+
+// Semi-splay every node accessed.
+// Each zig-zig step does a single rotation, so a node moves about half way up the tree.
+struct SemiSplayPolicy {
+    static constexpr bool eager = false;
+    static constexpr bool semi = true;
+
+    bool shouldSplay(size_t) noexcept {return true;}
+};
+
+// Only splay nodes found deeper than Depth.
+// Nodes near the top are left alone, so repeated hits on them are read only.
+template <size_t Depth>
+struct DepthThresholdSplayPolicy {
+    static constexpr bool eager = false;
+    static constexpr bool semi = false;
+
+    bool shouldSplay(size_t depth) noexcept {return depth > Depth;}
+};
+
+// Splay a node with a probability of Percent / 100.
+// Uses a xorshift generator, so no state is shared with other trees.
+template <unsigned Percent>
+struct ProbabilisticSplayPolicy {
+    static_assert(Percent <= 100, "Percent must be in the range [0, 100]");
+
+    static constexpr bool eager = false;
+    static constexpr bool semi = false;
+
+    bool shouldSplay(size_t) noexcept {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state % 100 < Percent;
+    }
+
+  private:
+    // Any nonzero seed works
+    uint32_t state = 2463534242;
+};
+
+// Splay only every K-th successful access.
+template <size_t K>
+struct PeriodicSplayPolicy {
+    static_assert(K > 0, "K must be at least one");
+
+    static constexpr bool eager = false;
+    static constexpr bool semi = false;
+
+    bool shouldSplay(size_t) noexcept {
+        if (++accesses < K) return false;
+
+        accesses = 0;
+        return true;
+    }
+
+  private:
+    size_t accesses = 0;
+};
+#endif //SPLAYPOLICY_H
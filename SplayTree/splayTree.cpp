@@ -2,50 +2,134 @@
 #define SPLAYTREE_CPP
 
 #include <cassert>
+#include <utility>
 #include "splayTree.h"
 
-template <class T, class Node>
-bool SplayTree<T, Node>::makeSplay(Node *&node, const T &value) {
-	/* Find a node in the tree, and perform a splay operation on
-	 * the tree while doing so.
-	 */
-	// If this node does not exist, return a nullptr
-	if (node == nullptr) return false;
-
-	// First, traverse to the node, then change it.
-	int cmp = compare(value, node->value);
-
-	if (cmp == 0) {
-        // If this is already the node, there is no need to do further
-        // changes
-	    return node;
-	} else if (cmp < 0) {
-	    // The key is less than the node
-	    // Traverse left.
-	    bool result = makeSplay(node->left, value);
-
-        // If value not found, return
-        if (!result) return false;
-
-        // Move left to node: a "zig"
-        rotateLeft(node);
-	} else {
-	    // Greater than, so input is greater than the node
-	    // Traverse right.
-	    bool result = makeSplay(node->right, value);
-
-        // If value not found, return
-        if (!result) return false;
-
-        // Move right to node: a "zag"
-        rotateRight(node);
-	}
-	return true;
+template <class T, class Node, class Policy>
+SplayTree<T, Node, Policy>::SplayTree(int (*compare)(const T& a, const T& b)): BinaryTree<T, Node>(compare) {
+    discardDeferred();
 }
 
+template <class T, class Node, class Policy>
+SplayTree<T, Node, Policy>::SplayTree(const SplayTree &tree): BinaryTree<T, Node>(tree), policy(tree.policy) {
+    // Recorded nodes belong to the other tree
+    discardDeferred();
+}
+
+template <class T, class Node, class Policy>
+SplayTree<T, Node, Policy> &SplayTree<T, Node, Policy>::operator=(const SplayTree &tree) {
+    // Every node is replaced, so nothing recorded survives
+    discardDeferred();
+    BinaryTree<T, Node>::operator=(tree);
+    policy = tree.policy;
+    return *this;
+}
 
-template <class T, class Node>
-void SplayTree<T, Node>::rotateLeft(Node *&node) {
+template <class T, class Node, class Policy>
+bool SplayTree<T, Node, Policy>::own(Node *&node) {
+    if (Shared::shared && node != nullptr && Shared::isShared(node)) forgetDeferred(node);
+    return BinaryTree<T, Node>::own(node);
+}
+
+template <class T, class Node, class Policy>
+template <class Direction>
+bool SplayTree<T, Node, Policy>::splayInternal(Node *&node, Direction direction) {
+    /*
+     * Top down splay, as described by Sleator and Tarjan.
+     *
+     * While walking down, nodes that are passed over are hung on one of two
+     * assembly trees. Nodes less than the target are hung on the left tree,
+     * nodes greater than the target on the right tree.
+     *
+     * Instead of a header node, the left and right trees are tracked with a pointer to
+     * the empty slot where the next node will be hung.
+     *   left_hook  -> right child of the largest node in the left tree
+     *   right_hook -> left child of the smallest node in the right tree
+     *
+     * Once the walk stops, the remaining children of the current node are hung in the
+     * two slots, and the left and right trees become the new children of the current node.
+     *
+     * Every node passed is changed, so each is made this tree's own before stepping onto it.
+     */
+    if (node == nullptr) return false;
+    own(node);
+
+    Node *left_tree = nullptr;
+    Node *right_tree = nullptr;
+    Node **left_hook = &left_tree;
+    Node **right_hook = &right_tree;
+
+    Node *current = node;
+    int cmp;
+
+    while (true) {
+        cmp = direction(current->value);
+
+        if (cmp < 0) {
+            // Target is to the left
+            if (current->left == nullptr) break;
+            own(current->left);
+
+            if (direction(current->left->value) < 0) {
+                // Two steps left: a "zig-zig"
+                // Bring the left up before linking
+                rotateLeft(current);
+                if (current->left == nullptr) break;
+                own(current->left);
+            }
+
+            // Link current into the right tree
+            *right_hook = current;
+            right_hook = &current->left;
+            current = current->left;
+        } else if (cmp > 0) {
+            // Target is to the right
+            if (current->right == nullptr) break;
+            own(current->right);
+
+            if (direction(current->right->value) > 0) {
+                // Two steps right: a "zag-zag"
+                // Bring the right up before linking
+                rotateRight(current);
+                if (current->right == nullptr) break;
+                own(current->right);
+            }
+
+            // Link current into the left tree
+            *left_hook = current;
+            left_hook = &current->right;
+            current = current->right;
+        } else {
+            // Found
+            break;
+        }
+    }
+
+    // Reassemble.
+    // Children of current fill the open slots of the assembly trees.
+    *left_hook = current->left;
+    *right_hook = current->right;
+
+    current->left = left_tree;
+    current->right = right_tree;
+    node = current;
+
+    return cmp == 0;
+}
+
+template <class T, class Node, class Policy>
+bool SplayTree<T, Node, Policy>::makeSplay(Node *&node, const T &value) {
+    /* Find a node in the tree, and perform a splay operation on
+     * the tree while doing so.
+     *
+     * If the value is not present, the last node on the search path is
+     * brought to the top instead.
+     */
+    return splayInternal(node, [this, &value](const T &other) {return compare(value, other);});
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::rotateLeft(Node *&node) {
     /*
      * Bring the left node up to the node.
      * A "zig"
@@ -76,8 +160,8 @@ void SplayTree<T, Node>::rotateLeft(Node *&node) {
     node = temp;
 }
 
-template <class T, class Node>
-void SplayTree<T, Node>::rotateRight(Node *&node) {
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::rotateRight(Node *&node) {
     /*
      * Bring the right node up to the node.
      * A "zag"
@@ -108,16 +192,14 @@ void SplayTree<T, Node>::rotateRight(Node *&node) {
     node = temp;
 }
 
-template <class T, class Node>
-bool SplayTree<T, Node>::insertInternal(Node *&node, const T &value) {
+template <class T, class Node, class Policy>
+bool SplayTree<T, Node, Policy>::insertInternal(Node *&node, const T &value) {
     /*
-     * Insert a book into the tree.
+     * Insert a value into the tree.
      *
-     * Traverse down and contains the insertion point.
-     * Do it in a loop, since we don't have a recursive function.
+     * Splay the value to the top. If it is not there, the new node
+     * becomes the root, splitting the old root's children between its left and right.
      */
-    bool exists;
-
     // If the node is null, just set it.
     if (node == nullptr) {
         // Simply insert
@@ -125,179 +207,456 @@ bool SplayTree<T, Node>::insertInternal(Node *&node, const T &value) {
         return true;
     }
 
-    Node *current = node;
+    if (makeSplay(node, value)) {
+        // Already exists
+        return false;
+    }
 
-    while (true) {
-        // Choose a direction.
-        int cmp = compare(value, current->value);
+    Node *temp = new Node(value);
+    if (compare(value, node->value) < 0) {
+        // The old root, and its right, are greater than value
+        temp->left = node->left;
+        temp->right = node;
+        node->left = nullptr;
+    } else {
+        // The old root, and its left, are less than value
+        temp->right = node->right;
+        temp->left = node;
+        node->right = nullptr;
+    }
+    node = temp;
 
-        if (cmp == 0) {
-            // This is the point
-            // But it exists already.
-            exists = true;
-            break;
-        } else if (cmp < 0) {
-            // Negative compare, the key less than the node.
-            // Go left.
-            if (current->left != nullptr) {
-                // Loop
-                current = current->left;
-            } else {
-                // This is nullptr, insert.
-                current->left = new Node(value);
-                exists = false;
-                break;
+    // New node created
+    return true;
+}
+
+template <class T, class Node, class Policy>
+bool SplayTree<T, Node, Policy>::contains(const T &value) noexcept {
+    /*
+     * Find key in the tree,
+     * Doing splay operation changes, as allowed by the policy.
+     */
+    if (Policy::eager) {
+        return makeSplay(root, value);
+    }
+
+    // Read only search, to find the depth before deciding to change anything.
+    if (Policy::semi) path.clear();
+
+    Node **slot = &root;
+    size_t depth = 0;
+    while (*slot != nullptr) {
+        if (Policy::semi) path.push_back(slot);
+
+        int cmp = compare(value, (*slot)->value);
+        if (cmp == 0) break;
+
+        slot = cmp < 0 ? &(*slot)->left : &(*slot)->right;
+        depth++;
+    }
+
+    // Not found. Nothing to adapt to.
+    if (*slot == nullptr) return false;
+
+    if (policy.shouldSplay(depth)) {
+        if (Policy::semi) {
+            if (Shared::shared) {
+                // Every node on the path is rotated. Copying one moves the slot below it into the copy.
+                for (size_t i = 0; i < path.size(); i++) {
+                    const bool left = i + 1 < path.size() && path[i + 1] == &(*path[i])->left;
+                    if (own(*path[i]) && i + 1 < path.size())
+                        path[i + 1] = left ? &(*path[i])->left : &(*path[i])->right;
+                }
             }
+            semiSplay(path);
         } else {
-            // Positive compare, traverse right.
-            if (current->right != nullptr) {
-                // Loop
-                current = current->right;
-            } else {
-                // This is nullptr, insert
-                current->right = new Node(value);
-                exists = false;
-                break;
-            }
+            makeSplay(root, value);
         }
     }
+    return true;
+}
 
-    // Now the node definitely exists now, do splay operations to bring it up.
-    contains(value);
+template <class T, class Node, class Policy>
+bool SplayTree<T, Node, Policy>::peek(const T &value) const noexcept {
+    // Plain binary search
+    const Node *node = root;
+    while (node != nullptr) {
+        int cmp = compare(value, node->value);
+        if (cmp == 0) return true;
 
-    // Return if a new node was just created
-    return !exists;
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return false;
 }
 
-template <class T, class Node>
-bool SplayTree<T, Node>::contains(const T &value) noexcept {
+template <class T, class Node, class Policy>
+bool SplayTree<T, Node, Policy>::containsDeferred(const T &value) const noexcept {
+    const Node *node = root;
+    size_t depth = 0;
+    while (node != nullptr) {
+        int cmp = compare(value, node->value);
+        if (cmp == 0) break;
+
+        node = cmp < 0 ? node->left : node->right;
+        depth++;
+    }
+
+    if (node == nullptr) return false;
+
+    if (depth > deferred_min_depth) {
+        // Readers only ever write these two atomics. Avoid dirtying the flag's cache line when already set.
+        deferred[deferredSlot(node)].store(node, std::memory_order_relaxed);
+        if (!deferred_pending.load(std::memory_order_relaxed))
+            deferred_pending.store(true, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::applyDeferred() noexcept {
     /*
-     * Find key in the tree,
-     * Doing splay operation changes.
+     * Splay every recorded node.
+     *
+     * The caller has exclusive access, so relaxed loads are enough.
+     * Whatever lock gave that access also orders the readers' stores before this.
      */
-    return makeSplay(root, value);
+    if (!deferred_pending.load(std::memory_order_relaxed)) return;
+    deferred_pending.store(false, std::memory_order_relaxed);
+
+    for (auto &slot : deferred) {
+        const Node *node = slot.exchange(nullptr, std::memory_order_relaxed);
+        if (node != nullptr) makeSplay(root, node->value);
+    }
 }
 
-template <class T, class Node>
-Node* SplayTree<T, Node>::popMostLeftInternal(Node *&node) {
-    Node *temp;
-    if (node->left != nullptr) {
-        temp = popMostLeftInternal(node->left);
+template <class T, class Node, class Policy>
+size_t SplayTree<T, Node, Policy>::deferredSlot(const Node *node) noexcept {
+    // Fibonacci hashing of the address. The low bits are mostly alignment.
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 32) % deferred_slots;
+}
 
-        // Bring left down to the root
-        if (node->left != nullptr)
-            rotateLeft(node);
-    } else {
-        // Return node, but remove from tree.
-        temp = node;
-        node = node->right;
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::forgetDeferred(const Node *node) noexcept {
+    // A node can only be in its own slot
+    auto &slot = deferred[deferredSlot(node)];
+    if (slot.load(std::memory_order_relaxed) == node)
+        slot.store(nullptr, std::memory_order_relaxed);
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::discardDeferred() noexcept {
+    for (auto &slot : deferred)
+        slot.store(nullptr, std::memory_order_relaxed);
+    deferred_pending.store(false, std::memory_order_relaxed);
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::clear() noexcept {
+    discardDeferred();
+    BinaryTree<T, Node>::clear();
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::semiSplay(const std::vector<Node**> &path) {
+    /*
+     * Bottom up semi-splay.
+     *
+     * Work up the path two levels at a time. With x the node, y its parent and z its grandparent:
+     *
+     * zig-zig: x and y are both left (or both right) children.
+     * Rotate y above z, and continue from y.
+     *
+     *        z            y
+     *       /           /   \
+     *      y     ->    x     z
+     *     /
+     *    x
+     *
+     * zig-zag: x is a right child of a left child (or the reverse).
+     * Rotate x above y, then above z, and continue from x.
+     *
+     *      z              x
+     *     /             /   \
+     *    y       ->    y     z
+     *     \
+     *      x
+     *
+     * Stops once the node is the root or a child of it.
+     */
+    assert(!path.empty());
+
+    size_t i = path.size() - 1;
+    while (i >= 2) {
+        Node ** const z_slot = path[i - 2];
+        Node ** const y_slot = path[i - 1];
+
+        Node * const z = *z_slot;
+        Node * const y = *y_slot;
+        Node * const x = *path[i];
+
+        const bool x_left = y->left == x;
+        const bool y_left = z->left == y;
+
+        if (x_left == y_left) {
+            // zig-zig
+            if (y_left) rotateLeft(*z_slot);
+            else        rotateRight(*z_slot);
+        } else {
+            // zig-zag
+            if (x_left) rotateLeft(*y_slot);
+            else        rotateRight(*y_slot);
+
+            if (y_left) rotateLeft(*z_slot);
+            else        rotateRight(*z_slot);
+        }
+        i -= 2;
     }
+}
+
+template <class T, class Node, class Policy>
+Node* SplayTree<T, Node, Policy>::popMostLeftInternal(Node *&node) {
+    // Splay the smallest value to the top. It has no left, so its right takes its place.
+    splayInternal(node, [](const T &) {return -1;});
+
+    Node *temp = node;
+    forgetDeferred(temp);
+    node = node->right;
     return temp;
 }
 
-template <class T, class Node>
-Node* SplayTree<T, Node>::popMostRightInternal(Node *&node) {
-    Node *temp;
-    if (node->right != nullptr) {
-        temp = popMostRightInternal(node->right);
+template <class T, class Node, class Policy>
+Node* SplayTree<T, Node, Policy>::popMostRightInternal(Node *&node) {
+    // Splay the largest value to the top. It has no right, so its left takes its place.
+    splayInternal(node, [](const T &) {return 1;});
+
+    Node *temp = node;
+    forgetDeferred(temp);
+    node = node->left;
+    return temp;
+}
 
-        // Bring left down to the root
-        if (node->right != nullptr)
-            rotateRight(node);
+template <class T, class Node, class Policy>
+bool SplayTree<T, Node, Policy>::removeInternal(Node *&node, const T &value) {
+    // The value to remove needs to be brought to the top
+    if (!makeSplay(node, value)) {
+        // Value is not in tree
+        return false;
+    }
+
+    Node *temp = node;
+    forgetDeferred(temp);
+
+    if (node->left == nullptr) {
+        // Nothing less than value, the right is the remaining tree.
+        node = node->right;
     } else {
-        // Return node, but remove from tree.
-        temp = node;
+        // Splay the largest value of the left to its top.
+        // That value has no right, so the right of the removed node can be hung there.
+        Node *right = node->right;
         node = node->left;
+        splayInternal(node, [](const T &) {return 1;});
+
+        assert(node->right == nullptr);
+        node->right = right;
     }
-    return temp;
+
+    this->destroyNode(temp);
+    return true;
 }
 
-template <class T, class Node>
-bool SplayTree<T, Node>::remove(const T &value) noexcept {
-    // The value to remove needs to be brought to the root
-    bool result = makeSplay(root, value);
+template <class T, class Node, class Policy>
+Node* SplayTree<T, Node, Policy>::splitInternal(Node *&node, const T &key) {
+    /*
+     * Splay the key to the top. If it is missing, either its predecessor or successor comes up instead.
+     * Either way, one child of the new top is on the other side of the key, and is cut off.
+     */
+    if (node == nullptr) return nullptr;
 
-    if (!result) {
-        // Value is not in tree
-        return false;
+    Node *greater;
+    if (makeSplay(node, key) || compare(key, node->value) < 0) {
+        // Top is not less than key, it goes with its right
+        greater = node;
+        node = node->left;
+        greater->left = nullptr;
+    } else {
+        // Top is less than key, only its right goes
+        greater = node->right;
+        node->right = nullptr;
+    }
+    return greater;
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::joinInternal(Node *&node, Node *greater) {
+    if (node == nullptr) {
+        node = greater;
+        return;
     }
 
-    result = removeInternal(root, value);
-    count -= result;
-    return result;
+    // The largest value has no right, so greater can be hung there
+    splayInternal(node, [](const T &) {return 1;});
+    assert(node->right == nullptr);
+    node->right = greater;
 }
 
-// TODO make sure this is a *valid* remove operation that is O(log(n))
-template <class T, class Node>
-bool SplayTree<T, Node>::removeInternal(Node *&node, const T &value) {
-    // If the stack has a nullptr on top, then failed to find node.
-    if (node == nullptr) return false;
+template <class T, class Node, class Policy>
+size_t SplayTree<T, Node, Policy>::countNodes(const Node *node) {
+    std::vector<const Node*> stack;
+    size_t nodes = 0;
 
-    // Choose which way to keep searching.
-    auto cmp = compare(value, node->value);
-
-    if (cmp == 0) {
-        // This is the value that needs to be removed
-
-        // Replace this node with the most left value of its right branch.
-        // If no right branch, replace with its left (because AVL, if not right the left most be a leaf).
-        // If neither, just delete this one.
-        if (node->right != nullptr) {
-            Node *temp = popMostLeftInternal(node->right);
-
-            // Left should be known nullptr
-            assert(temp->left == nullptr);
-
-            // Note that this is done particularly to
-            // not call assignment on the type.
-            // it is assumed that is more expensive than
-            // moving an extra two pointers (in testing this seems to hold even for primitives)
-
-            // Move temp into the top of value
-            temp->left = node->left;
-            temp->right = node->right;
-
-            // Remove the value node
-            delete node;
-            node = temp;
-        } else if (node->left != nullptr) {
-            // Since right doesn't exist, temp must only be a leaf
-            // TODO fix this
-            assert(node->right == nullptr);
-            Node *temp = node->left;
-
-            delete node;
-            node = temp;
-        } else {
-            // Neither left nor right, just delete the node with value.
-            delete node;
-            node = nullptr;
-        }
-        return true;
+    if (node != nullptr) stack.push_back(node);
+    while (!stack.empty()) {
+        node = stack.back();
+        stack.pop_back();
+        nodes++;
+
+        if (node->left != nullptr)  stack.push_back(node->left);
+        if (node->right != nullptr) stack.push_back(node->right);
     }
+    return nodes;
+}
 
-    // Otherwise handle recursion
-    // If negative, go left.
-    // If positive, go right.
-    bool success;
-    if (cmp < 0) {
+template <class T, class Node, class Policy>
+size_t SplayTree<T, Node, Policy>::deleteNodes(Node *node) {
+    /*
+     * Rotate left children up until the top has no left, then delete it and move to its right.
+     * Each node is visited once, so counting costs nothing extra.
+     */
+    size_t nodes = 0;
+    while (node != nullptr) {
         if (node->left != nullptr) {
-            success = removeInternal(node->left, value);
-            // Move left to root
-            rotateLeft(node->left);
+            Node *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
         } else {
-            success = false;
+            Node *right = node->right;
+            BinaryTree<T, Node>::destroyNode(node);
+            node = right;
+            nodes++;
         }
-    } else {
-        if (node->right != nullptr) {
-            success = removeInternal(node->right, value);
-            // Move right to root
-            rotateRight(node->right);
-        } else {
-            success = false;
+    }
+    return nodes;
+}
+
+template <class T, class Node, class Policy>
+size_t SplayTree<T, Node, Policy>::countSplit(const Node *a, const Node *b, size_t total) {
+    /*
+     * Walk both subtrees one node at a time.
+     * Whichever runs out first has been fully counted, and the other is the remainder of total.
+     */
+    std::vector<const Node*> stack_a, stack_b;
+    size_t count_a = 0, count_b = 0;
+
+    if (a != nullptr) stack_a.push_back(a);
+    if (b != nullptr) stack_b.push_back(b);
+
+    while (!stack_a.empty() && !stack_b.empty()) {
+        a = stack_a.back();
+        stack_a.pop_back();
+        count_a++;
+        if (a->left != nullptr)  stack_a.push_back(a->left);
+        if (a->right != nullptr) stack_a.push_back(a->right);
+
+        b = stack_b.back();
+        stack_b.pop_back();
+        count_b++;
+        if (b->left != nullptr)  stack_b.push_back(b->left);
+        if (b->right != nullptr) stack_b.push_back(b->right);
+    }
+
+    if (stack_a.empty()) return count_a;
+    return total - count_b;
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::split(const T &key, SplayTree &greater) {
+    if (&greater == this) return;
+
+    greater.clear();
+
+    // Recorded nodes may be about to move to the other tree
+    discardDeferred();
+
+    greater.root = splitInternal(root, key);
+
+    const size_t total = count;
+    count = countSplit(root, greater.root, total);
+    greater.count = total - count;
+}
+
+template <class T, class Node, class Policy>
+void SplayTree<T, Node, Policy>::join(SplayTree &other) {
+    if (&other == this || other.root == nullptr) return;
+
+    if (root != nullptr) {
+        // Bring the extremes of both trees to their tops, to see which way round they go
+        splayInternal(root, [](const T &) {return 1;});
+        splayInternal(other.root, [](const T &) {return -1;});
+
+        if (compare(root->value, other.root->value) >= 0) {
+            // Maybe other is entirely less than this
+            splayInternal(root, [](const T &) {return -1;});
+            splayInternal(other.root, [](const T &) {return 1;});
+
+            if (compare(other.root->value, root->value) >= 0)
+                throw std::invalid_argument("trees overlap");
+
+            std::swap(root, other.root);
         }
     }
 
-    return success;
+    // This is now entirely less than other
+    joinInternal(root, other.root);
+    count += other.count;
+
+    other.discardDeferred();
+    other.root = nullptr;
+    other.count = 0;
+}
+
+template <class T, class Node, class Policy>
+size_t SplayTree<T, Node, Policy>::eraseRange(const T &lo, const T &hi) {
+    if (compare(lo, hi) >= 0) return 0;
+
+    discardDeferred();
+
+    // Cut the tree into [.., lo), [lo, hi) and [hi, ..)
+    Node *middle = splitInternal(root, lo);
+    Node *greater = splitInternal(middle, hi);
+
+    size_t erased;
+    if (Shared::shared) {
+        // Other trees may hold some of the nodes, so only let go of them
+        erased = countNodes(middle);
+        this->clearInternal(middle);
+    } else {
+        erased = deleteNodes(middle);
+    }
+
+    joinInternal(root, greater);
+    count -= erased;
+    return erased;
+}
+
+template <class T, class Node, class Policy>
+size_t SplayTree<T, Node, Policy>::extractRange(const T &lo, const T &hi, SplayTree &out) {
+    if (&out == this) return 0;
+
+    out.clear();
+    if (compare(lo, hi) >= 0) return 0;
+
+    discardDeferred();
+
+    // Cut the tree into [.., lo), [lo, hi) and [hi, ..)
+    out.root = splitInternal(root, lo);
+    Node *greater = splitInternal(out.root, hi);
+
+    out.count = countNodes(out.root);
+
+    joinInternal(root, greater);
+    count -= out.count;
+    return out.count;
 }
 #endif //SPLAYTREE_CPP
@@ -1,10 +1,23 @@
 /**
  * A splay tree implementation of a binary tree.
+ *
+ * How eagerly lookups restructure the tree is chosen with a splay policy.
+ * See splayPolicy.h.
+ *
+ * contains() may restructure the tree, so it cannot be shared between readers.
+ * peek() and containsDeferred() are const, and safe to call from many threads at once,
+ * as long as no thread modifies the tree at the same time (e.g. under a reader-writer lock).
+ * containsDeferred() remembers deep hits, which a writer later splays with applyDeferred().
  */
 #ifndef SPLAYTREE_H
 #define SPLAYTREE_H
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
 #include "../binaryTree.h"
+#include "splayPolicy.h"
 
 template <class T>
 struct SplayTreeNode {
@@ -19,31 +32,154 @@ struct SplayTreeNode {
     T value;
 };
 
-template <class T, class Node = SplayTreeNode<T>>
+// Node for a copy-on-write SplayTree, SplayTree<T, SharedSplayTreeNode<T>>, whose copies share nodes.
+// Splaying changes the tree, so contains() copies whatever shared nodes it splays, peek() never does.
+// See util/shared_node.h
+template <class T>
+struct SharedSplayTreeNode: public SharedNode {
+    // Public reference to T for reference
+    using value_type = T;
+
+    explicit SharedSplayTreeNode(const T &value): left(nullptr), right(nullptr), value(value) {}
+
+    SharedSplayTreeNode *left;
+    SharedSplayTreeNode *right;
+
+    T value;
+};
+
+template <class T, class Node = SplayTreeNode<T>, class Policy = FullSplayPolicy>
 class SplayTree: virtual public BinaryTree<T, Node> {
   public:
     using value_type = T;
 
+    // Number of distinct nodes containsDeferred() can remember between calls to applyDeferred()
+    static constexpr size_t deferred_slots = 64;
+
+    // containsDeferred() does not record hits this close to the root
+    static constexpr size_t deferred_min_depth = 4;
+
   protected:
     using BinaryTree<T, Node>::root;
     using BinaryTree<T, Node>::compare;
     using BinaryTree<T, Node>::count;
+    using typename BinaryTree<T, Node>::Shared;
+
+    // BinaryTree::own(), also forgetting a deferred splay of a node this tree lets go of
+    bool own(Node *&node);
 
     bool insertInternal(Node *&node, const T &value);
 
+    /**
+     * Top down splay of the subtree at node.
+     *
+     * The direction function is called with the value of each node on the search path.
+     * It returns a negative number to continue left, a positive number to continue right, and zero when
+     * the node being searched for is found.
+     *
+     * The last node visited is brought to the top of the subtree in a single pass down the tree,
+     * using O(1) extra space.
+     *
+     * @return true if the direction function returned zero for some node.
+     */
+    template <class Direction>
+    bool splayInternal(Node *&node, Direction direction);
+
     bool makeSplay(Node *&node, const T &value);
     void rotateLeft(Node *&node);
     void rotateRight(Node *&node);
 
+    /**
+     * Semi-splay the node at the end of path towards the root.
+     *
+     * path holds the slots leading from the root (path[0] == &root) to the node.
+     */
+    void semiSplay(const std::vector<Node**> &path);
+
+    // Decides when contains() splays
+    Policy policy;
+
+    // Reused search path for semi-splaying
+    std::vector<Node**> path;
+
+    /*
+     * Deferred splays.
+     *
+     * Each node found by containsDeferred() hashes to one slot, and overwrites whatever was there.
+     * Losing an access to a collision is fine, hot nodes keep coming back.
+     * Nodes are never dereferenced until applyDeferred(), so removing a node only has to clear its slot.
+     */
+    mutable std::array<std::atomic<const Node*>, deferred_slots> deferred;
+    // Set when any slot may be filled, so applyDeferred() is cheap when there is nothing to do
+    mutable std::atomic<bool> deferred_pending;
+
+    static size_t deferredSlot(const Node *node) noexcept;
+    void forgetDeferred(const Node *node) noexcept;
+    void discardDeferred() noexcept;
+
     bool removeInternal(Node *&node, const T &value);
     Node* popMostLeftInternal(Node *&node);
     Node* popMostRightInternal(Node *&node);
 
+    // Cut node so it keeps the values less than key. Returns the subtree of the values not less than key.
+    Node* splitInternal(Node *&node, const T &key);
+    // Hang greater on node. Every value in greater must be greater than every value in node.
+    void joinInternal(Node *&node, Node *greater);
+
+    // Count the nodes in a subtree, without recursion
+    static size_t countNodes(const Node *node);
+    // Delete the nodes in a subtree, without recursion. Returns the number deleted.
+    static size_t deleteNodes(Node *node);
+    // Count the nodes in a, given both a and b hold total nodes. Time is proportional to the smaller of the two.
+    static size_t countSplit(const Node *a, const Node *b, size_t total);
+
   public:
-    explicit SplayTree(int (*compare)(const T& a, const T& b) = default_compare) : BinaryTree<T, Node>(compare) {}
+    explicit SplayTree(int (*compare)(const T& a, const T& b) = default_compare);
+
+    // Copy constructor
+    SplayTree(const SplayTree &tree);
+
+    // Assignment constructor
+    SplayTree& operator=(const SplayTree &tree);
 
     bool contains(const T &value) noexcept override;
-    bool remove(const T &value) noexcept override;
+
+    // Search without changing the tree
+    bool peek(const T &value) const noexcept;
+
+    // Search without changing the tree, remembering deep hits to be splayed by applyDeferred()
+    bool containsDeferred(const T &value) const noexcept;
+
+    // Splay the nodes remembered by containsDeferred(). Must not run alongside any reader.
+    void applyDeferred() noexcept;
+
+    void clear() noexcept override;
+
+    /**
+     * Move every value not less than key into greater.
+     * Anything already in greater is cleared.
+     */
+    void split(const T &key, SplayTree &greater);
+
+    /**
+     * Move every value of other into this tree, leaving other empty.
+     * All values of one tree must be less than all values of the other.
+     * Throws std::invalid_argument if the trees overlap.
+     */
+    void join(SplayTree &other);
+
+    /**
+     * Remove every value in the range [lo, hi).
+     * @return The number of values removed.
+     */
+    size_t eraseRange(const T &lo, const T &hi);
+
+    /**
+     * Move every value in the range [lo, hi) into out.
+     * Anything already in out is cleared.
+     * @return The number of values moved.
+     */
+    size_t extractRange(const T &lo, const T &hi, SplayTree &out);
 };
 #include "splayTree.cpp"
 #endif //SPLAYTREE_H
@@ -83,6 +83,91 @@ static void BM_SplayTreeContains(benchmark::State &state) {
 }
 BENCHMARK(BM_SplayTreeContains)->TESTS;
 
+// Lookups of values in the tree, so the splay policy is exercised on every access
+template <class Policy>
+static void BM_SplayTreePolicyContains(benchmark::State &state) {
+    SplayTree<int, SplayTreeNode<int>, Policy> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        std::vector<int> values(tree.inorder_begin(), tree.inorder_end());
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.contains(values[RandomNumber() % values.size()]);
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SplayTreePolicyContains, FullSplayPolicy)->TESTS;
+BENCHMARK_TEMPLATE(BM_SplayTreePolicyContains, SemiSplayPolicy)->TESTS;
+BENCHMARK_TEMPLATE(BM_SplayTreePolicyContains, DepthThresholdSplayPolicy<8>)->TESTS;
+BENCHMARK_TEMPLATE(BM_SplayTreePolicyContains, ProbabilisticSplayPolicy<10>)->TESTS;
+BENCHMARK_TEMPLATE(BM_SplayTreePolicyContains, PeriodicSplayPolicy<16>)->TESTS;
+
+static void BM_SplayTreePeek(benchmark::State &state) {
+    SplayTree<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        std::vector<int> values(tree.inorder_begin(), tree.inorder_end());
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            benchmark::DoNotOptimize(tree.peek(values[RandomNumber() % values.size()]));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SplayTreePeek)->TESTS;
+
+// Read only lookups, with the recorded splays applied once per batch
+static void BM_SplayTreeContainsDeferred(benchmark::State &state) {
+    SplayTree<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        std::vector<int> values(tree.inorder_begin(), tree.inorder_end());
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            benchmark::DoNotOptimize(tree.containsDeferred(values[RandomNumber() % values.size()]));
+        tree.applyDeferred();
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SplayTreeContainsDeferred)->TESTS;
+
+// Drop a range of range(1) values, one remove at a time
+static void BM_SplayTreeRemoveRange(benchmark::State &state) {
+    SplayTree<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        std::vector<int> values(tree.inorder_begin(), tree.inorder_end());
+        const size_t first = RandomNumber() % (values.size() - state.range(1));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.remove(values[first + j]);
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SplayTreeRemoveRange)->TESTS;
+
+// Drop the same range with a single eraseRange
+static void BM_SplayTreeEraseRange(benchmark::State &state) {
+    SplayTree<int> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        std::vector<int> values(tree.inorder_begin(), tree.inorder_end());
+        const size_t first = RandomNumber() % (values.size() - state.range(1));
+        state.ResumeTiming();
+        tree.eraseRange(values[first], values[first + state.range(1)]);
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SplayTreeEraseRange)->TESTS;
+
 static void BM_SplayTreeCountableInsert(benchmark::State &state) {
     SplayTreeCountable<int> tree;
     for (auto _ : state) {
@@ -5,46 +5,83 @@
 #define SPLAYTREECOUNTABLE_CPP
 #include "splayTreeCountable.h"
 
-template <class T, class Node>
-SplayTreeCountable<T, Node>::SplayTreeCountable(int (*compare)(const T& a, const T& b)): BinaryTree<T, Node>(compare), BinaryTreeCountable<T, Node>(compare), SplayTree<T, Node>(compare) {}
+template <class T, class Node, class Policy>
+SplayTreeCountable<T, Node, Policy>::SplayTreeCountable(int (*compare)(const T& a, const T& b)): BinaryTree<T, Node>(compare), BinaryTreeCountable<T, Node>(compare), SplayTree<T, Node, Policy>(compare) {}
 
 // Copy constructor
-template <class T, class Node>
-SplayTreeCountable<T, Node>::SplayTreeCountable(const SplayTreeCountable<T, Node>& tree): BinaryTree<T, Node>(tree), BinaryTreeCountable<T, Node>(tree), SplayTree<T, Node>(tree) {}
+template <class T, class Node, class Policy>
+SplayTreeCountable<T, Node, Policy>::SplayTreeCountable(const SplayTreeCountable<T, Node, Policy>& tree): BinaryTree<T, Node>(tree), BinaryTreeCountable<T, Node>(tree), SplayTree<T, Node, Policy>(tree) {}
 
 // Assignment constructor
-template <class T, class Node>
-SplayTreeCountable<T, Node>& SplayTreeCountable<T, Node>::operator=(const SplayTreeCountable<T, Node> &tree) {
-    SplayTree<T, Node>::operator=(tree);
+template <class T, class Node, class Policy>
+SplayTreeCountable<T, Node, Policy>& SplayTreeCountable<T, Node, Policy>::operator=(const SplayTreeCountable<T, Node, Policy> &tree) {
+    SplayTree<T, Node, Policy>::operator=(tree);
     _count = tree._count;
     return *this;
 }
 
-template <class T, class Node>
-bool SplayTreeCountable<T, Node>::insert(const T &value) noexcept {
-    bool result = SplayTree<T, Node>::insert(value);
+template <class T, class Node, class Policy>
+bool SplayTreeCountable<T, Node, Policy>::insert(const T &value) noexcept {
+    bool result = SplayTree<T, Node, Policy>::insert(value);
     _count += result;
     return result;
 }
 
-template <class T, class Node>
-bool SplayTreeCountable<T, Node>::remove(const T &value) noexcept {
-    bool result = SplayTree<T, Node>::remove(value);
+template <class T, class Node, class Policy>
+bool SplayTreeCountable<T, Node, Policy>::remove(const T &value) noexcept {
+    bool result = SplayTree<T, Node, Policy>::remove(value);
     _count -= result;
     return result;
 }
 
-template <class T, class Node>
-T SplayTreeCountable<T, Node>::popMostLeft() {
-    const T &result = SplayTree<T, Node>::popMostLeft();
+template <class T, class Node, class Policy>
+void SplayTreeCountable<T, Node, Policy>::clear() noexcept {
+    SplayTree<T, Node, Policy>::clear();
+    _count = 0;
+}
+
+template <class T, class Node, class Policy>
+T SplayTreeCountable<T, Node, Policy>::popMostLeft() {
+    const T &result = SplayTree<T, Node, Policy>::popMostLeft();
     _count--;
     return result;
 }
 
-template <class T, class Node>
-T SplayTreeCountable<T, Node>::popMostRight() {
-    const T &result = SplayTree<T, Node>::popMostRight();
+template <class T, class Node, class Policy>
+T SplayTreeCountable<T, Node, Policy>::popMostRight() {
+    const T &result = SplayTree<T, Node, Policy>::popMostRight();
     _count--;
     return result;
 }
+
+// The range operations already count what they move, so just take the results
+
+template <class T, class Node, class Policy>
+void SplayTreeCountable<T, Node, Policy>::split(const T &key, SplayTreeCountable &greater) {
+    SplayTree<T, Node, Policy>::split(key, greater);
+    _count = this->count;
+    greater._count = greater.count;
+}
+
+template <class T, class Node, class Policy>
+void SplayTreeCountable<T, Node, Policy>::join(SplayTreeCountable &other) {
+    SplayTree<T, Node, Policy>::join(other);
+    _count = this->count;
+    other._count = other.count;
+}
+
+template <class T, class Node, class Policy>
+size_t SplayTreeCountable<T, Node, Policy>::eraseRange(const T &lo, const T &hi) {
+    size_t result = SplayTree<T, Node, Policy>::eraseRange(lo, hi);
+    _count -= result;
+    return result;
+}
+
+template <class T, class Node, class Policy>
+size_t SplayTreeCountable<T, Node, Policy>::extractRange(const T &lo, const T &hi, SplayTreeCountable &out) {
+    size_t result = SplayTree<T, Node, Policy>::extractRange(lo, hi, out);
+    _count -= result;
+    out._count = result;
+    return result;
+}
 #endif //SPLAYTREECOUNTABLE_CPP
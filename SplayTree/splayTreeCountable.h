@@ -9,8 +9,8 @@
 
 // A specialized SplayTree that tracks the size of elements in the tree.
 // This uses another integer, but makes an O(1) size() function
-template <class T, class Node = SplayTreeNode<T>>
-class SplayTreeCountable: public SplayTree<T, Node>, public BinaryTreeCountable<T, Node> {
+template <class T, class Node = SplayTreeNode<T>, class Policy = FullSplayPolicy>
+class SplayTreeCountable: public SplayTree<T, Node, Policy>, public BinaryTreeCountable<T, Node> {
   public:
     using value_type = T;
 
@@ -27,9 +27,15 @@ class SplayTreeCountable: public SplayTree<T, Node>, public BinaryTreeCountable<
 
     bool insert(const T &value) noexcept override;
     bool remove(const T &value) noexcept override;
+    void clear() noexcept override;
 
     T popMostLeft() override;
     T popMostRight() override;
+
+    void split(const T &key, SplayTreeCountable &greater);
+    void join(SplayTreeCountable &other);
+    size_t eraseRange(const T &lo, const T &hi);
+    size_t extractRange(const T &lo, const T &hi, SplayTreeCountable &out);
 };
 #include "splayTreeCountable.cpp"
 #endif //SPLAYTREECOUNTABLE_H
@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include "splayTree.h"
+#include "splayTreeCountable.h"
 
 using namespace std;
 
@@ -15,6 +16,27 @@ int compare(const int &a, const int &b) {
     else        return  1;
 }
 
+template <class Tree>
+bool test_policy() {
+    // Build a path, with the smallest value at the bottom
+    Tree tree(compare);
+    for (int i = 0; i < 1000; i++) {
+        tree.insert(i);
+    }
+
+    // Every policy must still find every value
+    bool passed = true;
+    for (int i = 0; i < 1000; i++) {
+        passed &= tree.contains(i);
+    }
+    passed &= !tree.contains(-1);
+    passed &= !tree.contains(1000);
+    passed &= tree.size() == 1000;
+    tree.sanityCheck();
+
+    return passed;
+}
+
 int main() {
     cout << "Build Tree" << endl;
 
@@ -108,6 +130,176 @@ int main() {
 
     tree.clear();
 
+    // Sorted input builds a path, the worst case for a recursive splay.
+    // Make sure searching from the bottom of it does not run out of stack.
+    const int sorted_size = 100000;
+    for (int i = 0; i < sorted_size; i++) {
+        tree.insert(i);
+    }
+
+    bool passed = tree.size() == (size_t) sorted_size;
+    passed &= tree.contains(0);
+    passed &= tree.getRoot() == 0;
+    passed &= !tree.contains(-1);
+    passed &= tree.remove(sorted_size - 1);
+    passed &= !tree.remove(sorted_size - 1);
+    passed &= tree.popMostLeft() == 0;
+    passed &= tree.popMostRight() == sorted_size - 2;
+    passed &= tree.size() == (size_t) sorted_size - 3;
+
+    int expected = 1;
+    for (auto it = tree.inorder_begin(); it != tree.inorder_end(); ++it) {
+        passed &= *it == expected++;
+    }
+    tree.sanityCheck();
+
+    cout << "Sorted Input Check: " << (passed ? "passed" : "failed") << endl;
+
+    tree.clear();
+
+    // Splay policies
+    passed = test_policy<SplayTree<int, SplayTreeNode<int>, FullSplayPolicy>>();
+    passed &= test_policy<SplayTree<int, SplayTreeNode<int>, SemiSplayPolicy>>();
+    passed &= test_policy<SplayTree<int, SplayTreeNode<int>, DepthThresholdSplayPolicy<8>>>();
+    passed &= test_policy<SplayTree<int, SplayTreeNode<int>, ProbabilisticSplayPolicy<10>>>();
+    passed &= test_policy<SplayTree<int, SplayTreeNode<int>, PeriodicSplayPolicy<16>>>();
+
+    {
+        // A node within the threshold is found without moving
+        SplayTree<int, SplayTreeNode<int>, DepthThresholdSplayPolicy<1>> threshold_tree(compare);
+        for (int i : {4, 2, 6, 1, 3, 5, 7}) threshold_tree.insert(i);
+
+        const int root = threshold_tree.getRoot();
+        passed &= threshold_tree.contains(root);
+        passed &= threshold_tree.getRoot() == root;
+
+        // The deepest node is brought to the root
+        passed &= threshold_tree.contains(threshold_tree.getMostLeft());
+        passed &= threshold_tree.getRoot() == threshold_tree.getMostLeft();
+        threshold_tree.sanityCheck();
+    }
+
+    cout << "Splay Policy Check: " << (passed ? "passed" : "failed") << endl;
+
+    {
+        // Read only lookups
+        SplayTree<int> deferred_tree(compare);
+        for (int i = 0; i < 100; i++) deferred_tree.insert(i);
+
+        const SplayTree<int> &const_tree = deferred_tree;
+        passed = const_tree.peek(0);
+        passed &= !const_tree.peek(-1);
+        passed &= const_tree.containsDeferred(0);
+        passed &= const_tree.containsDeferred(50);
+        passed &= !const_tree.containsDeferred(100);
+        passed &= deferred_tree.getRoot() == 99;
+
+        // Nodes near the root are not worth recording
+        passed &= const_tree.containsDeferred(98);
+
+        // Removed nodes must be forgotten before they are applied
+        passed &= deferred_tree.remove(50);
+        passed &= deferred_tree.getRoot() == 49;
+
+        deferred_tree.applyDeferred();
+        passed &= deferred_tree.getRoot() == 0;
+        passed &= deferred_tree.size() == 99;
+        deferred_tree.sanityCheck();
+
+        // Nothing left to apply
+        deferred_tree.applyDeferred();
+        passed &= deferred_tree.getRoot() == 0;
+
+        // Copies and clears drop anything recorded
+        deferred_tree.containsDeferred(98);
+        SplayTree<int> copy_tree(deferred_tree);
+        copy_tree.applyDeferred();
+        passed &= copy_tree.getRoot() == 0;
+
+        deferred_tree.clear();
+        deferred_tree.applyDeferred();
+        passed &= deferred_tree.empty();
+    }
+
+    cout << "Deferred Splay Check: " << (passed ? "passed" : "failed") << endl;
+
+    {
+        // Split, join and ranges
+        SplayTree<int> lower(compare), upper(compare), range(compare);
+        for (int i = 0; i < 100; i++) lower.insert(i);
+
+        lower.split(60, upper);
+        passed = lower.size() == 60 && upper.size() == 40;
+        passed &= lower.getMostRight() == 59 && upper.getMostLeft() == 60;
+        lower.sanityCheck();
+        upper.sanityCheck();
+
+        // Joining works in either order, overlapping trees are refused
+        upper.join(lower);
+        passed &= upper.size() == 100 && lower.empty();
+        upper.sanityCheck();
+
+        lower.insert(50);
+        try {
+            upper.join(lower);
+            passed = false;
+        } catch (std::invalid_argument &) {}
+        passed &= upper.size() == 100 && lower.size() == 1;
+
+        passed &= upper.eraseRange(10, 20) == 10;
+        passed &= upper.eraseRange(10, 20) == 0;
+        passed &= upper.eraseRange(20, 10) == 0;
+        passed &= !upper.contains(10) && !upper.contains(19) && upper.contains(9) && upper.contains(20);
+        passed &= upper.size() == 90;
+        upper.sanityCheck();
+
+        passed &= upper.extractRange(-5, 5, range) == 5;
+        passed &= range.size() == 5 && range.getMostLeft() == 0 && range.getMostRight() == 4;
+        passed &= upper.size() == 85 && upper.getMostLeft() == 5;
+        upper.sanityCheck();
+        range.sanityCheck();
+
+        // Countable trees keep their count
+        SplayTreeCountable<int> countable(compare), countable_upper(compare);
+        for (int i = 0; i < 100; i++) countable.insert(i);
+        countable.split(30, countable_upper);
+        passed &= countable.size() == 30 && countable_upper.size() == 70;
+        passed &= countable_upper.eraseRange(50, 60) == 10;
+        countable.join(countable_upper);
+        passed &= countable.size() == 90;
+        countable.sanityCheck();
+    }
+
+    cout << "Split Join Check: " << (passed ? "passed" : "failed") << endl;
+
+    {
+        // Copies share nodes until written, even by a splaying contains()
+        SplayTree<int, SharedSplayTreeNode<int>> base(compare);
+        SplayTree<int, SharedSplayTreeNode<int>, SemiSplayPolicy> semi_base(compare);
+        for (int i = 0; i < 1000; i++) {
+            base.insert(i);
+            semi_base.insert(i);
+        }
+
+        auto copy = base;
+        auto semi_copy = semi_base;
+        passed = copy.contains(500) && semi_copy.contains(3) && semi_copy.contains(700);
+        passed &= copy.insert(1000) && copy.remove(0) && copy.popMostLeft() == 1;
+        passed &= semi_copy.remove(500) && semi_copy.popMostRight() == 999;
+        passed &= copy.eraseRange(100, 200) == 100 && copy.size() == 899;
+        copy.sanityCheck();
+        semi_copy.sanityCheck();
+
+        passed &= base.size() == 1000 && base.peek(0) && base.peek(150) && !base.peek(1000);
+        passed &= semi_base.size() == 1000 && semi_base.peek(500) && semi_base.peek(999);
+        int expected = 0;
+        for (auto it = base.inorder_begin(); it != base.inorder_end(); ++it) passed &= *it == expected++;
+        base.sanityCheck();
+        semi_base.sanityCheck();
+    }
+
+    cout << "Copy On Write Check: " << (passed ? "passed" : "failed") << endl;
+
     // And some memory handling checks
     // make sure Assignment does not leak
     SplayTree<int> tree_a, tree_b;
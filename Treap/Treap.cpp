@@ -0,0 +1,200 @@
+#ifndef TREAP_CPP
+#define TREAP_CPP
+
+#include <utility>
+#include <stdexcept>
+#include "Treap.h"
+
+template <class T, class Node>
+bool Treap<T, Node>::contains(const T &value) noexcept {
+    /**
+     * Check if value is present in the tree.
+     */
+    const Node *node = root;
+    while (node != nullptr) {
+        auto cmp = compare(value, node->value);
+        if (cmp == 0) return true;
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return false;
+}
+
+template <class T, class Node>
+bool Treap<T, Node>::insertInternal(Node *&node, const T &value) {
+    bool rising;
+    return insertInternal(node, value, priority(value), rising);
+}
+
+template <class T, class Node>
+bool Treap<T, Node>::insertInternal(Node *&node, const T &value, const uint64_t value_priority, bool &rising) {
+    // Handle if node does not exist
+    if (node == nullptr) {
+        node = new Node(value);
+        rising = true;
+        return true;
+    }
+
+    auto cmp = compare(value, node->value);
+
+    if (cmp == 0) {
+        // value exists in the tree
+        // do not modify, nothing inserted
+        return false;
+    }
+
+    Node *&child = cmp < 0 ? node->left : node->right;
+    if (!insertInternal(child, value, value_priority, rising))
+        return false;
+    node->size++;
+
+    // Once the new node stops below a higher priority, everything above is already in heap order
+    if (!rising) return true;
+    if (value_priority <= priority(node->value)) {
+        rising = false;
+        return true;
+    }
+
+    // Rotate the new node above node
+    Node *temp = child;
+    if (cmp < 0) {
+        node->left = temp->right;
+        temp->right = node;
+    } else {
+        node->right = temp->left;
+        temp->left = node;
+    }
+    temp->size = node->size;
+    updateSize(node);
+    node = temp;
+    return true;
+}
+
+template <class T, class Node>
+bool Treap<T, Node>::removeInternal(Node *&node, const T &value) {
+    // If the stack has a nullptr on top, then failed to find node.
+    if (node == nullptr) return false;
+
+    auto cmp = compare(value, node->value);
+
+    if (cmp == 0) {
+        // Merge the children into its place
+        Node *temp = node;
+        node = temp->left;
+        joinInternal(node, temp->right);
+        this->destroyNode(temp);
+        return true;
+    }
+
+    if (!removeInternal(cmp < 0 ? node->left : node->right, value))
+        return false;
+    node->size--;
+    return true;
+}
+
+template <class T, class Node>
+Node* Treap<T, Node>::popMostLeftInternal(Node *&node) {
+    // The most left node has no left child. Its right keeps heap order in its place.
+    Node **slot = &node;
+    while ((*slot)->left != nullptr) {
+        (*slot)->size--;
+        slot = &(*slot)->left;
+    }
+
+    Node *temp = *slot;
+    *slot = temp->right;
+    return temp;
+}
+
+template <class T, class Node>
+Node* Treap<T, Node>::popMostRightInternal(Node *&node) {
+    Node **slot = &node;
+    while ((*slot)->right != nullptr) {
+        (*slot)->size--;
+        slot = &(*slot)->right;
+    }
+
+    Node *temp = *slot;
+    *slot = temp->left;
+    return temp;
+}
+
+template <class T, class Node>
+Node* Treap<T, Node>::splitInternal(Node *&node, const T &key) {
+    /*
+     * Walk down towards key. Each node on the way goes to the less or the greater side,
+     * taking its children on that side with it. The split of the rest hangs on the side facing key.
+     * Nodes keep their order down each side, so both stay heaps. Sizes are fixed on the way back up.
+     */
+    if (node == nullptr) return nullptr;
+
+    Node *greater;
+    if (compare(node->value, key) < 0) {
+        greater = splitInternal(node->right, key);
+    } else {
+        greater = node;
+        node = greater->left;
+        greater->left = splitInternal(node, key);
+        updateSize(greater);
+    }
+
+    if (node != nullptr) updateSize(node);
+    return greater;
+}
+
+template <class T, class Node>
+void Treap<T, Node>::joinInternal(Node *&node, Node *greater) {
+    /*
+     * Walk down the right edge of node and the left edge of greater, merging them by priority.
+     * slot holds the less of the two trees still to merge.
+     */
+    Node **slot = &node;
+    while (*slot != nullptr && greater != nullptr) {
+        if (priority((*slot)->value) >= priority(greater->value)) {
+            // The less root stays on top. Merge greater into its right.
+            (*slot)->size += greater->size;
+            slot = &(*slot)->right;
+        } else {
+            // The greater root goes on top. Merge its left with the less tree.
+            Node *less = *slot;
+            greater->size += less->size;
+            *slot = greater;
+            slot = &greater->left;
+            greater = *slot;
+            *slot = less;
+        }
+    }
+
+    if (*slot == nullptr) *slot = greater;
+}
+
+template <class T, class Node>
+void Treap<T, Node>::split(const T &key, Treap &greater) {
+    if (&greater == this) return;
+
+    greater.clear();
+    greater.root = splitInternal(root, key);
+
+    count = sizeOf(root);
+    greater.count = sizeOf(greater.root);
+}
+
+template <class T, class Node>
+void Treap<T, Node>::join(Treap &other) {
+    if (&other == this || other.root == nullptr) return;
+
+    if (root != nullptr && compare(this->getMostRight(), other.getMostLeft()) >= 0) {
+        // Maybe other is entirely less than this
+        if (compare(other.getMostRight(), this->getMostLeft()) >= 0)
+            throw std::invalid_argument("trees overlap");
+
+        std::swap(root, other.root);
+    }
+
+    // This is now entirely less than other
+    joinInternal(root, other.root);
+    count += other.count;
+
+    other.root = nullptr;
+    other.count = 0;
+}
+#endif //TREAP_CPP
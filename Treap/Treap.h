@@ -0,0 +1,118 @@
+/*
+ * Implementation of a Treap that ignores duplicate entries
+ *
+ * A treap is a binary search tree on the values, and a max heap on their priorities.
+ * With random priorities its shape is that of a random insertion order, so it is balanced in expectation.
+ *
+ * Priorities are a hash of the value, so nothing is stored for them and the shape only depends on the values held.
+ * split() and join() only walk one path each, which makes cutting the tree up for bulk or parallel work cheap.
+ * Each node counts its subtree, so the sizes of both halves of a split are known without walking them.
+ */
+#ifndef TREAP_H
+#define TREAP_H
+
+#include <cstdint>
+#include <functional>
+#include "../binaryTree.h"
+
+#ifdef BINARYTREE_SANITY_CHECK
+#include <stdexcept> // For sanity error handling
+#endif
+
+template <class T>
+struct TreapNode {
+    // Public reference to T for reference
+    using value_type = T;
+
+    explicit TreapNode(const T &value): left(nullptr), right(nullptr), size(1), value(value) {}
+
+    // Copy constructor
+    TreapNode(const TreapNode &tree) = default;
+
+    TreapNode *left;
+    TreapNode *right;
+
+    // Nodes in this subtree, including this one
+    size_t size;
+
+    T value;
+};
+
+template <class T, class Node = TreapNode<T>>
+class Treap: virtual public BinaryTree<T, Node> {
+  public:
+    using value_type = T;
+
+  protected:
+    using BinaryTree<T, Node>::root;
+    using BinaryTree<T, Node>::count;
+    using BinaryTree<T, Node>::compare;
+
+    // Heap priority of a value
+    static uint64_t priority(const T &value) noexcept {
+        // std::hash of an integer is often the integer itself, so mix the bits (splitmix64 finalizer)
+        uint64_t x = std::hash<T>()(value);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static size_t sizeOf(const Node *node) noexcept {return node != nullptr ? node->size : 0;}
+    static void updateSize(Node *node) noexcept {node->size = 1 + sizeOf(node->left) + sizeOf(node->right);}
+
+    bool insertInternal(Node *&node, const T &value);
+    /**
+     * Insert value, with the given priority, under node.
+     * rising is set while the new node is the root of the subtree, and may need rotating further up.
+     */
+    bool insertInternal(Node *&node, const T &value, uint64_t value_priority, bool &rising);
+
+    bool removeInternal(Node *&node, const T &value);
+    Node* popMostLeftInternal(Node *&node);
+    Node* popMostRightInternal(Node *&node);
+
+    // Cut node so it keeps the values less than key. Returns the subtree of the values not less than key.
+    Node* splitInternal(Node *&node, const T &key);
+    // Hang greater on node. Every value in greater must be greater than every value in node.
+    void joinInternal(Node *&node, Node *greater);
+
+  public:
+    using BinaryTree<T, Node>::empty;
+
+    explicit Treap(int (*compare)(const T &a, const T &b) = default_compare): BinaryTree<T, Node>(compare) {}
+
+    // Copy constructor
+    Treap(const Treap &tree): BinaryTree<T, Node>(tree) {};
+
+    bool contains(const T &value) noexcept override;
+
+    /**
+     * Move every value not less than key into greater.
+     * Anything already in greater is cleared.
+     */
+    void split(const T &key, Treap &greater);
+
+    /**
+     * Move every value of other into this tree, leaving other empty.
+     * All values of one tree must be less than all values of the other.
+     * Throws std::invalid_argument if the trees overlap.
+     */
+    void join(Treap &other);
+
+#ifdef BINARYTREE_SANITY_CHECK
+  protected:
+    void sanityCheckInternal(const Node* const &node) const override {
+        BinaryTree<T, Node>::sanityCheckInternal(node);
+
+        if (node->size != 1 + sizeOf(node->left) + sizeOf(node->right))
+            throw std::logic_error("Node size does not match its subtree");
+
+        if (node->left != nullptr && priority(node->left->value) > priority(node->value))
+            throw std::logic_error("Left child has a higher priority than its parent");
+        if (node->right != nullptr && priority(node->right->value) > priority(node->value))
+            throw std::logic_error("Right child has a higher priority than its parent");
+    }
+#endif
+};
+#include "Treap.cpp"
+#endif //TREAP_H
@@ -0,0 +1,26 @@
+/*
+ * Performance Benchmark for Treap
+ *
+ * g++ TreapBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o TreapBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "Treap.h"
+#include "../AVLTree/AVLTree.h"
+#include "../util/tree_benchmark.h"
+
+BENCHMARK_TEMPLATE(BM_Insert, Treap<int>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Remove, Treap<int>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Contains, Treap<int>)->TESTS;
+
+BENCHMARK_TEMPLATE(BM_Replace, AVLTree<int>)->CHURN_TESTS;
+BENCHMARK_TEMPLATE(BM_Replace, Treap<int>)->CHURN_TESTS;
+BENCHMARK_TEMPLATE(BM_SplitJoin, Treap<int>)->CHURN_TESTS;
+
+BENCHMARK_MAIN();
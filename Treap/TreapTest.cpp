@@ -0,0 +1,62 @@
+/*
+ * Test cases for testing the sanity of the Treap
+ */
+
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "Treap.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "Treap Tests" << endl;
+    test_set<Treap<int>>(compare);
+
+    // Hashed priorities make the shape that of a random insertion order, whatever order values arrive in
+    bool passed = check_bounded_height<Treap<int>>(
+        [](size_t size) { return 4 * size_t(ceil(log2(size + 1))); }, compare);
+    cout << "Height Check               : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        Treap<int> lower(compare), upper(compare);
+        for (int i = 0; i < 1000; i++) lower.insert(i);
+
+        lower.split(600, upper);
+        passed &= lower.size() == 600 && upper.size() == 400;
+        passed &= lower.getMostRight() == 599 && upper.getMostLeft() == 600;
+        lower.sanityCheck();
+        upper.sanityCheck();
+
+        // Joining works in either order, overlapping trees are refused
+        upper.join(lower);
+        passed &= upper.size() == 1000 && lower.empty();
+        upper.sanityCheck();
+
+        lower.insert(500);
+        try {
+            upper.join(lower);
+            passed = false;
+        } catch (std::invalid_argument &) {}
+        passed &= upper.size() == 1000 && lower.size() == 1;
+
+        // Splitting outside the values moves all or nothing
+        upper.split(-1, lower);
+        passed &= upper.empty() && lower.size() == 1000;
+        lower.split(1000, upper);
+        passed &= upper.empty() && lower.size() == 1000;
+
+        // The shape only depends on the values, so rejoined pieces match a tree built directly
+        Treap<int> direct(compare);
+        for (int i = 999; i >= 0; i--) direct.insert(i);
+        passed &= std::equal(lower.preorder_begin(), lower.preorder_end(), direct.preorder_begin(), direct.preorder_end());
+        lower.sanityCheck();
+    }
+    cout << "Split Join Check           : " << (passed ? "passed" : "failed") << endl;
+}
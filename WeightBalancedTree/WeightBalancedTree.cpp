@@ -0,0 +1,274 @@
+#ifndef WEIGHTBALANCEDTREE_CPP
+#define WEIGHTBALANCEDTREE_CPP
+
+#include <utility>
+#include <stdexcept>
+#include "WeightBalancedTree.h"
+
+template <class T, class Node>
+bool WeightBalancedTree<T, Node>::contains(const T &value) noexcept {
+    /**
+     * Check if value is present in the tree.
+     */
+    const Node *node = root;
+    while (node != nullptr) {
+        auto cmp = compare(value, node->value);
+        if (cmp == 0) return true;
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return false;
+}
+
+template <class T, class Node>
+size_t WeightBalancedTree<T, Node>::size() const noexcept {
+    return sizeOf(root);
+}
+
+template <class T, class Node>
+T WeightBalancedTree<T, Node>::select(size_t index) const {
+    if (index >= sizeOf(root)) throw std::out_of_range("index out of range");
+
+    const Node *node = root;
+    while (true) {
+        const size_t left_size = sizeOf(node->left);
+        if (index < left_size) {
+            node = node->left;
+        } else if (index == left_size) {
+            return node->value;
+        } else {
+            index -= left_size + 1;
+            node = node->right;
+        }
+    }
+}
+
+template <class T, class Node>
+size_t WeightBalancedTree<T, Node>::rank(const T &value) const noexcept {
+    size_t less = 0;
+    const Node *node = root;
+    while (node != nullptr) {
+        auto cmp = compare(value, node->value);
+        if (cmp <= 0) {
+            if (cmp == 0) return less + sizeOf(node->left);
+            node = node->left;
+        } else {
+            // node and everything left of it is less
+            less += sizeOf(node->left) + 1;
+            node = node->right;
+        }
+    }
+    return less;
+}
+
+template <class T, class Node>
+void WeightBalancedTree<T, Node>::leftRotation(Node *&node) noexcept {
+    Node *temp = node->right;
+    node->right = temp->left;
+    temp->left = node;
+    updateSize(node);
+    updateSize(temp);
+    node = temp;
+}
+
+template <class T, class Node>
+void WeightBalancedTree<T, Node>::rightRotation(Node *&node) noexcept {
+    Node *temp = node->left;
+    node->left = temp->right;
+    temp->right = node;
+    updateSize(node);
+    updateSize(temp);
+    node = temp;
+}
+
+template <class T, class Node>
+void WeightBalancedTree<T, Node>::rebalance(Node *&node) noexcept {
+    updateSize(node);
+
+    const size_t left_weight = weightOf(node->left);
+    const size_t right_weight = weightOf(node->right);
+
+    if (right_weight > delta * left_weight) {
+        // Right is too heavy. A single rotation would leave the inner grandchild too heavy, if it is large.
+        if (weightOf(node->right->left) >= gamma * weightOf(node->right->right))
+            rightRotation(node->right);
+        leftRotation(node);
+    } else if (left_weight > delta * right_weight) {
+        if (weightOf(node->left->right) >= gamma * weightOf(node->left->left))
+            leftRotation(node->left);
+        rightRotation(node);
+    }
+}
+
+template <class T, class Node>
+Node* WeightBalancedTree<T, Node>::link(Node *less, Node *middle, Node *greater) noexcept {
+    if (weightOf(greater) > delta * weightOf(less)) {
+        greater->left = link(less, middle, greater->left);
+        rebalance(greater);
+        return greater;
+    }
+    if (weightOf(less) > delta * weightOf(greater)) {
+        less->right = link(less->right, middle, greater);
+        rebalance(less);
+        return less;
+    }
+
+    // Close enough in weight to hang both off middle
+    middle->left = less;
+    middle->right = greater;
+    updateSize(middle);
+    return middle;
+}
+
+/**
+ * An internal insert command that inserts a new value recursively.
+ *
+ * Returns true if the value is inserted.
+ * Returns false if the value is found in the tree, and the tree is not modified.
+ */
+template <class T, class Node>
+bool WeightBalancedTree<T, Node>::insertInternal(Node *&node, const T &value) {
+    // Handle if node does not exist
+    if (node == nullptr) {
+        node = new Node(value);
+        return true;
+    }
+
+    auto cmp = compare(value, node->value);
+
+    if (cmp == 0) {
+        // value exists in the tree
+        // do not modify, nothing inserted
+        return false;
+    }
+
+    if (!insertInternal(cmp < 0 ? node->left : node->right, value))
+        return false;
+
+    rebalance(node);
+    return true;
+}
+
+template <class T, class Node>
+Node* WeightBalancedTree<T, Node>::popMostLeftInternal(Node *&node) {
+    Node *temp;
+    if (node->left != nullptr) {
+        temp = popMostLeftInternal(node->left);
+        rebalance(node);
+    } else {
+        // Return node, but remove from tree.
+        temp = node;
+        node = node->right;
+    }
+    return temp;
+}
+
+template <class T, class Node>
+Node* WeightBalancedTree<T, Node>::popMostRightInternal(Node *&node) {
+    Node *temp;
+    if (node->right != nullptr) {
+        temp = popMostRightInternal(node->right);
+        rebalance(node);
+    } else {
+        // Return node, but remove from tree.
+        temp = node;
+        node = node->left;
+    }
+    return temp;
+}
+
+template <class T, class Node>
+bool WeightBalancedTree<T, Node>::removeInternal(Node *&node, const T &value) {
+    // If the stack has a nullptr on top, then failed to find node.
+    if (node == nullptr) return false;
+
+    auto cmp = compare(value, node->value);
+
+    if (cmp == 0) {
+        Node *temp = node;
+        if (temp->left != nullptr && temp->right != nullptr) {
+            // Replace with the most left value of its right branch
+            node = popMostLeftInternal(temp->right);
+            node->left = temp->left;
+            node->right = temp->right;
+            rebalance(node);
+        } else {
+            node = temp->left != nullptr ? temp->left : temp->right;
+        }
+        this->destroyNode(temp);
+        return true;
+    }
+
+    if (!removeInternal(cmp < 0 ? node->left : node->right, value))
+        return false;
+
+    rebalance(node);
+    return true;
+}
+
+template <class T, class Node>
+Node* WeightBalancedTree<T, Node>::splitInternal(Node *&node, const T &key) {
+    /*
+     * Walk down towards key. Each node on the way is relinked, as the middle,
+     * with its children on the far side of key and the split of the rest on the near side.
+     */
+    if (node == nullptr) return nullptr;
+
+    Node *left = node->left;
+    Node *right = node->right;
+
+    if (compare(node->value, key) < 0) {
+        Node *greater = splitInternal(right, key);
+        node = link(left, node, right);
+        return greater;
+    }
+
+    Node *middle = node;
+    Node *greater = splitInternal(left, key);
+    node = left;
+    return link(greater, middle, right);
+}
+
+template <class T, class Node>
+void WeightBalancedTree<T, Node>::joinInternal(Node *&node, Node *greater) {
+    if (greater == nullptr) return;
+    if (node == nullptr) {
+        node = greater;
+        return;
+    }
+
+    // Use the least value of greater to link the two
+    Node *middle = popMostLeftInternal(greater);
+    node = link(node, middle, greater);
+}
+
+template <class T, class Node>
+void WeightBalancedTree<T, Node>::split(const T &key, WeightBalancedTree &greater) {
+    if (&greater == this) return;
+
+    greater.clear();
+    greater.root = splitInternal(root, key);
+
+    count = sizeOf(root);
+    greater.count = sizeOf(greater.root);
+}
+
+template <class T, class Node>
+void WeightBalancedTree<T, Node>::join(WeightBalancedTree &other) {
+    if (&other == this || other.root == nullptr) return;
+
+    if (root != nullptr && compare(this->getMostRight(), other.getMostLeft()) >= 0) {
+        // Maybe other is entirely less than this
+        if (compare(other.getMostRight(), this->getMostLeft()) >= 0)
+            throw std::invalid_argument("trees overlap");
+
+        std::swap(root, other.root);
+    }
+
+    // This is now entirely less than other
+    joinInternal(root, other.root);
+    count += other.count;
+
+    other.root = nullptr;
+    other.count = 0;
+}
+#endif //WEIGHTBALANCEDTREE_CPP
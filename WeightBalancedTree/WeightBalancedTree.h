@@ -0,0 +1,133 @@
+/*
+ * Implementation of a weight balanced tree, BB[alpha], that ignores duplicate entries
+ *
+ * Each node stores the size of its subtree, and that one field does all the work.
+ * Balance compares the sizes of siblings, select() and rank() walk a single path using them,
+ * and split() and join() relink whole subtrees in O(log n).
+ * An AVLTree would need a size alongside its height for the same.
+ *
+ * Balance uses the integer parameters delta = 3, gamma = 2 of Hirai and Yamamoto,
+ * "Balancing weight-balanced trees" (2011), for which single and double rotations are proven sufficient.
+ */
+#ifndef WEIGHTBALANCEDTREE_H
+#define WEIGHTBALANCEDTREE_H
+
+#include <cstdint>
+#include "../binaryTree.h"
+
+#ifdef BINARYTREE_SANITY_CHECK
+#include <stdexcept> // For sanity error handling
+#endif
+
+template <class T>
+struct WeightBalancedTreeNode {
+    // Public reference to T for reference
+    using value_type = T;
+
+    explicit WeightBalancedTreeNode(const T &value): left(nullptr), right(nullptr), size(1), value(value) {}
+
+    // Copy constructor
+    WeightBalancedTreeNode(const WeightBalancedTreeNode &tree) = default;
+
+    WeightBalancedTreeNode *left;
+    WeightBalancedTreeNode *right;
+
+    // Nodes in this subtree, including this one
+    size_t size;
+
+    T value;
+};
+
+template <class T, class Node = WeightBalancedTreeNode<T>>
+class WeightBalancedTree: virtual public BinaryTree<T, Node> {
+  public:
+    using value_type = T;
+
+    // A subtree may weigh at most delta times its sibling
+    static constexpr size_t delta = 3;
+    // Rotate twice if the inner grandchild weighs at least gamma times the outer one
+    static constexpr size_t gamma = 2;
+
+  protected:
+    using BinaryTree<T, Node>::root;
+    using BinaryTree<T, Node>::count;
+    using BinaryTree<T, Node>::compare;
+
+    static size_t sizeOf(const Node *node) noexcept {return node != nullptr ? node->size : 0;}
+    // Weight is size + 1, so empty subtrees still count
+    static size_t weightOf(const Node *node) noexcept {return sizeOf(node) + 1;}
+    static void updateSize(Node *node) noexcept {node->size = 1 + sizeOf(node->left) + sizeOf(node->right);}
+
+    static void leftRotation(Node *&node) noexcept;
+    static void rightRotation(Node *&node) noexcept;
+    // Update the size of node, then rotate if one side outweighs the other by more than delta
+    static void rebalance(Node *&node) noexcept;
+
+    /**
+     * Join less, middle and greater into one balanced tree, in that order.
+     * Descends the heavier tree until the weights are within delta, so takes O(log n).
+     */
+    static Node* link(Node *less, Node *middle, Node *greater) noexcept;
+
+    bool insertInternal(Node *&node, const T &value);
+    bool removeInternal(Node *&node, const T &value);
+    Node* popMostLeftInternal(Node *&node);
+    Node* popMostRightInternal(Node *&node);
+
+    // Cut node so it keeps the values less than key. Returns the subtree of the values not less than key.
+    Node* splitInternal(Node *&node, const T &key);
+    // Hang greater on node. Every value in greater must be greater than every value in node.
+    void joinInternal(Node *&node, Node *greater);
+
+  public:
+    using BinaryTree<T, Node>::empty;
+
+    explicit WeightBalancedTree(int (*compare)(const T &a, const T &b) = default_compare): BinaryTree<T, Node>(compare) {}
+
+    // Copy constructor
+    WeightBalancedTree(const WeightBalancedTree &tree): BinaryTree<T, Node>(tree) {};
+
+    bool contains(const T &value) noexcept override;
+
+    // Taken from the root, O(1)
+    size_t size() const noexcept override;
+
+    /**
+     * The value at index in order, so select(0) is the most left value.
+     * Throws std::out_of_range if index is not less than size().
+     */
+    T select(size_t index) const;
+
+    // Number of values less than value
+    size_t rank(const T &value) const noexcept;
+
+    /**
+     * Move every value not less than key into greater.
+     * Anything already in greater is cleared.
+     */
+    void split(const T &key, WeightBalancedTree &greater);
+
+    /**
+     * Move every value of other into this tree, leaving other empty.
+     * All values of one tree must be less than all values of the other.
+     * Throws std::invalid_argument if the trees overlap.
+     */
+    void join(WeightBalancedTree &other);
+
+#ifdef BINARYTREE_SANITY_CHECK
+  protected:
+    void sanityCheckInternal(const Node* const &node) const override {
+        BinaryTree<T, Node>::sanityCheckInternal(node);
+
+        if (node->size != 1 + sizeOf(node->left) + sizeOf(node->right))
+            throw std::logic_error("Node size does not match its subtree");
+
+        if (weightOf(node->left) > delta * weightOf(node->right))
+            throw std::logic_error("Left outweighs right by more than delta");
+        if (weightOf(node->right) > delta * weightOf(node->left))
+            throw std::logic_error("Right outweighs left by more than delta");
+    }
+#endif
+};
+#include "WeightBalancedTree.cpp"
+#endif //WEIGHTBALANCEDTREE_H
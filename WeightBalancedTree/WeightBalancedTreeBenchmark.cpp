@@ -0,0 +1,49 @@
+/*
+ * Performance Benchmark for WeightBalancedTree
+ *
+ * g++ WeightBalancedTreeBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o WeightBalancedTreeBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+//#define BINARYTREE_SANITY_CHECK
+
+#include "WeightBalancedTree.h"
+#include "../AVLTree/AVLTree.h"
+#include "../util/tree_benchmark.h"
+
+BENCHMARK_TEMPLATE(BM_Insert, WeightBalancedTree<int>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Remove, WeightBalancedTree<int>)->TESTS;
+BENCHMARK_TEMPLATE(BM_Contains, WeightBalancedTree<int>)->TESTS;
+
+BENCHMARK_TEMPLATE(BM_Replace, AVLTree<int>)->CHURN_TESTS;
+BENCHMARK_TEMPLATE(BM_Replace, WeightBalancedTree<int>)->CHURN_TESTS;
+BENCHMARK_TEMPLATE(BM_SplitJoin, WeightBalancedTree<int>)->CHURN_TESTS;
+
+// Order statistics, which an AVLTree can only answer by walking
+static void BM_WeightBalancedTreeSelect(benchmark::State &state) {
+    WeightBalancedTree<int> tree;
+    while (tree.size() < (size_t) state.range(0))
+        tree.insert(RandomNumber());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.select(RandomNumber() % tree.size()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WeightBalancedTreeSelect)->CHURN_TESTS;
+
+static void BM_WeightBalancedTreeRank(benchmark::State &state) {
+    WeightBalancedTree<int> tree;
+    while (tree.size() < (size_t) state.range(0))
+        tree.insert(RandomNumber());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.rank(RandomNumber()));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WeightBalancedTreeRank)->CHURN_TESTS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+/*
+ * Test cases for testing the sanity of the WeightBalancedTree
+ */
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+// Because the test must also pass all sanity checks
+#define BINARYTREE_SANITY_CHECK
+#include "WeightBalancedTree.h"
+#include "../util/tree_test.h"
+
+using namespace std;
+
+int main() {
+    cout << "WeightBalancedTree Tests" << endl;
+    test_set<WeightBalancedTree<int>>(compare);
+
+    // Neither side of any node outweighs the other by more than 3 to 1
+    bool passed = check_bounded_height<WeightBalancedTree<int>>(
+        [](size_t size) { return 2 * size_t(ceil(log2(size + 1))); }, compare);
+    cout << "Height Check               : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        WeightBalancedTree<int> lower(compare), upper(compare);
+        for (int i = 0; i < 1000; i++) lower.insert(i);
+
+        lower.split(600, upper);
+        passed &= lower.size() == 600 && upper.size() == 400;
+        passed &= lower.getMostRight() == 599 && upper.getMostLeft() == 600;
+        lower.sanityCheck();
+        upper.sanityCheck();
+
+        // Joining works in either order, overlapping trees are refused
+        upper.join(lower);
+        passed &= upper.size() == 1000 && lower.empty();
+        upper.sanityCheck();
+
+        lower.insert(500);
+        try {
+            upper.join(lower);
+            passed = false;
+        } catch (std::invalid_argument &) {}
+        passed &= upper.size() == 1000 && lower.size() == 1;
+
+        // Splitting outside the values moves all or nothing
+        upper.split(-1, lower);
+        passed &= upper.empty() && lower.size() == 1000;
+        lower.split(1000, upper);
+        passed &= upper.empty() && lower.size() == 1000;
+
+        // Very different sizes still join balanced
+        WeightBalancedTree<int> small(compare);
+        small.insert(-1);
+        lower.join(small);
+        passed &= lower.size() == 1001 && lower.getMostLeft() == -1;
+        small.insert(2000);
+        small.join(lower);
+        passed &= small.size() == 1002 && small.getMostRight() == 2000;
+        small.sanityCheck();
+    }
+    cout << "Split Join Check           : " << (passed ? "passed" : "failed") << endl;
+
+    passed = true;
+    {
+        WeightBalancedTree<int> tree(compare);
+        for (int i = 0; i < 1000; i++) tree.insert(i * 2);
+
+        passed &= tree.select(0) == 0 && tree.select(999) == 1998 && tree.select(500) == 1000;
+        passed &= tree.rank(0) == 0 && tree.rank(1000) == 500 && tree.rank(1001) == 501 && tree.rank(5000) == 1000;
+        try {
+            tree.select(1000);
+            passed = false;
+        } catch (std::out_of_range &) {}
+
+        // Every index round trips
+        for (size_t i = 0; i < tree.size(); i++) passed &= tree.rank(tree.select(i)) == i;
+    }
+    cout << "Select Rank Check          : " << (passed ? "passed" : "failed") << endl;
+}
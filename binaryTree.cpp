@@ -6,6 +6,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <utility>
 #include "binaryTree.h"
 
 /**
@@ -13,6 +14,9 @@
  */
 template <class T, class Node>
 bool BinaryTree<T, Node>::insert(const T &value) noexcept {
+    // Copy-on-write copies the path down, so make sure something will change first
+    if (Shared::shared && findInternal(value) != nullptr) return false;
+
     bool result = insertInternal(root, value);
     count += result;
     return result;
@@ -23,6 +27,8 @@ bool BinaryTree<T, Node>::insert(const T &value) noexcept {
  */
 template <class T, class Node>
 bool BinaryTree<T, Node>::remove(const T &value) noexcept {
+    if (Shared::shared && findInternal(value) == nullptr) return false;
+
     bool result = removeInternal(root, value);
     count -= result;
     return result;
@@ -38,13 +44,13 @@ void BinaryTree<T, Node>::clear() noexcept {
 
 template <class T, class Node>
 void BinaryTree<T, Node>::clearInternal(Node* &node) noexcept {
-    // Recurse if node exists
-    if (node != nullptr) {
+    // Recurse if node exists, and no other tree still holds it
+    if (node != nullptr && Shared::release(node)) {
         clearInternal(node->left);
         clearInternal(node->right);
 
-        // Afterward, delete this node.
-        delete node;
+        // Afterward, free this node.
+        destroyNode(node);
     }
 }
 
@@ -53,6 +59,10 @@ Node* BinaryTree<T, Node>::copyNode(const Node* const &node) {
     if (node == nullptr) {
         return nullptr;
     }
+
+    // Copy-on-write, so share the whole subtree until either tree changes it
+    if (Shared::shared) return Shared::retain(node);
+
     Node *newNode = new Node(*node);
 
     // Copy left and right
@@ -64,6 +74,14 @@ Node* BinaryTree<T, Node>::copyNode(const Node* const &node) {
 
 template <class T, class Node>
 void BinaryTree<T, Node>::replaceNode(Node *&node, const Node* const &other) {
+    if (Shared::shared) {
+        // Share other before letting go of node, in case they are the same
+        Node *old = node;
+        node = copyNode(other);
+        clearInternal(old);
+        return;
+    }
+
     // Create node, delete node, or assign, depending in need
     if (other == nullptr) {
         // Delete
@@ -87,9 +105,22 @@ void BinaryTree<T, Node>::replaceNode(Node *&node, const Node* const &other) {
     }
 }
 
+template <class T, class Node>
+bool BinaryTree<T, Node>::own(Node *&node) {
+    if (node == nullptr || !Shared::isShared(node)) return false;
+
+    // The copy holds the same children, and lets go of the shared node in this tree's place
+    Node *copy = new Node(*node);
+    Shared::retain(copy->left);
+    Shared::retain(copy->right);
+    clearInternal(node);
+    node = copy;
+    return true;
+}
+
 // Copy constructor
 template <class T, class Node>
-BinaryTree<T, Node>::BinaryTree(const BinaryTree &tree): compare(tree.compare) {
+BinaryTree<T, Node>::BinaryTree(const BinaryTree &tree): compare(tree.compare), count(tree.count) {
     root = copyNode(tree.root);
 }
 
@@ -146,6 +177,18 @@ T BinaryTree<T, Node>::getMostLeft() const {
     }
 }
 
+template <class T, class Node>
+const Node* BinaryTree<T, Node>::findInternal(const T &value) const noexcept {
+    const Node *node = root;
+    while (node != nullptr) {
+        auto cmp = compare(value, node->value);
+        if (cmp == 0) return node;
+
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return nullptr;
+}
+
 template <class T, class Node>
 const Node* BinaryTree<T, Node>::getMostLeftInternal(const Node* const &node) const noexcept {
     if (node->left != nullptr) {
@@ -180,7 +223,10 @@ const Node* BinaryTree<T, Node>::getMostRightInternal(const Node* const &node) c
 template <class T, class Node>
 T BinaryTree<T, Node>::popMostLeft() {
     if (!empty()) {
-        T &result = popMostLeftInternal(root)->value;
+        // The node has been unlinked, so take its value and free it
+        Node *node = popMostLeftInternal(root);
+        T result = std::move(node->value);
+        destroyNode(node);
         count--;
         return result;
     } else {
@@ -192,7 +238,10 @@ T BinaryTree<T, Node>::popMostLeft() {
 template <class T, class Node>
 T BinaryTree<T, Node>::popMostRight() {
     if (!empty()) {
-        T &result = popMostRightInternal(root)->value;
+        // The node has been unlinked, so take its value and free it
+        Node *node = popMostRightInternal(root);
+        T result = std::move(node->value);
+        destroyNode(node);
         count--;
         return result;
     } else {
@@ -270,91 +319,17 @@ void BinaryTree<T, Node>::printTreeWithSpacing(const size_t spacing, size_t widt
     }
 
     // Iterator in level order. This is an infinite iterator that will never terminate.
+    // The first call takes the root, every later call advances first.
     auto it = level_order_print_begin();
+    bool first = true;
 
-    // Set the fill character
-    ostream << std::setfill(fill);
-
-    // First level is its own special case
-    // Special in it is both the first and last value on the level
-    // Scoped to prevent name collisions
-    {
-        const size_t base_width = ((width + spacing) << (height - 1)) - width;
-        const size_t padding_left  = (base_width + !biasLeft - spacing) / 2;
-        const size_t padding_right = trailing ? (base_width + biasLeft - spacing) / 2: 0;
-        printTreeInternal(*it, padding_left, padding_right, width, background, ostream);
-        ostream << std::endl;
-    }
-
-    size_t level = 1;
-    for (; level < tree_height; level++) {
-        // Calculate the width of the base of this subtree.
-        // Width, minus the width of the single object that will be printed.
-        const size_t base_width = ((width + spacing) << (height - level - 1)) - width;
-        const size_t base_width_left = base_width + !biasLeft;
-        const size_t base_width_right = base_width + biasLeft;
-
-        // Special case for the first value
-        printTreeInternal(*++it, (base_width_left - spacing) / 2, base_width_right / 2,
-                          width, background, ostream);
-
-        for (size_t position = 1; position < ((1U << level) - 1U); position++) {
-            printTreeInternal(*++it, base_width_left / 2, base_width_right / 2,
-                              width, background, ostream);
-        }
-
-        // Special case for final in level
-        const size_t padding_right = trailing ? (base_width_right - spacing) / 2: 0;
-        printTreeInternal(*++it, base_width_left / 2, padding_right, width, background, ostream);
-        ostream << std::endl;
-    }
-
-    // Rolled of the end of the tree.
-    // Clear the iterator to free the memory
-    it.clear();
-
-    for (; level < height; level++) {
-        // Printing null lines after rolling off the end of the tree.
-        // All values will be null
-        // Calculate the width of the base of this subtree.
-        // Width, minus the width of the single object that will be printed.
-        const size_t base_width = ((width + spacing) << (height - level - 1)) - width;
-        const size_t base_width_left = base_width + !biasLeft;
-        const size_t base_width_right = base_width + biasLeft;
-
-        // Special case for the first value
-        printTreeInternal(nullptr, (base_width_left - spacing) / 2, base_width_right / 2,
-                          width, background, ostream);
-
-        for (size_t position = 1; position < ((1U << level) - 1U); position++) {
-            printTreeInternal(nullptr, base_width_left / 2, base_width_right / 2,
-                              width, background, ostream);
-        }
-
-        // Special case for final in level
-        const size_t padding_right = trailing ? (base_width_right - spacing) / 2: 0;
-        printTreeInternal(nullptr, base_width_left / 2, padding_right, width, background, ostream);
-        ostream << std::endl;
-    }
-}
-
-template <class T, class Node>
-void BinaryTree<T, Node>::printTreeInternal(
-        const Node* const &node,
-        const size_t padding_left, const size_t padding_right,
-        const size_t width, const char background, std::ostream &ostream) const noexcept {
-    // Print left
-    for (size_t i = 0; i < padding_left; ++i) ostream << background;
-
-    // Print object
-    ostream << std::setw((int) width);
-    if (node != nullptr)
-        ostream << node->value;
-    else
-        ostream << "";
+    print_tree_levels<T>([&it, &first]() -> const T* {
+        if (!first) ++it;
+        first = false;
 
-    // Print right
-    for (size_t i = 0; i < padding_right; ++i) ostream << background;
+        const Node *node = *it;
+        return node != nullptr ? &node->value : nullptr;
+    }, tree_height, spacing, width, height, fill, biasLeft, trailing, background, ostream);
 }
 
 template <class T, class Node>
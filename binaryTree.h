@@ -17,6 +17,9 @@
 #include <stdexcept>
 
 #include "util/clearable_queue.h"
+#include "util/shared_node.h"
+#include "util/node_deallocator.h"
+#include "util/tree_print.h"
 
 // Default comparator functions
 template <class T>
@@ -45,6 +48,13 @@ class BinaryTree {
     Node *root;
     size_t count;
 
+    // Reference counting for copy-on-write nodes, see util/shared_node.h. Does nothing for plain nodes.
+    using Shared = SharedNodeTraits<Node>;
+
+    // Free a node that has been unlinked, through the node type's NodeDeallocator, see util/node_deallocator.h.
+    // Every tree frees its nodes through this, so the node type decides whether they are deleted or retired.
+    static void destroyNode(Node *node) noexcept { NodeDeallocator<Node>::deallocate(node); }
+
     virtual bool insertInternal(Node *&node, const T &value) = 0;
 
     virtual bool removeInternal(Node *&node, const T &value) = 0;
@@ -54,11 +64,13 @@ class BinaryTree {
 
     /**
      * Recursively deallocate the values in the tree.
+     * Shared nodes are only let go of, and freed by the last tree holding them.
      */
     void clearInternal(Node* &node) noexcept;
 
     /**
      * Recursively duplicate the passed node.
+     * Shared nodes are not duplicated, just held once more.
      */
     Node* copyNode(const Node* const &node);
 
@@ -67,6 +79,18 @@ class BinaryTree {
      */
     void replaceNode(Node *&node, const Node* const &other);
 
+    /**
+     * Make node belong to this tree alone before changing it, copying it if another tree holds it too.
+     * The slot holding node must already belong to this tree. Does nothing for plain nodes.
+     * @return true if node was copied
+     */
+    bool own(Node *&node);
+
+    /**
+     * Search for value without changing the tree. Returns nullptr if not found.
+     */
+    const Node* findInternal(const T &value) const noexcept;
+
     /**
      * Recursively get the most left node in the tree.
      */
@@ -90,34 +114,8 @@ class BinaryTree {
      */
     virtual size_t getMaxStringWidth() const noexcept;
 
-    /**
-     * Internally print out part of the tree.
-     *
-     * @param node
-     * The node within the tree print.
-     * If null, a replacement is printed.
-     *
-     * @param padding_left
-     * Amount of padding to put on the left of the node.
-     *
-     * @param padding_right
-     * Amount of padding to put on the right of the node.
-     *
-     * @param width
-     * The width of the object to be printed. If the width varies, then the printed tree will have defects.
-     *
-     * @param background
-     * Character to print as the padding in this portion of the tree.
-     *
-     * @param ostream
-     * stream to print to.
-     */
-    void printTreeInternal(const Node* const &node,
-                           size_t padding_left, size_t padding_right,
-                           size_t width, char background, std::ostream &ostream) const noexcept;
-
   public:
-    explicit BinaryTree(int (*compare)(const T &a, const T &b) = default_compare): compare(compare), root(nullptr) {};
+    explicit BinaryTree(int (*compare)(const T &a, const T &b) = default_compare): compare(compare), root(nullptr), count(0) {};
 
     // Copy constructor
     BinaryTree(const BinaryTree &tree);
@@ -163,6 +161,9 @@ class BinaryTree {
     virtual T getMostLeft() const;
     virtual T getMostRight() const;
 
+    // Get the function the tree orders its values by
+    int (*getCompare() const noexcept)(const T &a, const T &b) { return compare; }
+
     /**
      * Get the height of the tree.
      * A height of zero indicates an empty tree.
@@ -15,6 +15,11 @@
 //#define BINARYTREE_EXTENDED_SANITY_CHECK
 #include "AVLTree/AVLTree.h"
 #include "SplayTree/splayTree.h"
+#include "RedBlackTree/RedBlackTree.h"
+#include "Treap/Treap.h"
+#include "PackedMemoryArray/PackedMemoryArray.h"
+#include "BPlusTree/BPlusTree.h"
+#include "AdaptiveRadixTree/AdaptiveRadixTree.h"
 
 void loadDataset(const char *filename, std::vector<std::string> &dataset) {
     // Load the values from the file into a vector.
@@ -184,4 +189,30 @@ int main(int argc, char *argv[]) {
     std::cout << "Splay Tree Tests" << std::endl;
     auto splay_tree = SplayTree<std::string>(stringCompare);
     churntest(splay_tree, &dataset[0], dataset.size());
+    std::cout << std::endl;
+
+    std::cout << "Red-Black Tree Tests" << std::endl;
+    auto red_black_tree = RedBlackTree<std::string>(stringCompare);
+    churntest(red_black_tree, &dataset[0], dataset.size());
+    std::cout << std::endl;
+
+    std::cout << "Treap Tests" << std::endl;
+    auto treap = Treap<std::string>(stringCompare);
+    churntest(treap, &dataset[0], dataset.size());
+    std::cout << std::endl;
+
+    std::cout << "Packed Memory Array Tests" << std::endl;
+    auto packed_memory_array = PackedMemoryArray<std::string>(stringCompare);
+    churntest(packed_memory_array, &dataset[0], dataset.size());
+    std::cout << std::endl;
+
+    std::cout << "B+ Tree Tests" << std::endl;
+    auto b_plus_tree = BPlusTree<std::string>(stringCompare);
+    churntest(b_plus_tree, &dataset[0], dataset.size());
+    std::cout << std::endl;
+
+    // Orders by bytes, which is what stringCompare does too
+    std::cout << "Adaptive Radix Tree Tests" << std::endl;
+    auto adaptive_radix_tree = AdaptiveRadixTree<std::string>();
+    churntest(adaptive_radix_tree, &dataset[0], dataset.size());
 }
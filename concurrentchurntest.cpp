@@ -0,0 +1,163 @@
+// Multi-threaded variant of churntest.
+// Every thread churns its own slice of the dataset, inserting it all and then removing it all, while the rest of
+// the dataset stays loaded in the shared collection. Repeated for 1, 2, 4, ... threads up to the core count, or the
+// second argument, to show how insert and remove throughput scales. The lock-free skip list, the concurrent AVL tree,
+// the sharded AVL tree and the flat combining AVL tree are compared with an AVL tree behind a mutex.
+
+#include <set>
+#include <chrono>
+#include <random>
+#include <cassert>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "AVLTree/AVLTree.h"
+#include "ConcurrentSkipList/ConcurrentSkipList.h"
+#include "ConcurrentAVLTree/ConcurrentAVLTree.h"
+#include "ShardedTree/ShardedTree.h"
+#include "FlatCombiningTree/FlatCombiningTree.h"
+#include "util/locked_tree.h"
+
+void loadDataset(const char *filename, std::vector<std::string> &dataset) {
+    // Load the values from the file into a vector.
+    std::ifstream dataset_file(filename);
+
+    if (dataset_file.is_open()) {
+        std::string value;
+        while (dataset_file >> value) {
+            dataset.push_back(value);
+        }
+    } else {
+        // Failed to load file.
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        exit(1);
+    }
+}
+
+// Set up for tree, a compare function
+inline int stringCompare(const std::string &a, const std::string &b) {
+    return a.compare(b);
+}
+
+template <class Tree>
+void churnSlice(Tree &tree, size_t rounds, const std::string slice[], size_t length) {
+    for (size_t round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < length; i++) {
+            if (!tree.insert(slice[i])) throw std::logic_error("tree manipulation failed");
+        }
+        for (size_t i = 0; i < length; i++) {
+            if (!tree.remove(slice[i])) throw std::logic_error("tree manipulation failed");
+        }
+    }
+}
+
+template <class Tree>
+void concurrentChurntest(Tree &tree, std::vector<std::string> &dataset, unsigned max_threads) {
+    // Churn half the dataset, with the other half loaded throughout
+    const size_t split_index = dataset.size() / 2;
+    const size_t rounds = 4;
+    assert(tree.empty());
+
+    for (size_t i = split_index; i < dataset.size(); i++) {
+        tree.insert(dataset[i]);
+    }
+    // Every slice is removed again, so only the loaded half remains after each run
+    const std::set<std::string> reference(dataset.begin() + split_index, dataset.end());
+
+    // Powers of two, then the core count itself
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    for (unsigned threads : thread_counts) {
+        const size_t length = split_index / threads;
+        std::vector<std::thread> workers;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back(churnSlice<Tree>, std::ref(tree), rounds, &dataset[t * length], length);
+        }
+        for (std::thread &worker : workers) worker.join();
+        auto stop = std::chrono::high_resolution_clock::now();
+
+        if (!std::equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end()))
+            throw std::logic_error("tree contents differ from the reference");
+
+        // The same total work at every thread count
+        const double operations = 2.0 * rounds * threads * length;
+        const double duration = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+        std::cout << threads << " threads\t: "
+                  << duration / 1000000.0 // million nanoseconds in a millisecond
+                  << " ms, "
+                  << operations / duration * 1000.0 // thousand operations per microsecond is millions per second
+                  << " Mops/s" << std::endl;
+    }
+
+    tree.clear();
+}
+
+int main(int argc, char *argv[]) {
+    // Setup random generator
+    auto seed = std::chrono::system_clock::now().time_since_epoch().count();
+
+    std::default_random_engine generator = std::default_random_engine(seed);
+
+    std::cout << "Loading Dataset" << std::endl;
+
+    char *filename;
+    if (argc == 2 || argc == 3) {
+        // Load from command line
+        filename = argv[1];
+    } else {
+        // No file specified
+        std::cerr << "No database specified." << std::endl;
+        exit(1);
+    }
+
+    std::vector<std::string> dataset;
+    loadDataset(filename, dataset);
+
+    // Deduplicate, then randomly shuffle the dataset for fair randomness.
+    std::sort(dataset.begin(), dataset.end());
+    dataset.erase(std::unique(dataset.begin(), dataset.end()), dataset.end());
+    std::shuffle(dataset.begin(), dataset.end(), generator);
+    dataset.shrink_to_fit();
+
+    std::cout << "Loaded " << dataset.size() << " data points into dataset." << std::endl;
+
+    // Up to the core count, unless given
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc == 3) max_threads = std::max(1, atoi(argv[2]));
+    std::cout.setf(std::ios::fixed);
+    std::cout.precision(4);
+
+    std::cout << "Locked AVL Tree Tests" << std::endl;
+    LockedTree<AVLTree<std::string>> avl_tree(stringCompare);
+    concurrentChurntest(avl_tree, dataset, max_threads);
+    std::cout << std::endl;
+
+    std::cout << "Concurrent Skip List Tests" << std::endl;
+    ConcurrentSkipList<std::string> skip_list(stringCompare);
+    concurrentChurntest(skip_list, dataset, max_threads);
+    std::cout << std::endl;
+
+    std::cout << "Concurrent AVL Tree Tests" << std::endl;
+    ConcurrentAVLTree<std::string> concurrent_avl_tree(stringCompare);
+    concurrentChurntest(concurrent_avl_tree, dataset, max_threads);
+    std::cout << std::endl;
+
+    std::cout << "Sharded AVL Tree Tests" << std::endl;
+    ShardedTree<AVLTree<std::string>> sharded_avl_tree(stringCompare);
+    concurrentChurntest(sharded_avl_tree, dataset, max_threads);
+    std::cout << std::endl;
+
+    std::cout << "Flat Combining AVL Tree Tests" << std::endl;
+    FlatCombiningTree<AVLTree<std::string>> flat_combining_avl_tree(stringCompare);
+    concurrentChurntest(flat_combining_avl_tree, dataset, max_threads);
+    std::cout << std::endl;
+}
@@ -7,6 +7,7 @@
 //#define BINARYTREE_SANITY_CHECK
 //#define BINARYTREE_EXTENDED_SANITY_CHECK
 #include "AVLTree/AVLTree.h"
+#include "BPlusTree/BPlusTree.h"
 
 void loadDataset(const char *filename, std::vector<std::string> &dataset) {
     // Load the values from the file into a vector.
@@ -54,6 +55,28 @@ long removeAll(Tree &tree, typename Tree::value_type elements[], size_t size) {
     return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
 }
 
+template <class Tree>
+void speedtest(Tree &tree, typename Tree::value_type groupA[], size_t groupA_size,
+               typename Tree::value_type groupB[], size_t groupB_size) {
+    std::cout << "Insert Group A: ";
+    auto duration = insertAll(tree, groupA, groupA_size);
+    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
+
+    std::cout << "Insert Group B: ";
+    duration = insertAll(tree, groupB, groupB_size);
+    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
+
+    std::cout << "Remove Group A: ";
+    duration = removeAll(tree, groupA, groupA_size);
+    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
+
+    std::cout << "Remove Group B: ";
+    duration = removeAll(tree, groupB, groupB_size);
+    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
+
+    assert(tree.empty());
+}
+
 int main(int argc, char *argv[]) {
     std::cout << "Loading Database" << std::endl;
 
@@ -90,26 +113,15 @@ int main(int argc, char *argv[]) {
     std::cout << "Loaded " << groupA_size << " data points into Group A" << std::endl;
     std::cout << "Loaded " << groupB_size << " data points into Group B" << std::endl;
 
-    AVLTree<std::string> avlTree = AVLTree<std::string>();
-
     std::cout.setf(std::ios::fixed);
     std::cout.precision(4);
 
-    std::cout << "Insert Group A: ";
-    auto duration = insertAll(avlTree, groupA, groupA_size);
-    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
-
-    std::cout << "Insert Group B: ";
-    duration = insertAll(avlTree, groupB, groupB_size);
-    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
-
-    std::cout << "Remove Group A: ";
-    duration = removeAll(avlTree, groupA, groupA_size);
-    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
-
-    std::cout << "Remove Group B: ";
-    duration = removeAll(avlTree, groupB, groupB_size);
-    std::cout << (double) duration / 1000000.0 << "ms" << std::endl;
+    std::cout << "AVL Tree Tests" << std::endl;
+    AVLTree<std::string> avlTree = AVLTree<std::string>();
+    speedtest(avlTree, groupA, groupA_size, groupB, groupB_size);
+    std::cout << std::endl;
 
-    assert(avlTree.empty());
+    std::cout << "B+ Tree Tests" << std::endl;
+    BPlusTree<std::string> bPlusTree = BPlusTree<std::string>();
+    speedtest(bPlusTree, groupA, groupA_size, groupB, groupB_size);
 }
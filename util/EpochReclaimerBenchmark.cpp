@@ -0,0 +1,93 @@
+/*
+ * Performance Benchmark for EpochReclaimer, the cost of retiring a node against deleting it outright
+ *
+ * g++ EpochReclaimerBenchmark.cpp -Wall -pedantic -std=c++14 -mtune=native -march=native -O3 -DNDEBUG -lbenchmark -lpthread -o EpochReclaimerBenchmark
+ *
+ * Concepts taken from https://github.com/google/benchmark/blob/master/test/benchmark_test.cc
+ */
+
+// Google benchmark, https://github.com/google/benchmark
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#define TESTS ThreadRange(1, 8)->UseRealTime()
+
+#include "epoch_reclaimer.h"
+#include "../AVLTree/AVLTree.h"
+
+// About the size of a tree node
+struct Payload {
+    Payload *left = nullptr;
+    Payload *right = nullptr;
+    int64_t value = 0;
+};
+
+// An AVLTreeNode retired through EpochReclaimer by the tree
+struct ReclaimedAVLTreeNode: public ReclaimedNode {
+    using value_type = int;
+
+    explicit ReclaimedAVLTreeNode(const int &value): left(nullptr), right(nullptr), height(1), value(value) {}
+
+    ReclaimedAVLTreeNode *left;
+    ReclaimedAVLTreeNode *right;
+    uint8_t height;
+    int value;
+};
+
+static void BM_Delete(benchmark::State &state) {
+    for (auto _ : state) {
+        Payload *payload = new Payload();
+        benchmark::DoNotOptimize(payload);
+        delete payload;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Delete)->TESTS;
+
+static void BM_Retire(benchmark::State &state) {
+    for (auto _ : state) {
+        Payload *payload = new Payload();
+        benchmark::DoNotOptimize(payload);
+        EpochReclaimer::retire(payload);
+    }
+    state.SetItemsProcessed(state.iterations());
+    EpochReclaimer::synchronize();
+}
+BENCHMARK(BM_Retire)->TESTS;
+
+// As the concurrent trees do, one guard per operation
+static void BM_GuardedRetire(benchmark::State &state) {
+    for (auto _ : state) {
+        EpochReclaimer::Guard guard;
+        Payload *payload = new Payload();
+        benchmark::DoNotOptimize(payload);
+        EpochReclaimer::retire(payload);
+    }
+    state.SetItemsProcessed(state.iterations());
+    EpochReclaimer::synchronize();
+}
+BENCHMARK(BM_GuardedRetire)->TESTS;
+
+// A tree of its own per thread, removing and reinserting values, each removal freeing one node
+template <class Node>
+static void BM_AVLTreeChurn(benchmark::State &state) {
+    AVLTree<int, Node> tree;
+    const int range = state.range(0);
+    for (int i = 0; i < range; i++) tree.insert(i);
+
+    int i = 0;
+    for (auto _ : state) {
+        tree.remove(i);
+        tree.insert(i);
+        if (++i == range) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    tree.clear();
+    EpochReclaimer::synchronize();
+}
+BENCHMARK_TEMPLATE(BM_AVLTreeChurn, AVLTreeNode<int>)->Arg(1 << 10)->TESTS;
+BENCHMARK_TEMPLATE(BM_AVLTreeChurn, ReclaimedAVLTreeNode)->Arg(1 << 10)->TESTS;
+
+BENCHMARK_MAIN();
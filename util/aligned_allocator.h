@@ -0,0 +1,41 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+#include <new>
+#include <cstdlib>
+
+/**
+ * An allocator for standard containers that aligns every allocation.
+ *
+ * Used where whole cache lines are loaded at once, e.g. by aligned SIMD loads.
+ * @tparam T type of value to be held in the container
+ * @tparam Alignment alignment in bytes, a power of two and a multiple of sizeof(void*)
+ */
+template <class T, size_t Alignment = 64>
+struct aligned_allocator {
+    using value_type = T;
+
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() noexcept = default;
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept {}
+
+    T* allocate(size_t n) {
+        void *memory = nullptr;
+        if (posix_memalign(&memory, Alignment, n * sizeof(T)) != 0) throw std::bad_alloc();
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T *memory, size_t) noexcept {
+        free(memory);
+    }
+
+    template <class U>
+    bool operator==(const aligned_allocator<U, Alignment> &) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const aligned_allocator<U, Alignment> &) const noexcept { return false; }
+};
+#endif //ALIGNED_ALLOCATOR_H
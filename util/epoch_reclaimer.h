@@ -0,0 +1,270 @@
+#ifndef EPOCH_RECLAIMER_H
+#define EPOCH_RECLAIMER_H
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "aligned_allocator.h"
+#include "clearable_queue.h"
+#include "clearable_stack.h"
+#include "node_deallocator.h"
+
+/**
+ * Epoch based reclamation, for freeing nodes that other threads may still be reading.
+ *
+ * A thread holds a Guard while it reads shared nodes. A node that has been unlinked is passed to
+ * retire() instead of being deleted, and is deleted once every thread that could have seen it has
+ * dropped its guard. Threads announce the global epoch when they take a guard. The epoch only
+ * advances once every guarded thread has announced the current one, so anything retired at epoch e
+ * is unreachable by the time the epoch reaches e + 2.
+ *
+ * Each thread gathers what it retires into batches of batch_size. Only sealing a full batch costs a
+ * fence, tagging it with the epoch read after the fence, which is no earlier than when any node in it
+ * was unlinked. Sealed batches wait in the thread's limbo list, oldest first, and are freed whole.
+ * retire() itself is just an append.
+ *
+ * Guards are cheap, and nest. Every thread shares the one process wide domain.
+ * A thread that exits frees what it can, and leaves the rest to the next thread to take its record, or to exit.
+ */
+class EpochReclaimer {
+  public:
+    // Nodes retired per batch, and so per attempt to advance the epoch and free what has become safe
+    static constexpr size_t batch_size = 64;
+
+    /**
+     * Pins the calling thread to the current epoch, while alive.
+     * Must be destroyed on the thread that made it.
+     */
+    class Guard {
+      public:
+        Guard() noexcept {pin();}
+        Guard(const Guard &) noexcept {pin();}
+        Guard& operator=(const Guard &) noexcept {return *this;}
+        ~Guard() {unpin();}
+    };
+
+    // Delete object once no guarded thread can still see it. object must already be unreachable.
+    template <class U>
+    static void retire(U *object) {
+        retire(object, [](void *retired) {delete static_cast<U*>(retired);});
+    }
+
+    static void retire(void *object, void (*deleter)(void *)) {
+        Record &record = local();
+        record.pending.push_back({object, deleter});
+
+        if (record.pending.size() >= batch_size) {
+            seal(record);
+            tryAdvance();
+            collect(record);
+        }
+    }
+
+    // Advance the epoch if possible, and free whatever this thread retired that is now safe
+    static void collect() {
+        Record &record = local();
+        seal(record);
+        tryAdvance();
+        collect(record);
+    }
+
+    /**
+     * Free everything this thread has retired, waiting for guarded threads to move on.
+     * Must not be called while this thread holds a guard.
+     */
+    static void synchronize() {
+        Record &record = local();
+        seal(record);
+        while (!record.limbo.empty()) {
+            tryAdvance();
+            collect(record);
+            if (!record.limbo.empty()) std::this_thread::yield();
+        }
+    }
+
+    // Current global epoch, for tests
+    static uint64_t epoch() noexcept {
+        return domain().epoch.load(std::memory_order_relaxed);
+    }
+
+  protected:
+    struct Retired {
+        void *object;
+        void (*deleter)(void *);
+    };
+
+    // A sealed batch, retired no later than epoch
+    struct Bag {
+        uint64_t epoch;
+        std::vector<Retired> objects;
+
+        void free() noexcept {
+            for (Retired &retired : objects) retired.deleter(retired.object);
+            objects.clear();
+        }
+    };
+
+    // Emptied batches kept per thread for reuse, so steady retiring allocates nothing
+    static constexpr size_t spare_batches = 4;
+
+    // Per thread state. Records are never freed, a thread that exits leaves its record for reuse.
+    struct alignas(64) Record {
+        // (epoch << 1) | 1 while pinned, 0 while not
+        std::atomic<uint64_t> state{0};
+        std::atomic<bool> in_use{true};
+        Record *next = nullptr;
+
+        size_t nesting = 0;
+        // Set while freeing, so a deleter that retires more does not free the bag being freed
+        bool collecting = false;
+
+        // Retired since the last batch was sealed
+        std::vector<Retired> pending;
+        // Sealed batches, in the order sealed, so oldest epoch first
+        clearable_queue<Bag> limbo;
+        clearable_stack<std::vector<Retired>> spare;
+    };
+
+    struct Domain {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<Record*> records{nullptr};
+
+        ~Domain() {
+            // Every thread has exited, so everything retired is unreachable
+            Record *record = records.load(std::memory_order_acquire);
+            while (record != nullptr) {
+                Record *next = record->next;
+                seal(*record);
+                for (; !record->limbo.empty(); record->limbo.pop()) record->limbo.front().free();
+                record->~Record();
+                aligned_allocator<Record>().deallocate(record, 1);
+                record = next;
+            }
+        }
+    };
+
+    static Domain& domain() noexcept {
+        static Domain domain;
+        return domain;
+    }
+
+    // Claims a record for the calling thread, for as long as it lives
+    struct Handle {
+        Record *record;
+
+        Handle(): record(acquire()) {}
+        ~Handle() {
+            // Free what is already safe, the rest waits for the record's next owner
+            seal(*record);
+            tryAdvance();
+            collect(*record);
+            record->state.store(0, std::memory_order_release);
+            record->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    static Record& local() {
+        thread_local Handle handle;
+        return *handle.record;
+    }
+
+    static Record* acquire() {
+        Domain &d = domain();
+        for (Record *record = d.records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+            bool in_use = false;
+            if (!record->in_use.load(std::memory_order_relaxed) &&
+                record->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                return record;
+        }
+
+        // Kept on their own cache lines, as every pin writes to one
+        Record *record = new (aligned_allocator<Record>().allocate(1)) Record();
+        record->pending.reserve(batch_size);
+        record->next = d.records.load(std::memory_order_relaxed);
+        while (!d.records.compare_exchange_weak(record->next, record, std::memory_order_release)) {}
+        return record;
+    }
+
+    static void pin() noexcept {
+        Record &record = local();
+        if (record.nesting++ > 0) return;
+
+        const uint64_t epoch = domain().epoch.load(std::memory_order_relaxed);
+        // Release, so reads made under an earlier guard happen before a reclaimer sees this one
+        record.state.store(epoch << 1 | 1, std::memory_order_release);
+        // Announce the epoch before reading any shared node
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    static void unpin() noexcept {
+        Record &record = local();
+        if (--record.nesting > 0) return;
+        record.state.store(0, std::memory_order_release);
+    }
+
+    // Move the pending nodes into the limbo list, tagged with the current epoch
+    static void seal(Record &record) {
+        if (record.pending.empty()) return;
+
+        // The fence orders every unlink in the batch before reading the epoch to tag it with
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        record.limbo.push({domain().epoch.load(std::memory_order_relaxed), std::move(record.pending)});
+
+        if (!record.spare.empty()) {
+            record.pending = std::move(record.spare.top());
+            record.spare.pop();
+        } else {
+            record.pending = std::vector<Retired>();
+            record.pending.reserve(batch_size);
+        }
+    }
+
+    // Advance the epoch if every pinned thread has announced the current one
+    static void tryAdvance() noexcept {
+        Domain &d = domain();
+        uint64_t epoch = d.epoch.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        for (Record *record = d.records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+            const uint64_t state = record->state.load(std::memory_order_acquire);
+            if ((state & 1) && (state >> 1) != epoch) return;
+        }
+
+        d.epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    // Free the batches at the front of the limbo list that no guarded thread can still see
+    static void collect(Record &record) {
+        if (record.collecting) return;
+        record.collecting = true;
+
+        const uint64_t epoch = domain().epoch.load(std::memory_order_acquire);
+        while (!record.limbo.empty() && record.limbo.front().epoch + 2 <= epoch) {
+            Bag &bag = record.limbo.front();
+            bag.free();
+            if (record.spare.size() < spare_batches) record.spare.push(std::move(bag.objects));
+            record.limbo.pop();
+        }
+
+        record.collecting = false;
+    }
+};
+
+/**
+ * Base for nodes that a BinaryTree retires through EpochReclaimer rather than deleting. See util/node_deallocator.h.
+ *
+ * This does not make the tree safe to read alongside a writer: rotations relink nodes through plain pointer writes,
+ * so readers must still be excluded from writers. Deferring the free only matters once nodes are reachable from
+ * somewhere the writer does not change, such as a published or copy-on-write version of the tree, whose readers
+ * hold an EpochReclaimer::Guard.
+ */
+struct ReclaimedNode {};
+
+template <class Node>
+struct NodeDeallocator<Node, typename std::enable_if<std::is_base_of<ReclaimedNode, Node>::value>::type> {
+    static void deallocate(Node *node) noexcept { EpochReclaimer::retire(node); }
+};
+#endif //EPOCH_RECLAIMER_H
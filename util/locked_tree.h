@@ -0,0 +1,59 @@
+#ifndef LOCKED_TREE_H
+#define LOCKED_TREE_H
+#include <mutex>
+
+/**
+ * Any of the trees behind one mutex, the simplest way to share a tree between threads.
+ *
+ * Every operation takes the lock, even a lookup, so at most one thread is ever in the tree. This is the baseline
+ * the concurrent structures are measured against, in concurrentchurntest and the benchmarks.
+ * @tparam Tree the tree to share, e.g. AVLTree<int>
+ */
+template <class Tree>
+class LockedTree {
+  public:
+    using value_type = typename Tree::value_type;
+
+    LockedTree() = default;
+
+    explicit LockedTree(int (*compare)(const value_type &a, const value_type &b)): tree(compare) {}
+
+    bool contains(const value_type &value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tree.contains(value);
+    }
+
+    bool insert(const value_type &value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tree.insert(value);
+    }
+
+    bool remove(const value_type &value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tree.remove(value);
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        tree.clear();
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tree.empty();
+    }
+
+    // Iterating takes no lock, so the tree must be quiescent
+    typename Tree::inorder_iterator inorder_begin() const {
+        return tree.inorder_begin();
+    }
+
+    typename Tree::inorder_iterator inorder_end() const {
+        return tree.inorder_end();
+    }
+
+  protected:
+    std::mutex mutex;
+    Tree tree;
+};
+#endif //LOCKED_TREE_H
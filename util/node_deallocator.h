@@ -0,0 +1,14 @@
+#ifndef NODE_DEALLOCATOR_H
+#define NODE_DEALLOCATOR_H
+
+/**
+ * How a tree frees a node it has unlinked, BinaryTree::destroyNode() goes through this for every node.
+ *
+ * Nodes are deleted right away unless the node type picks otherwise, by deriving from ReclaimedNode
+ * (util/epoch_reclaimer.h) or by specializing this for itself.
+ */
+template <class Node, class = void>
+struct NodeDeallocator {
+    static void deallocate(Node *node) noexcept { delete node; }
+};
+#endif //NODE_DEALLOCATOR_H
@@ -0,0 +1,65 @@
+#ifndef SHARED_NODE_H
+#define SHARED_NODE_H
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Base for nodes that trees share by copy-on-write, e.g. AVLTree<T, SharedAVLTreeNode<T>>.
+ *
+ * Copying such a tree shares its root, in O(1). A node is copied, and its children shared, the first time a tree
+ * changes it while another tree also holds it, so only the paths actually written are ever duplicated.
+ * Only AVLTree and SplayTree take ownership before every change, other trees must keep plain nodes.
+ *
+ * The count is atomic, so trees sharing nodes can be used, copied and destroyed from different threads.
+ */
+struct SharedNode {
+    // Number of parents and trees holding the node
+    mutable std::atomic<uint32_t> references;
+
+    SharedNode() noexcept: references(1) {}
+
+    // A copy is a new node, held only by whoever made it
+    SharedNode(const SharedNode &) noexcept: references(1) {}
+    SharedNode& operator=(const SharedNode &) noexcept { return *this; }
+};
+
+/**
+ * Reference counting for nodes, that does nothing for nodes not derived from SharedNode.
+ * Plain nodes are never shared, and every holder is the last.
+ */
+template <class Node, bool = std::is_base_of<SharedNode, Node>::value>
+struct SharedNodeTraits {
+    static constexpr bool shared = false;
+
+    static Node* retain(const Node *node) noexcept { return const_cast<Node*>(node); }
+    static bool release(const Node *) noexcept { return true; }
+    static bool isShared(const Node *) noexcept { return false; }
+};
+
+template <class Node>
+struct SharedNodeTraits<Node, true> {
+    static constexpr bool shared = true;
+
+    // Nodes are never changed while shared, so holding one through a const tree is fine
+    static Node* retain(const Node *node) noexcept {
+        if (node != nullptr) node->references.fetch_add(1, std::memory_order_relaxed);
+        return const_cast<Node*>(node);
+    }
+
+    // Drop a reference, true if it was the last one and the node must be freed
+    static bool release(const Node *node) noexcept {
+        return node->references.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    static bool isShared(const Node *node) noexcept {
+        return node->references.load(std::memory_order_acquire) > 1;
+    }
+};
+
+template <class Node, bool Shared>
+constexpr bool SharedNodeTraits<Node, Shared>::shared;
+
+template <class Node>
+constexpr bool SharedNodeTraits<Node, true>::shared;
+#endif //SHARED_NODE_H
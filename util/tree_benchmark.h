@@ -0,0 +1,198 @@
+/*
+ * Benchmarks shared by the balanced trees, run on any tree of ints, each benchmark file registering its own tree.
+ *
+ *     BENCHMARK_TEMPLATE(BM_Insert, RedBlackTree<int>)->TESTS;
+ *
+ * BM_ReadMostly and BM_Churn share one tree between all the benchmark's threads, for the structures made to be
+ * shared, with LockedTree as the baseline.
+ *
+ *     BENCHMARK_TEMPLATE(BM_Churn, LockedTree<AVLTree<int>>)->THREADED_TESTS;
+ *
+ * Include after benchmark/benchmark.h, and after defining BINARYTREE_SANITY_CHECK if it is wanted.
+ */
+#ifndef TREE_BENCHMARK_H
+#define TREE_BENCHMARK_H
+
+#include <random>
+#include <vector>
+#include <cstdlib>
+#include "locked_tree.h"
+
+// Default test parameters, the tree size and the operations timed on it
+#define TESTS Ranges({{1 << 10, 8 << 10}, {128, 512}})->Complexity()->Threads(1)->ThreadPerCpu()
+// Each tree is only built once
+#define CHURN_TESTS RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Complexity()
+// A range small enough for the threads to fight over the same values and a large one, at 1 to 64 threads
+#define THREADED_TESTS Arg(1 << 10)->Arg(1 << 16)->ThreadRange(1, 64)->UseRealTime()
+
+inline int RandomNumber() {
+    return rand();
+}
+
+template <class Tree>
+inline void ConstructRandomTree(Tree &tree, size_t size) {
+#ifdef BINARYTREE_SANITY_CHECK
+    tree.sanityCheck();
+#endif
+    Tree new_tree;
+    for (size_t i = 0; i < size; i++)
+        new_tree.insert(RandomNumber());
+    tree = new_tree;
+#ifdef BINARYTREE_SANITY_CHECK
+    tree.sanityCheck();
+#endif
+}
+
+template <class Tree>
+static void BM_Insert(benchmark::State &state) {
+    Tree tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.insert(RandomNumber());
+        benchmark::DoNotOptimize(tree);
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+template <class Tree>
+static void BM_Remove(benchmark::State &state) {
+    Tree tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.remove(RandomNumber());
+        benchmark::DoNotOptimize(tree);
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+template <class Tree>
+static void BM_Contains(benchmark::State &state) {
+    Tree tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConstructRandomTree(tree, state.range(0));
+        state.ResumeTiming();
+        for (int j = 0; j < state.range(1); j++)
+            tree.contains(RandomNumber());
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+/*
+ * Replace removes values known to be in the tree, so every remove rebalances.
+ * Run against AVLTree to compare the cost of the rotations.
+ */
+template <class Tree>
+static void BM_Replace(benchmark::State &state) {
+    Tree tree;
+    std::vector<int> values;
+    while (tree.size() < (size_t) state.range(0)) {
+        const int value = RandomNumber();
+        if (tree.insert(value)) values.push_back(value);
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        // Replace the oldest value with a new one
+        tree.remove(values[next]);
+        do {
+            values[next] = RandomNumber();
+        } while (!tree.insert(values[next]));
+        next = (next + 1) % values.size();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+// Cut the tree in two at a random value and put it back together, for the trees with split and join
+template <class Tree>
+static void BM_SplitJoin(benchmark::State &state) {
+    Tree tree, greater;
+    while (tree.size() < (size_t) state.range(0))
+        tree.insert(RandomNumber());
+    for (auto _ : state) {
+        tree.split(RandomNumber(), greater);
+        tree.join(greater);
+    }
+    state.SetComplexityN(state.range(0));
+}
+// Values drawn evenly from [0, range), for the threaded benchmarks
+class UniformValues {
+  public:
+    explicit UniformValues(int range): range(range) {}
+
+    int operator()(std::minstd_rand &generator) const {
+        return generator() % range;
+    }
+
+  private:
+    int range;
+};
+
+/**
+ * Every thread makes 20 lookups for each insert or remove on one shared tree, half full.
+ * Values picks the values from the range, e.g. to skew them.
+ */
+template <class Tree, class Values = UniformValues>
+static void BM_ReadMostly(benchmark::State &state) {
+    // Shared by every thread, set up and torn down by the first
+    static Tree *tree;
+    static Values *values;
+    const int range = state.range(0);
+    if (state.thread_index() == 0) {
+        tree = new Tree();
+        values = new Values(range);
+        // Half the values present
+        for (int i = 0; i < range; i += 2) tree->insert(i);
+    }
+
+    std::minstd_rand generator(state.thread_index() + 1);
+    size_t i = 0;
+    for (auto _ : state) {
+        const int value = (*values)(generator);
+        if (++i % 21 != 0) {
+            benchmark::DoNotOptimize(tree->contains(value));
+        } else if (i % 2) {
+            tree->insert(value);
+        } else {
+            tree->remove(value);
+        }
+    }
+
+    if (state.thread_index() == 0) {
+        delete tree;
+        delete values;
+    }
+}
+
+// Every thread inserts and removes on one shared tree, half full
+template <class Tree, class Values = UniformValues>
+static void BM_Churn(benchmark::State &state) {
+    static Tree *tree;
+    static Values *values;
+    const int range = state.range(0);
+    if (state.thread_index() == 0) {
+        tree = new Tree();
+        values = new Values(range);
+        for (int i = 0; i < range; i += 2) tree->insert(i);
+    }
+
+    std::minstd_rand generator(state.thread_index() + 1);
+    for (auto _ : state) {
+        tree->insert((*values)(generator));
+        tree->remove((*values)(generator));
+    }
+
+    if (state.thread_index() == 0) {
+        delete tree;
+        delete values;
+    }
+}
+#endif //TREE_BENCHMARK_H
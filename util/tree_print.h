@@ -0,0 +1,89 @@
+#ifndef TREE_PRINT_H
+#define TREE_PRINT_H
+#include <iomanip>
+#include <iostream>
+
+/**
+ * Print a single value of a tree, surrounded by padding.
+ *
+ * @param value
+ * The value to print. If null, width fill characters are printed instead.
+ */
+template <class T>
+void print_tree_value(const T *value, size_t padding_left, size_t padding_right,
+                      size_t width, char background, std::ostream &ostream) {
+    // Print left
+    for (size_t i = 0; i < padding_left; ++i) ostream << background;
+
+    // Print object
+    ostream << std::setw((int) width);
+    if (value != nullptr)
+        ostream << *value;
+    else
+        ostream << "";
+
+    // Print right
+    for (size_t i = 0; i < padding_right; ++i) ostream << background;
+}
+
+/**
+ * Print the layout of a binary tree, one level per line.
+ *
+ * Shared by the trees so they all print identically, regardless of how they store their nodes.
+ * See BinaryTree::printTreeWithSpacing() for the meaning of the formatting parameters.
+ *
+ * @param next
+ * Called once for every position in the first tree_height levels, in level order, left to right.
+ * Returns a pointer to the value at that position, or nullptr if the position is empty.
+ *
+ * @param tree_height
+ * Number of levels to take from next. Remaining levels, up to height, are printed empty.
+ */
+template <class T, class Next>
+void print_tree_levels(Next next, size_t tree_height, size_t spacing, size_t width, size_t height,
+                       char fill, bool biasLeft, bool trailing, char background, std::ostream &ostream) {
+    // Nothing to lay out
+    if (height == 0) return;
+
+    // Set the fill character
+    ostream << std::setfill(fill);
+
+    // First level is its own special case
+    // Special in it is both the first and last value on the level
+    // Scoped to prevent name collisions
+    {
+        const size_t base_width = ((width + spacing) << (height - 1)) - width;
+        const size_t padding_left  = (base_width + !biasLeft - spacing) / 2;
+        const size_t padding_right = trailing ? (base_width + biasLeft - spacing) / 2: 0;
+        const T *value = tree_height > 0 ? next() : nullptr;
+        print_tree_value(value, padding_left, padding_right, width, background, ostream);
+        ostream << std::endl;
+    }
+
+    for (size_t level = 1; level < height; level++) {
+        // Past the end of the tree, every value is null
+        const bool in_tree = level < tree_height;
+
+        // Calculate the width of the base of this subtree.
+        // Width, minus the width of the single object that will be printed.
+        const size_t base_width = ((width + spacing) << (height - level - 1)) - width;
+        const size_t base_width_left = base_width + !biasLeft;
+        const size_t base_width_right = base_width + biasLeft;
+
+        // Special case for the first value
+        print_tree_value<T>(in_tree ? next() : nullptr, (base_width_left - spacing) / 2, base_width_right / 2,
+                            width, background, ostream);
+
+        for (size_t position = 1; position < ((1U << level) - 1U); position++) {
+            print_tree_value<T>(in_tree ? next() : nullptr, base_width_left / 2, base_width_right / 2,
+                                width, background, ostream);
+        }
+
+        // Special case for final in level
+        const size_t padding_right = trailing ? (base_width_right - spacing) / 2: 0;
+        print_tree_value<T>(in_tree ? next() : nullptr, base_width_left / 2, padding_right,
+                            width, background, ostream);
+        ostream << std::endl;
+    }
+}
+#endif //TREE_PRINT_H
@@ -0,0 +1,257 @@
+/*
+ * Checks shared by the test programs, for any structure holding a set of ints.
+ *
+ * Each check builds its own structure from the constructor arguments it is given, and only uses what every set
+ * here offers: insert, remove, contains, size, empty, clear, copying, inorder iteration and sanityCheck().
+ * check_ends() and check_reverse() are for the structures that also have both ends and reverse iterators, and
+ * check_bounded_height() for those that also have getHeight().
+ * test_set() runs the rest, as for any BinaryTree, leaving each test program to check its own invariants.
+ * check_concurrent_churn() and check_concurrent_pops() are for the structures shared between threads, and need the
+ * test program linked with the thread library.
+ *
+ * Test programs define BINARYTREE_SANITY_CHECK before including this.
+ */
+#ifndef TREE_TEST_H
+#define TREE_TEST_H
+
+#include <set>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+
+// Compares without the overflow of a - b
+inline int compare(const int &a, const int &b) {
+    if (a < b)  return -1;
+    if (a == b) return  0;
+    else        return  1;
+}
+
+template <class T, class It>
+inline bool iteratorEquals(It first, It last, std::initializer_list<T> init_values) {
+    return std::equal(first, last, init_values.begin(), init_values.end());
+}
+
+template <class Tree, class... Args>
+bool check_empty(const Args &...args) {
+    Tree tree(args...);
+    bool passed = tree.empty() && tree.size() == 0;
+    passed &= tree.inorder_begin() == tree.inorder_end();
+    passed &= !tree.contains(0) && !tree.remove(0);
+    tree.sanityCheck();
+    return passed;
+}
+
+template <class Tree, class... Args>
+bool check_insert_remove(const Args &...args) {
+    Tree tree(args...);
+    bool passed = true;
+    for (int i : {5, 3, 8, 1, 4, 7, 9, 2, 6}) passed &= tree.insert(i);
+    passed &= !tree.insert(5) && tree.size() == 9;
+    passed &= tree.contains(1) && tree.contains(9) && !tree.contains(0) && !tree.contains(10);
+    passed &= iteratorEquals(tree.inorder_begin(), tree.inorder_end(), {1, 2, 3, 4, 5, 6, 7, 8, 9});
+    tree.sanityCheck();
+
+    passed &= tree.remove(5) && !tree.remove(5);
+    passed &= tree.size() == 8 && !tree.contains(5);
+    tree.sanityCheck();
+
+    // Copies hold the same values, and change apart from the original
+    Tree copy = tree;
+    passed &= std::equal(copy.inorder_begin(), copy.inorder_end(), tree.inorder_begin(), tree.inorder_end());
+    passed &= copy.insert(100) && !tree.contains(100);
+    copy.sanityCheck();
+
+    tree.clear();
+    passed &= tree.empty() && tree.size() == 0 && tree.inorder_begin() == tree.inorder_end();
+    passed &= copy.size() == 9;
+    tree.sanityCheck();
+    return passed;
+}
+
+template <class Tree, class... Args>
+bool check_ends(const Args &...args) {
+    Tree tree(args...);
+    bool passed = true;
+
+    // Nothing valid to return from an empty set
+    try {
+        tree.getMostLeft();
+        passed = false;
+    } catch (std::out_of_range &) {}
+    try {
+        tree.getMostRight();
+        passed = false;
+    } catch (std::out_of_range &) {}
+    try {
+        tree.popMostLeft();
+        passed = false;
+    } catch (std::out_of_range &) {}
+    try {
+        tree.popMostRight();
+        passed = false;
+    } catch (std::out_of_range &) {}
+
+    for (int i : {5, 3, 8, 1, 4, 7, 9, 2, 6}) tree.insert(i);
+    passed &= tree.getMostLeft() == 1 && tree.getMostRight() == 9;
+    tree.sanityCheck();
+
+    // Draining from both ends gives back every value in order
+    for (int low = 1, high = 9; low <= high; low++, high--) {
+        passed &= tree.popMostLeft() == low;
+        if (low < high) passed &= tree.popMostRight() == high;
+        passed &= tree.size() == size_t(std::max(high - low - 1, 0));
+        tree.sanityCheck();
+    }
+    passed &= tree.empty();
+    return passed;
+}
+
+template <class Tree, class... Args>
+bool check_reverse(const Args &...args) {
+    Tree tree(args...);
+    bool passed = tree.reverse_inorder_begin() == tree.reverse_inorder_end();
+    for (int i : {5, 3, 8, 1, 4, 7, 9, 2, 6}) tree.insert(i);
+    passed &= iteratorEquals(tree.reverse_inorder_begin(), tree.reverse_inorder_end(), {9, 8, 7, 6, 5, 4, 3, 2, 1});
+    return passed;
+}
+
+/**
+ * Sequential inserts and removes, the worst case for an unbalanced tree, for a BinaryTree.
+ * bound gives the greatest height the tree allows for a size.
+ */
+template <class Tree, class... Args>
+bool check_bounded_height(size_t (*bound)(size_t size), const Args &...args) {
+    Tree tree(args...);
+    bool passed = true;
+    for (int i = 0; i < 10000; i++) tree.insert(i);
+    for (int i = -1; i >= -10000; i--) tree.insert(i);
+    tree.sanityCheck();
+    passed &= tree.size() == 20000 && tree.getHeight() <= bound(tree.size());
+
+    for (int i = -10000; i < 9990; i++) tree.remove(i);
+    tree.sanityCheck();
+    passed &= tree.size() == 10 && tree.getHeight() <= bound(tree.size());
+
+    while (!tree.empty()) tree.popMostRight();
+    passed &= tree.getHeight() == 0;
+    tree.sanityCheck();
+    return passed;
+}
+
+// Random inserts, removes and lookups against std::set
+template <class Tree, class... Args>
+bool check_churn(const Args &...args) {
+    Tree tree(args...);
+    std::set<int> reference;
+    bool passed = true;
+    srand(0);
+    for (int i = 0; i < 50000; i++) {
+        const int value = rand() % 5000;
+        switch (rand() % 3) {
+            case 0:
+                passed &= tree.insert(value) == reference.insert(value).second;
+                break;
+            case 1:
+                passed &= tree.remove(value) == (reference.erase(value) != 0);
+                break;
+            default:
+                passed &= tree.contains(value) == (reference.count(value) != 0);
+                break;
+        }
+        if (i % 1000 == 0) tree.sanityCheck();
+    }
+    tree.sanityCheck();
+    passed &= tree.size() == reference.size();
+    passed &= std::equal(tree.inorder_begin(), tree.inorder_end(), reference.begin(), reference.end());
+    return passed;
+}
+
+/**
+ * Threads churning one structure at once, for those shared between threads.
+ * Each thread inserts and removes values of its own, so every result is known, while all of them fight over a
+ * small shared range.
+ */
+template <class Tree, class... Args>
+bool check_concurrent_churn(const Args &...args) {
+    Tree tree(args...);
+    const int threads = 8, per_thread = 2000, shared = 64;
+    std::vector<std::thread> workers;
+    std::atomic<bool> failed(false);
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&tree, &failed, t]() {
+            for (int round = 0; round < 4; round++) {
+                for (int i = 0; i < per_thread; i++) {
+                    if (!tree.insert(shared + t * per_thread + i)) failed = true;
+                    tree.remove(i % shared);
+                    tree.insert((i * 7) % shared);
+                }
+                for (int i = 0; i < per_thread; i += 2) {
+                    if (!tree.remove(shared + t * per_thread + i)) failed = true;
+                }
+                for (int i = 1; i < per_thread; i += 2) {
+                    if (!tree.contains(shared + t * per_thread + i)) failed = true;
+                    if (!tree.remove(shared + t * per_thread + i)) failed = true;
+                }
+            }
+        });
+    }
+    for (std::thread &worker : workers) worker.join();
+    bool passed = !failed;
+    tree.sanityCheck();
+
+    // Only values from the shared range can be left
+    for (auto it = tree.inorder_begin(); it != tree.inorder_end(); ++it) passed &= *it < shared;
+    return passed;
+}
+
+// Threads popping the least value at once take every value exactly once, and each thread takes them in order
+template <class Tree, class... Args>
+bool check_concurrent_pops(const Args &...args) {
+    Tree tree(args...);
+    const int threads = 8, values = 16000;
+    for (int i = 0; i < values; i++) tree.insert(i);
+
+    std::vector<std::vector<int>> popped(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&tree, &popped, t]() {
+            try {
+                while (true) popped[t].push_back(tree.popMostLeft());
+            } catch (std::out_of_range &) {}
+        });
+    }
+    for (std::thread &worker : workers) worker.join();
+
+    bool passed = true;
+    std::vector<int> all;
+    for (std::vector<int> &taken : popped) {
+        passed &= std::is_sorted(taken.begin(), taken.end());
+        all.insert(all.end(), taken.begin(), taken.end());
+    }
+    std::sort(all.begin(), all.end());
+    passed &= all.size() == size_t(values);
+    passed &= std::adjacent_find(all.begin(), all.end()) == all.end();
+    passed &= tree.empty() && tree.size() == 0;
+    tree.sanityCheck();
+    return passed;
+}
+
+// Every check but check_bounded_height(), which needs the tree's own bound, for a BinaryTree or anything with its interface
+template <class Tree, class... Args>
+void test_set(const Args &...args) {
+    std::cout << "Empty Check                : "
+              << (check_empty<Tree>(args...) ? "passed" : "failed") << std::endl;
+    std::cout << "Insert Remove Check        : "
+              << (check_insert_remove<Tree>(args...) ? "passed" : "failed") << std::endl;
+    std::cout << "Ends Check                 : "
+              << (check_ends<Tree>(args...) && check_reverse<Tree>(args...) ? "passed" : "failed") << std::endl;
+    std::cout << "Churn Check                : "
+              << (check_churn<Tree>(args...) ? "passed" : "failed") << std::endl;
+}
+#endif //TREE_TEST_H